@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <sodium.h>
+
+#include "vault/password_audit.hpp"
+
+// Full-vault password reuse audit at 1k/10k/100k entries, about a tenth of
+// them sharing a password with another entry.
+
+namespace {
+
+std::vector<Entry> make_entries(int64_t count) {
+    std::vector<Entry> entries(static_cast<size_t>(count));
+    for (int64_t i = 0; i < count; i++) {
+        std::string n = std::to_string(i % 10 == 0 ? i / 10 : i);
+        entries[i].setName("Account " + std::to_string(i));
+        entries[i].setPassword("Pw!" + n + "-x7Qz");
+    }
+    return entries;
+}
+
+void BM_AuditReuse(benchmark::State &state) {
+    std::vector<Entry> entries = make_entries(state.range(0));
+    unsigned char key[AUDIT_KEY_SIZE];
+    randombytes_buf(key, sizeof(key));
+
+    for (auto _ : state) {
+        ReuseReport report;
+        audit_password_reuse(entries, key, report);
+        benchmark::DoNotOptimize(report.reused.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_AuditReuse)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+int main(int argc, char **argv) {
+    if (sodium_init() < 0) {
+        std::cerr << "Failed to initialize libsodium" << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
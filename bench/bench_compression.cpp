@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include <sodium.h>
+#include <thread>
+#include <map>
+
+#include "api/handlers.hpp"
+
+// Listing benchmark over loopback: bytes on the wire and time-to-last-byte
+// of GET /api/entries for each negotiated Content-Encoding.
+
+namespace {
+
+struct BenchVault {
+    std::string path;
+    std::unique_ptr<ApiHandlers> handlers;
+    std::unique_ptr<httplib::Server> server;
+    std::thread thread;
+    int port = 0;
+};
+
+std::map<int64_t, std::unique_ptr<BenchVault>> vaults;
+
+void call(void (ApiHandlers::*handler)(const httplib::Request &, httplib::Response &),
+          ApiHandlers &handlers, const json &body) {
+    httplib::Request req;
+    httplib::Response res;
+    req.body = body.dump();
+    (handlers.*handler)(req, res);
+}
+
+BenchVault &vault_with(int64_t count) {
+    auto &slot = vaults[count];
+    if (slot) return *slot;
+
+    slot = std::make_unique<BenchVault>();
+    BenchVault &bv = *slot;
+    bv.path = (std::filesystem::temp_directory_path() /
+               ("shpd_bench_" + std::to_string(getpid()) + "_" + std::to_string(count) + ".shpd")).string();
+    bv.handlers = std::make_unique<ApiHandlers>();
+
+    call(&ApiHandlers::handle_create_vault, *bv.handlers,
+         {{"path", bv.path}, {"password", "bench-password"}, {"name", "Bench"}});
+
+    for (int64_t i = 0; i < count; i++) {
+        std::string n = std::to_string(i);
+        call(&ApiHandlers::handle_add_entry, *bv.handlers,
+             {{"name", "Account " + n},
+              {"username", "user" + n + "@example.com"},
+              {"password", "Pw!" + n + "-x7Qz"},
+              {"url", "https://service" + std::to_string(i % 500) + ".example.com/login"},
+              {"notes", "Imported entry number " + n}});
+    }
+
+    bv.server = std::make_unique<httplib::Server>();
+    bv.server->set_tcp_nodelay(true);
+    ApiHandlers *handlers = bv.handlers.get();
+    bv.server->Get("/api/entries", [handlers](const httplib::Request &req, httplib::Response &res) {
+        handlers->handle_get_entries(req, res);
+    });
+    bv.port = bv.server->bind_to_any_port("127.0.0.1");
+    bv.thread = std::thread([&bv] { bv.server->listen_after_bind(); });
+    bv.server->wait_until_ready();
+    return bv;
+}
+
+void BM_EntriesListing(benchmark::State &state, const char *accept_encoding) {
+    BenchVault &bv = vault_with(state.range(0));
+    httplib::Client cli("127.0.0.1", bv.port);
+    cli.set_keep_alive(true);
+    cli.set_decompress(false);
+
+    httplib::Headers headers;
+    if (*accept_encoding) headers.emplace("Accept-Encoding", accept_encoding);
+
+    size_t wire_bytes = 0;
+    for (auto _ : state) {
+        auto res = cli.Get("/api/entries", headers);
+        if (!res || res->status != 200) {
+            state.SkipWithError("request failed");
+            break;
+        }
+        wire_bytes = res->body.size();
+        benchmark::DoNotOptimize(res->body.data());
+    }
+
+    state.counters["wire_bytes"] = static_cast<double>(wire_bytes);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * wire_bytes));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_EntriesListing, identity, "")
+    ->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_EntriesListing, gzip, "gzip")
+    ->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+#ifdef SHPD_ZSTD_SUPPORT
+BENCHMARK_CAPTURE(BM_EntriesListing, zstd, "zstd")
+    ->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+#endif
+
+int main(int argc, char **argv) {
+    if (sodium_init() < 0) {
+        std::cerr << "Failed to initialize libsodium" << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    for (auto &[count, bv] : vaults) {
+        bv->server->stop();
+        bv->thread.join();
+        std::filesystem::remove(bv->path);
+        std::filesystem::remove(bv->path + HISTORY_SUFFIX);
+    }
+    return 0;
+}
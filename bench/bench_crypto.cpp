@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <sodium.h>
+
+#include "crypto/encryption.hpp"
+#include "crypto/hashing.hpp"
+
+// Per-entry AEAD cost and the two Argon2id paths run on create/unlock.
+
+namespace {
+
+Entry sample_entry() {
+    Entry entry;
+    entry.setName("Example Account");
+    entry.setUsername("someone@example.com");
+    entry.setWebsite("https://login.example.com/");
+    entry.setPassword("c0rrect-h0rse-battery");
+    entry.setNotes("Recovery codes are in the safe");
+    entry.Modf_Time = 1700000000;
+    return entry;
+}
+
+void BM_EncryptEntry(benchmark::State &state) {
+    unsigned char key[crypto_aead_chacha20poly1305_ietf_KEYBYTES];
+    randombytes_buf(key, sizeof(key));
+    Entry entry = sample_entry();
+    std::vector<unsigned char> out;
+
+    for (auto _ : state) {
+        encrypt_entry(key, entry, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(Entry));
+}
+
+void BM_DecryptEntry(benchmark::State &state) {
+    unsigned char key[crypto_aead_chacha20poly1305_ietf_KEYBYTES];
+    randombytes_buf(key, sizeof(key));
+    std::vector<unsigned char> cipher;
+    encrypt_entry(key, sample_entry(), cipher);
+    Entry entry;
+
+    for (auto _ : state) {
+        decrypt_entry(key, entry, cipher.data(), cipher.size());
+        benchmark::DoNotOptimize(entry);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(Entry));
+}
+
+void BM_HashPassword(benchmark::State &state) {
+    for (auto _ : state) {
+        std::string hashed = hash_password("bench-password");
+        benchmark::DoNotOptimize(hashed);
+    }
+}
+
+void BM_DeriveKey(benchmark::State &state) {
+    unsigned char salt[SALT_SIZE];
+    unsigned char key[crypto_secretbox_KEYBYTES];
+    randombytes_buf(salt, sizeof(salt));
+
+    for (auto _ : state) {
+        bool ok = derive_key_from_password("bench-password", salt, key);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_EncryptEntry);
+BENCHMARK(BM_DecryptEntry);
+BENCHMARK(BM_HashPassword)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DeriveKey)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char **argv) {
+    if (sodium_init() < 0) {
+        std::cerr << "Failed to initialize libsodium" << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include <sodium.h>
+
+#include "api/serializers.hpp"
+
+// Table-driven Entry<->JSON conversion against the hand-written per-field
+// code it replaced; the generated path must not be slower.
+
+namespace {
+
+std::vector<Entry> make_entries(int64_t count) {
+    std::vector<Entry> entries(count);
+    for (int64_t i = 0; i < count; i++) {
+        std::string n = std::to_string(i);
+        entries[i].setName("Account " + n);
+        entries[i].setUsername("user" + n + "@example.com");
+        entries[i].setWebsite("https://service" + std::to_string(i % 500) + ".example.com/login");
+        entries[i].setPassword("Pw!" + n + "-x7Qz");
+        entries[i].setNotes("Imported entry number " + n);
+        entries[i].Modf_Time = 1700000000 + i;
+    }
+    return entries;
+}
+
+json hand_rolled_to_json(const Entry &entry) {
+    json e;
+    e["name"] = entry.Name;
+    e["username"] = entry.Username;
+    e["password"] = entry.Password;
+    e["url"] = entry.Website;
+    e["notes"] = entry.Notes;
+    e["modf_time"] = entry.Modf_Time;
+    return e;
+}
+
+Entry hand_rolled_from_json(const json &j) {
+    Entry e;
+    e.setName(j.value("name", ""));
+    e.setUsername(j.value("username", ""));
+    e.setWebsite(j.value("url", ""));
+    e.setPassword(j.value("password", ""));
+    e.setNotes(j.value("notes", ""));
+    e.Modf_Time = j.value("modf_time", time(nullptr));
+    return e;
+}
+
+void BM_ToJson_HandRolled(benchmark::State &state) {
+    auto entries = make_entries(state.range(0));
+    for (auto _ : state) {
+        json listing = json::array();
+        for (const auto &entry : entries) listing.push_back(hand_rolled_to_json(entry));
+        benchmark::DoNotOptimize(listing);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ToJson_FieldTable(benchmark::State &state) {
+    auto entries = make_entries(state.range(0));
+    for (auto _ : state) {
+        json listing = json::array();
+        for (const auto &entry : entries) listing.push_back(entry_to_json(entry));
+        benchmark::DoNotOptimize(listing);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_FromJson_HandRolled(benchmark::State &state) {
+    json doc = hand_rolled_to_json(make_entries(1)[0]);
+    for (auto _ : state) {
+        Entry e = hand_rolled_from_json(doc);
+        benchmark::DoNotOptimize(e);
+    }
+}
+
+void BM_FromJson_FieldTable(benchmark::State &state) {
+    json doc = entry_to_json(make_entries(1)[0]);
+    for (auto _ : state) {
+        Entry e = json_to_entry(doc);
+        benchmark::DoNotOptimize(e);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_ToJson_HandRolled)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ToJson_FieldTable)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FromJson_HandRolled);
+BENCHMARK(BM_FromJson_FieldTable);
+
+BENCHMARK_MAIN();
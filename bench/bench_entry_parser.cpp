@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include "api/entry_parser.hpp"
+
+// Per-request CPU time of decoding add/edit/delete bodies: the former DOM
+// path (json::parse + value() + setters) against the SAX fast path.
+
+namespace {
+
+const char *ADD_BODY =
+    R"({"name":"GitHub","username":"octocat@example.com","password":"c0rrect-h0rse-battery",)"
+    R"("url":"https://github.com/login","notes":"Work account, 2FA via authenticator app"})";
+const char *EDIT_BODY =
+    R"({"index":4711,"name":"GitHub","username":"octocat@example.com","password":"c0rrect-h0rse-battery",)"
+    R"("url":"https://github.com/login","notes":"Work account, 2FA via authenticator app"})";
+const char *DELETE_BODY = R"({"index":4711})";
+
+void BM_DomParse(benchmark::State &state, const char *body) {
+    httplib::Request req;
+    req.body = body;
+    for (auto _ : state) {
+        json request_data = json::parse(req.body);
+        EntryRequest out;
+        out.index = request_data.value("index", SIZE_MAX);
+        out.entry.setName(request_data.value("name", ""));
+        out.entry.setUsername(request_data.value("username", ""));
+        out.entry.setPassword(request_data.value("password", ""));
+        out.entry.setWebsite(request_data.value("url", ""));
+        out.entry.setNotes(request_data.value("notes", ""));
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+void BM_SaxParse(benchmark::State &state, const char *body) {
+    httplib::Request req;
+    req.body = body;
+    for (auto _ : state) {
+        EntryRequest out;
+        parse_entry_request(req, out);
+        benchmark::DoNotOptimize(out);
+    }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_DomParse, add, ADD_BODY);
+BENCHMARK_CAPTURE(BM_SaxParse, add, ADD_BODY);
+BENCHMARK_CAPTURE(BM_DomParse, edit, EDIT_BODY);
+BENCHMARK_CAPTURE(BM_SaxParse, edit, EDIT_BODY);
+BENCHMARK_CAPTURE(BM_DomParse, delete, DELETE_BODY);
+BENCHMARK_CAPTURE(BM_SaxParse, delete, DELETE_BODY);
+
+BENCHMARK_MAIN();
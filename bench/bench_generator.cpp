@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <sodium.h>
+
+#include "crypto/password_generator.hpp"
+
+// Password and passphrase generation, one at a time and in bulk, against
+// drawing each character with its own randombytes_uniform() call.
+
+namespace {
+
+void BM_GeneratePassword(benchmark::State &state) {
+    RandomSampler random;
+    Alphabet alphabet(CHARS_DEFAULT);
+    auto length = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::string password = generate_password(alphabet, length, random);
+        benchmark::DoNotOptimize(password.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Baseline: one randombytes_uniform() call per character
+void BM_GeneratePasswordPerCall(benchmark::State &state) {
+    Alphabet alphabet(CHARS_DEFAULT);
+    auto length = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::string password;
+        for (size_t i = 0; i < length; i++) {
+            password += alphabet.symbols[randombytes_uniform(static_cast<uint32_t>(alphabet.symbols.size()))];
+        }
+        benchmark::DoNotOptimize(password.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GeneratePassphrase(benchmark::State &state) {
+    RandomSampler random;
+    auto words = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        std::string phrase = generate_passphrase(words, "-", false, random);
+        benchmark::DoNotOptimize(phrase.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// A full bulk request's worth, as the endpoint builds it
+void BM_GenerateBulk(benchmark::State &state) {
+    auto count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        RandomSampler random;
+        Alphabet alphabet(CHARS_DEFAULT);
+        std::vector<std::string> passwords;
+        passwords.reserve(count);
+        for (size_t i = 0; i < count; i++) passwords.push_back(generate_password(alphabet, GENERATE_DEFAULT_LENGTH, random));
+        benchmark::DoNotOptimize(passwords.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_GeneratePassword)->Arg(20)->Arg(63);
+BENCHMARK(BM_GeneratePasswordPerCall)->Arg(20)->Arg(63);
+BENCHMARK(BM_GeneratePassphrase)->Arg(6);
+BENCHMARK(BM_GenerateBulk)->Arg(GENERATE_MAX_COUNT)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char **argv) {
+    if (sodium_init() < 0) {
+        std::cerr << "Failed to initialize libsodium" << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
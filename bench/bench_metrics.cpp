@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include "metrics/trace.hpp"
+
+// Recording cost of metrics and trace spans on the hot path; must stay in
+// the tens of nanoseconds on top of the clock reads.
+
+namespace {
+
+void BM_RecordTimer(benchmark::State &state) {
+    std::chrono::nanoseconds elapsed{1500};
+    for (auto _ : state) {
+        metrics().record(Timer::EntryDecrypt, elapsed);
+        elapsed += std::chrono::nanoseconds{7};
+    }
+}
+
+void BM_ScopedTimer(benchmark::State &state) {
+    for (auto _ : state) {
+        ScopedTimer timer(Timer::VaultFlush);
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_TraceSpan(benchmark::State &state) {
+    for (auto _ : state) {
+        TraceSpan span("bench.span");
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_TraceSpanTimed(benchmark::State &state) {
+    for (auto _ : state) {
+        TraceSpan span("bench.span", Timer::VaultFlush);
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_RecordRequest(benchmark::State &state) {
+    const std::string route = "/api/entries/edit";
+    for (auto _ : state) {
+        metrics().record_request(metric_route_index(route), 200, std::chrono::microseconds{250});
+    }
+}
+
+void BM_AddCounter(benchmark::State &state) {
+    for (auto _ : state) {
+        metrics().add(Counter::VaultWriteBytes, 356);
+    }
+}
+
+void BM_Render(benchmark::State &state) {
+    for (auto _ : state) {
+        std::string text = metrics().render();
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_RecordTimer)->ThreadRange(1, 8);
+BENCHMARK(BM_ScopedTimer)->ThreadRange(1, 8);
+BENCHMARK(BM_TraceSpan)->ThreadRange(1, 8);
+BENCHMARK(BM_TraceSpanTimed)->ThreadRange(1, 8);
+BENCHMARK(BM_RecordRequest)->ThreadRange(1, 8);
+BENCHMARK(BM_AddCounter)->ThreadRange(1, 8);
+BENCHMARK(BM_Render)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+#include <sodium.h>
+#include <map>
+
+#include "vault/vault.hpp"
+#include "api/serializers.hpp"
+#include "api/wire_format.hpp"
+
+// Vault file I/O and the full-listing response, at 1k/10k/100k entries.
+// Each size gets one vault file, built once and reused by every case.
+
+namespace {
+
+std::map<int64_t, std::unique_ptr<Vault>> vaults;
+std::vector<std::string> vault_paths;
+
+Entry make_entry(int64_t i) {
+    std::string n = std::to_string(i);
+    Entry entry;
+    entry.setName("Account " + n);
+    entry.setUsername("user" + n + "@example.com");
+    entry.setWebsite("https://service" + std::to_string(i % 500) + ".example.com/login");
+    entry.setPassword("Pw!" + n + "-x7Qz");
+    entry.setNotes("Imported entry number " + n);
+    entry.Modf_Time = 1700000000 + i;
+    return entry;
+}
+
+Vault &vault_with(int64_t count) {
+    auto &slot = vaults[count];
+    if (slot) return *slot;
+
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("shpd_bench_vault_" + std::to_string(getpid()) + "_" + std::to_string(count) + ".shpd"))
+                           .string();
+    vault_paths.push_back(path);
+
+    slot = std::make_unique<Vault>();
+    slot->create(path, "bench-password", "Bench");
+    for (int64_t i = 0; i < count; i++) {
+        slot->add_entry(make_entry(i));
+    }
+    return *slot;
+}
+
+void BM_LoadEntries(benchmark::State &state) {
+    Vault &vault = vault_with(state.range(0));
+    for (auto _ : state) {
+        json result = vault.load_entries();
+        if (!result["success"].get<bool>()) {
+            state.SkipWithError("load_entries failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_AddEntry(benchmark::State &state) {
+    Vault &vault = vault_with(state.range(0));
+    Entry entry = make_entry(state.range(0));
+    for (auto _ : state) {
+        vault.add_entry(entry);
+
+        state.PauseTiming();
+        vault.delete_entry(vault.get_entries().size() - 1);
+        state.ResumeTiming();
+    }
+}
+
+// Position is a percentage of the vault: deleting near the front shifts
+// every later record down one slot
+void BM_DeleteEntry(benchmark::State &state) {
+    Vault &vault = vault_with(state.range(0));
+    size_t index = static_cast<size_t>(state.range(0) * state.range(1) / 100);
+    if (index >= static_cast<size_t>(state.range(0))) index = state.range(0) - 1;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Entry removed = vault.get_entries()[index];
+        state.ResumeTiming();
+
+        vault.delete_entry(index);
+
+        // Put the entry back at the end so the vault keeps its size
+        state.PauseTiming();
+        vault.add_entry(removed);
+        state.ResumeTiming();
+    }
+}
+
+// Same document and serializer path as GET /api/entries without ?since=
+void BM_ListingSerialize(benchmark::State &state) {
+    Vault &vault = vault_with(state.range(0));
+    httplib::Request req;
+
+    for (auto _ : state) {
+        json response;
+        json entries_json = json::array();
+        for (const auto &entry : vault.get_entries()) {
+            entries_json.push_back(entry_to_json(entry));
+        }
+        response["success"] = true;
+        response["full"] = true;
+        response["revision"] = vault.get_revision();
+        response["entries"] = std::move(entries_json);
+
+        httplib::Response res;
+        send_response(req, res, response);
+        benchmark::DoNotOptimize(res.body.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_LoadEntries)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AddEntry)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DeleteEntry)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 50, 100}})
+    ->ArgNames({"entries", "position_pct"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ListingSerialize)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char **argv) {
+    if (sodium_init() < 0) {
+        std::cerr << "Failed to initialize libsodium" << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    vaults.clear();
+    for (const auto &path : vault_paths) {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + HISTORY_SUFFIX);
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "api/wire_format.hpp"
+
+// Serialize/parse cost and payload size of an entry listing in each wire
+// format, without compression.
+
+namespace {
+
+json make_listing(int64_t count) {
+    json entries = json::array();
+    for (int64_t i = 0; i < count; i++) {
+        std::string n = std::to_string(i);
+        entries.push_back({{"name", "Account " + n},
+                           {"username", "user" + n + "@example.com"},
+                           {"password", "Pw!" + n + "-x7Qz"},
+                           {"url", "https://service" + std::to_string(i % 500) + ".example.com/login"},
+                           {"notes", "Imported entry number " + n}});
+    }
+    return json{{"success", true}, {"full", true}, {"revision", count}, {"entries", entries}};
+}
+
+std::string encode(const json &doc, WireFormat format) {
+    std::string out;
+    switch (format) {
+    case WireFormat::Json: out = doc.dump(); break;
+    case WireFormat::Cbor: json::to_cbor(doc, out); break;
+    case WireFormat::MsgPack: json::to_msgpack(doc, out); break;
+    }
+    return out;
+}
+
+json decode(const std::string &payload, WireFormat format) {
+    switch (format) {
+    case WireFormat::Cbor: return json::from_cbor(payload);
+    case WireFormat::MsgPack: return json::from_msgpack(payload);
+    case WireFormat::Json: break;
+    }
+    return json::parse(payload);
+}
+
+void BM_Serialize(benchmark::State &state, WireFormat format) {
+    json doc = make_listing(state.range(0));
+    size_t payload = 0;
+    for (auto _ : state) {
+        std::string out = encode(doc, format);
+        payload = out.size();
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["payload_bytes"] = static_cast<double>(payload);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload));
+}
+
+void BM_Parse(benchmark::State &state, WireFormat format) {
+    std::string payload = encode(make_listing(state.range(0)), format);
+    for (auto _ : state) {
+        json doc = decode(payload, format);
+        benchmark::DoNotOptimize(doc);
+    }
+    state.counters["payload_bytes"] = static_cast<double>(payload.size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_Serialize, json, WireFormat::Json)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Serialize, cbor, WireFormat::Cbor)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Serialize, msgpack, WireFormat::MsgPack)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Parse, json, WireFormat::Json)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Parse, cbor, WireFormat::Cbor)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Parse, msgpack, WireFormat::MsgPack)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
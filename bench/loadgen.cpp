@@ -0,0 +1,298 @@
+#include "lib/httplib.h"
+#include "lib/json.hpp"
+#include "vault/history.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+// Closed-loop load generator for a password_manager server on this host.
+// Every worker keeps one keep-alive connection and issues the next request
+// as soon as the previous one completes; latencies are kept per worker and
+// merged once the run is over.
+//
+// Operations:
+//   get    - GET /api/entries (full listing)
+//   search - GET /api/entries?since=<revision> (incremental refresh a client
+//            does before filtering; the server has no search endpoint)
+//   add    - POST /api/entries/add
+//   edit   - POST /api/entries/edit on a random index
+//   delete - POST /api/entries/delete on a random index
+
+namespace {
+
+// Only ever connect to loopback: this tool writes to whatever vault it opens
+constexpr const char *LOADGEN_HOST = "127.0.0.1";
+
+enum Op { OpGet, OpSearch, OpAdd, OpEdit, OpDelete, OP_COUNT };
+constexpr const char *OP_NAMES[OP_COUNT] = {"get", "search", "add", "edit", "delete"};
+
+struct Options {
+    int port = 8080;
+    unsigned threads = 8;
+    double duration = 10.0;
+    size_t entries = 1000;
+    unsigned mix[OP_COUNT] = {60, 20, 10, 7, 3};
+    std::string vault;
+    std::string json_out;
+};
+
+struct WorkerStats {
+    std::vector<uint32_t> latency_us[OP_COUNT];
+    size_t rejected[OP_COUNT] = {};
+    size_t failed[OP_COUNT] = {};
+};
+
+void usage() {
+    std::cerr << "Usage: loadgen [options]\n"
+              << "  --port N          server port on 127.0.0.1 (default 8080)\n"
+              << "  --threads N       concurrent clients (default 8)\n"
+              << "  --duration S      seconds to run (default 10)\n"
+              << "  --entries N       entries to seed the vault with (default 1000)\n"
+              << "  --mix SPEC        weights, e.g. get=60,search=20,add=10,edit=7,delete=3\n"
+              << "  --vault PATH      vault file to create (default: temp file, removed after)\n"
+              << "  --json FILE       also write results as JSON\n";
+}
+
+bool parse_mix(const std::string &spec, unsigned (&mix)[OP_COUNT]) {
+    std::fill(std::begin(mix), std::end(mix), 0u);
+    std::istringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) return false;
+        std::string name = item.substr(0, eq);
+        auto it = std::find_if(std::begin(OP_NAMES), std::end(OP_NAMES),
+                               [&](const char *op) { return name == op; });
+        if (it == std::end(OP_NAMES)) return false;
+        mix[it - std::begin(OP_NAMES)] = static_cast<unsigned>(std::stoul(item.substr(eq + 1)));
+    }
+    return std::any_of(std::begin(mix), std::end(mix), [](unsigned w) { return w > 0; });
+}
+
+bool parse_args(int argc, char **argv, Options &opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+
+        if (arg == "--port") opts.port = std::stoi(value);
+        else if (arg == "--threads") opts.threads = static_cast<unsigned>(std::stoul(value));
+        else if (arg == "--duration") opts.duration = std::stod(value);
+        else if (arg == "--entries") opts.entries = std::stoul(value);
+        else if (arg == "--mix") {
+            if (!parse_mix(value, opts.mix)) return false;
+        }
+        else if (arg == "--vault") opts.vault = value;
+        else if (arg == "--json") opts.json_out = value;
+        else return false;
+    }
+    return opts.threads > 0 && opts.duration > 0;
+}
+
+json make_entry(uint64_t n) {
+    std::string id = std::to_string(n);
+    return {{"name", "Load " + id},
+            {"username", "user" + id + "@example.com"},
+            {"url", "https://service" + std::to_string(n % 500) + ".example.com/"},
+            {"password", "Pw!" + id + "-x7Qz"},
+            {"notes", "Generated by loadgen"}};
+}
+
+bool post_ok(httplib::Client &cli, const std::string &path, const json &body) {
+    auto res = cli.Post(path, body.dump(), "application/json");
+    if (!res || res->status != 200) return false;
+    return json::parse(res->body, nullptr, false).value("success", false);
+}
+
+double percentile(const std::vector<uint32_t> &sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void run_worker(const Options &opts, unsigned seed, Clock::time_point deadline,
+                std::atomic<size_t> &entry_count, std::atomic<uint64_t> &serial, WorkerStats &stats) {
+    httplib::Client cli(LOADGEN_HOST, opts.port);
+    cli.set_keep_alive(true);
+    cli.set_tcp_nodelay(true);
+
+    std::mt19937 rng(seed);
+    std::discrete_distribution<int> pick(std::begin(opts.mix), std::end(opts.mix));
+    uint64_t revision = 0;
+
+    while (Clock::now() < deadline) {
+        int op = pick(rng);
+        size_t count = entry_count.load(std::memory_order_relaxed);
+        size_t index = count ? std::uniform_int_distribution<size_t>(0, count - 1)(rng) : 0;
+
+        // Responses are read in full; the status and "success" flag decide
+        // whether a request counts as served, rejected or failed
+        bool served = true;
+        bool accepted = true;
+        auto start = Clock::now();
+
+        if (op == OpGet || op == OpSearch) {
+            std::string path = op == OpGet ? "/api/entries" : "/api/entries?since=" + std::to_string(revision);
+            auto res = cli.Get(path);
+            served = res && res->status == 200;
+            if (served) {
+                json body = json::parse(res->body, nullptr, false);
+                accepted = body.value("success", false);
+                revision = body.value("revision", revision);
+            }
+        } else {
+            json body;
+            const char *path = "/api/entries/add";
+            if (op == OpAdd) {
+                body = make_entry(serial++);
+            } else if (op == OpEdit) {
+                body = make_entry(serial++);
+                body["index"] = index;
+                path = "/api/entries/edit";
+            } else {
+                body = {{"index", index}};
+                path = "/api/entries/delete";
+            }
+
+            auto res = cli.Post(path, body.dump(), "application/json");
+            served = res && res->status == 200;
+            if (served) {
+                json reply = json::parse(res->body, nullptr, false);
+                accepted = reply.value("success", false);
+                if (accepted && reply.contains("entries")) {
+                    entry_count.store(reply["entries"].get<size_t>(), std::memory_order_relaxed);
+                }
+            }
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+        if (!served) {
+            stats.failed[op]++;
+        } else if (!accepted) {
+            // Typically an edit/delete racing another worker's delete
+            stats.rejected[op]++;
+        } else {
+            stats.latency_us[op].push_back(static_cast<uint32_t>(elapsed.count()));
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opts;
+    if (!parse_args(argc, argv, opts)) {
+        usage();
+        return 1;
+    }
+
+    bool temp_vault = opts.vault.empty();
+    if (temp_vault) {
+        opts.vault = (std::filesystem::temp_directory_path() /
+                      ("shpd_loadgen_" + std::to_string(getpid()) + ".shpd")).string();
+    }
+
+    httplib::Client setup(LOADGEN_HOST, opts.port);
+    setup.set_keep_alive(true);
+    if (!post_ok(setup, "/api/vault/create",
+                 {{"path", opts.vault}, {"password", "loadgen-password"}, {"name", "Loadgen"}})) {
+        std::cerr << "Could not create vault " << opts.vault << " on " << LOADGEN_HOST << ":" << opts.port
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "Seeding " << opts.entries << " entries..." << std::endl;
+    for (size_t i = 0; i < opts.entries; i++) {
+        if (!post_ok(setup, "/api/entries/add", make_entry(i))) {
+            std::cerr << "Seeding failed at entry " << i << std::endl;
+            return 1;
+        }
+    }
+
+    std::atomic<size_t> entry_count{opts.entries};
+    std::atomic<uint64_t> serial{opts.entries};
+    std::vector<WorkerStats> stats(opts.threads);
+    std::vector<std::thread> workers;
+
+    std::cout << "Running " << opts.threads << " clients for " << opts.duration << "s against " << LOADGEN_HOST
+              << ":" << opts.port << std::endl;
+
+    auto started = Clock::now();
+    auto deadline = started + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(opts.duration));
+    for (unsigned t = 0; t < opts.threads; t++) {
+        workers.emplace_back(run_worker, std::cref(opts), 0x5eed + t, deadline, std::ref(entry_count),
+                             std::ref(serial), std::ref(stats[t]));
+    }
+    for (auto &w : workers) w.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+
+    post_ok(setup, "/api/vault/close", json::object());
+    if (temp_vault) {
+        std::filesystem::remove(opts.vault);
+        std::filesystem::remove(opts.vault + HISTORY_SUFFIX);
+    }
+
+    // Merge per-worker samples
+    json report = {{"threads", opts.threads}, {"seconds", seconds}, {"ops", json::object()}};
+    std::vector<uint32_t> all;
+    size_t total_rejected = 0;
+    size_t total_failed = 0;
+
+    std::printf("\n%-8s %10s %10s %8s %10s %10s %10s %10s\n", "op", "requests", "req/s", "rejected", "p50 us",
+                "p99 us", "p999 us", "max us");
+    for (int op = 0; op < OP_COUNT; op++) {
+        std::vector<uint32_t> samples;
+        size_t rejected = 0;
+        size_t failed = 0;
+        for (auto &s : stats) {
+            samples.insert(samples.end(), s.latency_us[op].begin(), s.latency_us[op].end());
+            rejected += s.rejected[op];
+            failed += s.failed[op];
+        }
+        if (samples.empty() && rejected == 0 && failed == 0) continue;
+
+        std::sort(samples.begin(), samples.end());
+        all.insert(all.end(), samples.begin(), samples.end());
+        total_rejected += rejected;
+        total_failed += failed;
+
+        double rate = samples.size() / seconds;
+        std::printf("%-8s %10zu %10.0f %8zu %10.0f %10.0f %10.0f %10u\n", OP_NAMES[op], samples.size(), rate, rejected,
+                    percentile(samples, 0.50), percentile(samples, 0.99), percentile(samples, 0.999),
+                    samples.empty() ? 0u : samples.back());
+
+        report["ops"][OP_NAMES[op]] = {{"requests", samples.size()}, {"rejected", rejected},
+                                       {"failed", failed},           {"rps", rate},
+                                       {"p50_us", percentile(samples, 0.50)},
+                                       {"p99_us", percentile(samples, 0.99)},
+                                       {"p999_us", percentile(samples, 0.999)}};
+    }
+
+    std::sort(all.begin(), all.end());
+    double total_rate = all.size() / seconds;
+    std::printf("%-8s %10zu %10.0f %8zu %10.0f %10.0f %10.0f %10u\n", "total", all.size(), total_rate, total_rejected,
+                percentile(all, 0.50), percentile(all, 0.99), percentile(all, 0.999), all.empty() ? 0u : all.back());
+    if (total_failed) {
+        std::printf("\n%zu requests failed at the transport/HTTP level\n", total_failed);
+    }
+
+    report["total"] = {{"requests", all.size()}, {"rejected", total_rejected}, {"failed", total_failed},
+                       {"rps", total_rate},      {"p50_us", percentile(all, 0.50)},
+                       {"p99_us", percentile(all, 0.99)}, {"p999_us", percentile(all, 0.999)}};
+
+    if (!opts.json_out.empty()) {
+        std::ofstream out(opts.json_out);
+        out << report.dump(2) << std::endl;
+    }
+    return total_failed ? 2 : 0;
+}
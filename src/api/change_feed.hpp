@@ -0,0 +1,129 @@
+#ifndef API_CHANGE_FEED_HPP
+#define API_CHANGE_FEED_HPP
+
+#include "../core/types.hpp"
+#include "../core/entry_id.hpp"
+#include "../vault/changes.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+/**
+ * @brief Compact change notification; clients fetch contents via ?since=
+ */
+struct ChangeEvent {
+    uint64_t revision;
+    ChangeType type;
+    size_t index;
+    EntryId id; // nil for resets
+};
+
+/**
+ * @brief Fan-out of vault change events to any number of subscribers
+ *
+ * Events live in one shared bounded ring. A subscriber is just a revision
+ * cursor, so adding subscribers costs no per-subscriber queue; a broadcast
+ * is one notify_all.
+ */
+class ChangeFeed {
+private:
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<ChangeEvent> events;
+    uint64_t latest = 0;
+    size_t subscribers = 0;
+    size_t streams = 0;
+    bool closed = false;
+
+public:
+    ~ChangeFeed() { close(); }
+
+    void publish(const ChangeEvent &event) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(event);
+            if (events.size() > CHANGE_LOG_CAPACITY) {
+                events.pop_front();
+            }
+            latest = event.revision;
+        }
+        cv.notify_all();
+    }
+
+    uint64_t current_revision() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return latest;
+    }
+
+    size_t subscriber_count() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return subscribers;
+    }
+
+    /**
+     * @brief Claim one of at most `limit` stream slots
+     * @return false if all are taken or the feed is closed; release with close_stream()
+     */
+    bool open_stream(size_t limit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed || streams >= limit) return false;
+        streams++;
+        return true;
+    }
+
+    void close_stream() {
+        std::lock_guard<std::mutex> lock(mutex);
+        streams--;
+    }
+
+    size_t stream_count() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return streams;
+    }
+
+    /**
+     * @brief Wait for events newer than a cursor
+     * @param cursor Last revision the subscriber has seen
+     * @param timeout Maximum time to block
+     * @param out Newer events in order; a single Reset event if the ring no
+     *            longer reaches back to the cursor, or the cursor is ahead of
+     *            the feed (revisions start again when the server restarts);
+     *            empty on timeout
+     * @return false once the feed has been closed
+     */
+    bool wait(uint64_t cursor, std::chrono::milliseconds timeout, std::vector<ChangeEvent> &out) {
+        out.clear();
+        std::unique_lock<std::mutex> lock(mutex);
+        subscribers++;
+        cv.wait_for(lock, timeout, [&] { return closed || latest != cursor; });
+        subscribers--;
+
+        if (closed) {
+            return false;
+        }
+        if (latest == cursor) {
+            return true;
+        }
+
+        if (cursor > latest || events.empty() || events.front().revision > cursor + 1) {
+            out.push_back({latest, ChangeType::Reset, 0, {}});
+            return true;
+        }
+        for (const auto &event : events) {
+            if (event.revision > cursor) {
+                out.push_back(event);
+            }
+        }
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        cv.notify_all();
+    }
+};
+
+#endif // API_CHANGE_FEED_HPP
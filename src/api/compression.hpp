@@ -0,0 +1,260 @@
+#ifndef API_COMPRESSION_HPP
+#define API_COMPRESSION_HPP
+
+#include "../core/types.hpp"
+#include "../lib/httplib.h"
+#include "../lib/json.hpp"
+#include <zlib.h>
+#ifdef SHPD_ZSTD_SUPPORT
+#include <zstd.h>
+#endif
+
+using json = nlohmann::json;
+
+// Responses below this size are sent as-is; compressing a status reply costs
+// more CPU than it saves on the wire.
+constexpr size_t COMPRESSION_THRESHOLD = 1024;
+constexpr size_t COMPRESSION_CHUNK_SIZE = 16384;
+constexpr int GZIP_LEVEL = 6;
+constexpr int ZSTD_LEVEL = 3;
+
+enum class ContentEncoding { Identity, Gzip, Zstd };
+
+/**
+ * @brief Pick the best supported encoding from an Accept-Encoding header
+ * @param accept_encoding Raw header value, e.g. "gzip;q=0.8, zstd"
+ * @return Encoding with the highest q-value; zstd wins ties over gzip
+ */
+inline ContentEncoding negotiate_encoding(const std::string &accept_encoding) {
+    double gzip_q = 0.0;
+    double zstd_q = 0.0;
+    double wildcard_q = -1.0;
+    bool gzip_listed = false;
+    bool zstd_listed = false;
+
+    std::istringstream tokens(accept_encoding);
+    std::string token;
+    while (std::getline(tokens, token, ',')) {
+        std::string coding = token.substr(0, token.find(';'));
+        coding.erase(0, coding.find_first_not_of(" \t"));
+        coding.erase(coding.find_last_not_of(" \t") + 1);
+        std::transform(coding.begin(), coding.end(), coding.begin(), ::tolower);
+
+        double q = 1.0;
+        size_t q_pos = token.find("q=");
+        if (q_pos != std::string::npos) {
+            q = std::strtod(token.c_str() + q_pos + 2, nullptr);
+        }
+
+        if (coding == "gzip" || coding == "x-gzip") {
+            gzip_q = q;
+            gzip_listed = true;
+        } else if (coding == "zstd") {
+            zstd_q = q;
+            zstd_listed = true;
+        } else if (coding == "*") {
+            wildcard_q = q;
+        }
+    }
+
+    if (wildcard_q >= 0.0) {
+        if (!gzip_listed) gzip_q = wildcard_q;
+        if (!zstd_listed) zstd_q = wildcard_q;
+    }
+
+#ifndef SHPD_ZSTD_SUPPORT
+    zstd_q = 0.0;
+#endif
+
+    if (zstd_q > 0.0 && zstd_q >= gzip_q) return ContentEncoding::Zstd;
+    if (gzip_q > 0.0) return ContentEncoding::Gzip;
+    return ContentEncoding::Identity;
+}
+
+/**
+ * @brief Incremental compressor appending its output to a string
+ */
+class StreamCompressor {
+public:
+    virtual ~StreamCompressor() = default;
+    virtual void write(const char *data, size_t len) = 0;
+    virtual void finish() = 0;
+};
+
+class GzipCompressor : public StreamCompressor {
+private:
+    z_stream strm{};
+    std::string &out;
+
+    void pump(int flush) {
+        unsigned char buffer[COMPRESSION_CHUNK_SIZE];
+        int ret;
+        do {
+            strm.next_out = buffer;
+            strm.avail_out = sizeof(buffer);
+            ret = deflate(&strm, flush);
+            if (ret == Z_STREAM_ERROR) {
+                throw std::runtime_error("gzip compression failed");
+            }
+            out.append(reinterpret_cast<char *>(buffer), sizeof(buffer) - strm.avail_out);
+        } while (strm.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+    }
+
+public:
+    explicit GzipCompressor(std::string &output) : out(output) {
+        // windowBits + 16 selects the gzip wrapper instead of raw zlib
+        if (deflateInit2(&strm, GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("gzip init failed");
+        }
+    }
+
+    ~GzipCompressor() override { deflateEnd(&strm); }
+
+    void write(const char *data, size_t len) override {
+        strm.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        strm.avail_in = static_cast<uInt>(len);
+        pump(Z_NO_FLUSH);
+    }
+
+    void finish() override {
+        strm.next_in = nullptr;
+        strm.avail_in = 0;
+        pump(Z_FINISH);
+    }
+};
+
+#ifdef SHPD_ZSTD_SUPPORT
+class ZstdCompressor : public StreamCompressor {
+private:
+    ZSTD_CCtx *cctx;
+    std::string &out;
+
+    void pump(const char *data, size_t len, ZSTD_EndDirective mode) {
+        char buffer[COMPRESSION_CHUNK_SIZE];
+        ZSTD_inBuffer input{data, len, 0};
+        size_t remaining;
+        do {
+            ZSTD_outBuffer output{buffer, sizeof(buffer), 0};
+            remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+            if (ZSTD_isError(remaining)) {
+                throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(remaining));
+            }
+            out.append(buffer, output.pos);
+        } while (mode == ZSTD_e_end ? remaining != 0 : input.pos < input.size);
+    }
+
+public:
+    explicit ZstdCompressor(std::string &output) : cctx(ZSTD_createCCtx()), out(output) {
+        if (!cctx) {
+            throw std::runtime_error("zstd init failed");
+        }
+        ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, ZSTD_LEVEL);
+    }
+
+    ~ZstdCompressor() override { ZSTD_freeCCtx(cctx); }
+
+    void write(const char *data, size_t len) override { pump(data, len, ZSTD_e_continue); }
+
+    void finish() override { pump(nullptr, 0, ZSTD_e_end); }
+};
+#endif
+
+/**
+ * @brief Serializer sink that compresses while the document is written
+ *
+ * Output is buffered until COMPRESSION_THRESHOLD bytes; past that point the
+ * buffer is drained through the compressor in COMPRESSION_CHUNK_SIZE pieces,
+ * so a large listing never exists uncompressed in full. Works for the JSON
+ * serializer as well as nlohmann's binary (CBOR/MessagePack) writers.
+ */
+class CompressingWriter : public nlohmann::detail::output_adapter_protocol<char> {
+private:
+    ContentEncoding requested;
+    std::string pending;
+    std::string compressed;
+    std::unique_ptr<StreamCompressor> compressor;
+
+    void start_compressor() {
+        if (requested == ContentEncoding::Gzip) {
+            compressor = std::make_unique<GzipCompressor>(compressed);
+        }
+#ifdef SHPD_ZSTD_SUPPORT
+        else if (requested == ContentEncoding::Zstd) {
+            compressor = std::make_unique<ZstdCompressor>(compressed);
+        }
+#endif
+    }
+
+    void drain_if_full() {
+        if (!compressor) {
+            if (requested == ContentEncoding::Identity || pending.size() < COMPRESSION_THRESHOLD) return;
+            start_compressor();
+            if (!compressor) {
+                requested = ContentEncoding::Identity;
+                return;
+            }
+        }
+        if (pending.size() >= COMPRESSION_CHUNK_SIZE) {
+            compressor->write(pending.data(), pending.size());
+            pending.clear();
+        }
+    }
+
+public:
+    explicit CompressingWriter(ContentEncoding encoding) : requested(encoding) {
+        pending.reserve(COMPRESSION_CHUNK_SIZE);
+    }
+
+    void write_character(char c) override {
+        pending.push_back(c);
+        drain_if_full();
+    }
+
+    void write_characters(const char *s, std::size_t length) override {
+        pending.append(s, length);
+        drain_if_full();
+    }
+
+    // Flush the tail of the document; returns the encoding actually applied
+    ContentEncoding finish() {
+        if (!compressor) return ContentEncoding::Identity;
+        compressor->write(pending.data(), pending.size());
+        compressor->finish();
+        pending.clear();
+        return requested;
+    }
+
+    std::string &body() { return compressor ? compressed : pending; }
+};
+
+/**
+ * @brief Move a finished writer's body into the response with its headers
+ *
+ * httplib's own compression must stay disabled (no CPPHTTPLIB_ZLIB_SUPPORT),
+ * otherwise the already-encoded body would be compressed a second time.
+ */
+inline void set_compressed_content(httplib::Response &res, CompressingWriter &writer, const std::string &content_type) {
+    ContentEncoding applied = writer.finish();
+    if (applied == ContentEncoding::Gzip) {
+        res.set_header("Content-Encoding", "gzip");
+    } else if (applied == ContentEncoding::Zstd) {
+        res.set_header("Content-Encoding", "zstd");
+    }
+    if (!res.has_header("Vary")) res.set_header("Vary", "Accept, Accept-Encoding");
+    res.set_content(std::move(writer.body()), content_type);
+}
+
+/**
+ * @brief Serialize a JSON response, compressing it if the client allows
+ */
+inline void send_json(const httplib::Request &req, httplib::Response &res, const json &response) {
+    auto writer = std::make_shared<CompressingWriter>(
+        negotiate_encoding(req.get_header_value("Accept-Encoding")));
+
+    nlohmann::detail::serializer<json> serializer(writer, ' ');
+    serializer.dump(response, false, false, 0);
+
+    set_compressed_content(res, *writer, "application/json");
+}
+
+#endif // API_COMPRESSION_HPP
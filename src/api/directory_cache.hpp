@@ -0,0 +1,159 @@
+#ifndef API_DIRECTORY_CACHE_HPP
+#define API_DIRECTORY_CACHE_HPP
+
+#include "../core/types.hpp"
+#include <mutex>
+#include <chrono>
+#include <unordered_map>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// How long a listing is reused without rereading the directory, and how
+// many directories are remembered
+constexpr std::chrono::seconds BROWSE_CACHE_TTL{5};
+constexpr size_t BROWSE_CACHE_CAPACITY = 64;
+
+/**
+ * @brief A directory or .shpd file shown by the file browser
+ */
+struct BrowseItem {
+    std::string name;
+    bool is_dir;
+};
+
+/**
+ * @brief Whether a readdir entry is a directory, a regular file or neither
+ *
+ * d_type answers for most filesystems; DT_UNKNOWN (some network and older
+ * filesystems) and symlinks fall back to fstatat relative to the directory.
+ * @return false if the entry is neither, or vanished, and should be skipped
+ */
+inline bool browse_item_type(int dirfd, const char *name, unsigned char d_type, bool &is_dir) {
+    switch (d_type) {
+    case DT_DIR:
+        is_dir = true;
+        return true;
+    case DT_REG:
+        is_dir = false;
+        return true;
+    case DT_LNK:
+    case DT_UNKNOWN: {
+        struct stat st;
+        if (fstatat(dirfd, name, &st, 0) != 0) return false;
+        is_dir = S_ISDIR(st.st_mode);
+        return is_dir || S_ISREG(st.st_mode);
+    }
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Directory listings for the file browser, cached per path
+ *
+ * Entry types come from browse_item_type. A cached listing is reused for
+ * the TTL (BROWSE_CACHE_TTL unless given) as long as the directory's inode and
+ * mtime are unchanged, so the cost of a repeat click is one open + fstat.
+ */
+class DirectoryCache {
+private:
+    struct Listing {
+        std::vector<BrowseItem> items;
+        dev_t dev;
+        ino_t ino;
+        struct timespec mtime;
+        std::chrono::steady_clock::time_point loaded;
+    };
+
+    std::chrono::steady_clock::duration ttl;
+    std::mutex mutex;
+    std::unordered_map<std::string, Listing> listings;
+
+    static bool is_shpd(const char *name, size_t len) {
+        return len > 5 && std::memcmp(name + len - 5, ".shpd", 5) == 0;
+    }
+
+    static std::vector<BrowseItem> read_items(int dirfd) {
+        std::vector<BrowseItem> items;
+
+        // fdopendir takes ownership of its fd; keep ours for the caller
+        DIR *dir = fdopendir(dup(dirfd));
+        if (!dir) return items;
+
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            const char *name = entry->d_name;
+
+            // Skip . and hidden files, but keep ..
+            if (name[0] == '.' && std::strcmp(name, "..") != 0) continue;
+
+            size_t len = std::strlen(name);
+            bool is_dir;
+            if (!browse_item_type(dirfd, name, entry->d_type, is_dir)) continue;
+
+            // Show directories and .shpd files
+            if (is_dir || is_shpd(name, len)) {
+                items.push_back({std::string(name, len), is_dir});
+            }
+        }
+        closedir(dir);
+        return items;
+    }
+
+    void evict_oldest() {
+        auto oldest = listings.begin();
+        for (auto it = listings.begin(); it != listings.end(); ++it) {
+            if (it->second.loaded < oldest->second.loaded) oldest = it;
+        }
+        listings.erase(oldest);
+    }
+
+public:
+    explicit DirectoryCache(std::chrono::steady_clock::duration ttl = BROWSE_CACHE_TTL) : ttl(ttl) {}
+
+    /**
+     * @brief List a directory's subdirectories and .shpd files
+     * @param path Directory to list
+     * @param items Output items in readdir order
+     * @return false if the directory cannot be opened
+     */
+    bool list(const std::string &path, std::vector<BrowseItem> &items) {
+        int dirfd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirfd < 0) return false;
+
+        struct stat st;
+        if (fstat(dirfd, &st) != 0) {
+            close(dirfd);
+            return false;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = listings.find(path);
+            if (it != listings.end() &&
+                now - it->second.loaded < ttl &&
+                it->second.dev == st.st_dev && it->second.ino == st.st_ino &&
+                it->second.mtime.tv_sec == st.st_mtim.tv_sec &&
+                it->second.mtime.tv_nsec == st.st_mtim.tv_nsec) {
+                items = it->second.items;
+                close(dirfd);
+                return true;
+            }
+        }
+
+        items = read_items(dirfd);
+        close(dirfd);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (listings.size() >= BROWSE_CACHE_CAPACITY && listings.find(path) == listings.end()) {
+            evict_oldest();
+        }
+        listings[path] = {items, st.st_dev, st.st_ino, st.st_mtim, now};
+        return true;
+    }
+};
+
+#endif // API_DIRECTORY_CACHE_HPP
@@ -0,0 +1,183 @@
+#ifndef API_ENTRY_PARSER_HPP
+#define API_ENTRY_PARSER_HPP
+
+#include "../core/entry.hpp"
+#include "../core/entry_fields.hpp"
+#include "../core/entry_id.hpp"
+#include "../lib/json.hpp"
+#include "../lib/httplib.h"
+#include "wire_format.hpp"
+
+using json = nlohmann::json;
+
+/**
+ * @brief Fields of an add/edit/delete request body
+ */
+struct EntryRequest {
+    Entry entry;
+    // The entry addressed: by stable id, or by slot for older clients
+    EntryId id;
+    bool has_id = false;
+    size_t index = SIZE_MAX;
+};
+
+/**
+ * @brief SAX handler that writes request fields straight into an Entry
+ *
+ * Avoids building a json DOM for the hot entry endpoints: each string is
+ * copied once, from the lexer's buffer into the fixed-size Entry field.
+ * Only top-level keys are read; nested values are skipped.
+ */
+class EntryRequestSax : public nlohmann::json_sax<json> {
+private:
+    EntryRequest &out;
+    int depth = 0;
+    char *target = nullptr;
+    size_t target_size = 0;
+    bool index_key = false;
+    bool id_key = false;
+    // Points at a literal: the lexer reuses the key's buffer for the value
+    const char *field_name = nullptr;
+
+    bool at_field() const { return depth == 1 && field_name != nullptr; }
+
+    void reject(const std::string &what) {
+        throw std::runtime_error(std::string("Field '") + field_name + "' " + what);
+    }
+
+    void reject_value() {
+        if (!at_field()) return;
+        if (target || id_key) reject("must be a string");
+        if (index_key) reject("must be a non-negative integer");
+    }
+
+public:
+    explicit EntryRequestSax(EntryRequest &request) : out(request) {}
+
+    bool null() override {
+        reject_value();
+        return true;
+    }
+
+    bool boolean(bool) override {
+        reject_value();
+        return true;
+    }
+
+    bool number_integer(number_integer_t val) override {
+        if (at_field() && index_key && val >= 0) {
+            out.index = static_cast<size_t>(val);
+            return true;
+        }
+        reject_value();
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t val) override {
+        if (at_field() && index_key) {
+            out.index = static_cast<size_t>(val);
+            return true;
+        }
+        reject_value();
+        return true;
+    }
+
+    bool number_float(number_float_t, const string_t &) override {
+        reject_value();
+        return true;
+    }
+
+    bool string(string_t &val) override {
+        if (at_field() && target) {
+            std::memset(target, '\0', target_size);
+            std::memcpy(target, val.data(), std::min(val.size(), target_size - 1));
+            return true;
+        }
+        if (at_field() && id_key) {
+            if (!parse_entry_id(val, out.id)) reject("must be a 32-digit hex id");
+            out.has_id = true;
+            return true;
+        }
+        reject_value();
+        return true;
+    }
+
+    bool binary(binary_t &) override {
+        reject_value();
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        if (depth == 0) {
+            depth = 1;
+            return true;
+        }
+        reject_value();
+        depth++;
+        return true;
+    }
+
+    bool key(string_t &val) override {
+        if (depth != 1) return true;
+
+        field_name = nullptr;
+        target = nullptr;
+        index_key = false;
+        id_key = false;
+
+        size_t field = entry_field_by_key(val);
+        if (field < ENTRY_FIELDS.size()) {
+            field_name = ENTRY_FIELDS[field].json_key;
+            target = reinterpret_cast<char *>(&out.entry) + ENTRY_FIELDS[field].offset;
+            target_size = ENTRY_FIELDS[field].size;
+        } else if (val == "index") {
+            field_name = "index";
+            index_key = true;
+        } else if (val == ENTRY_ID_KEY) {
+            field_name = ENTRY_ID_KEY;
+            id_key = true;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        depth--;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (depth == 0) {
+            throw std::runtime_error("Request body must be an object");
+        }
+        reject_value();
+        depth++;
+        return true;
+    }
+
+    bool end_array() override {
+        depth--;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex) override {
+        throw std::runtime_error(ex.what());
+    }
+};
+
+/**
+ * @brief Parse an add/edit/delete body in any negotiated wire format
+ * Throws std::runtime_error on malformed input or mistyped fields
+ */
+inline void parse_entry_request(const httplib::Request &req, EntryRequest &out) {
+    nlohmann::detail::input_format_t format = nlohmann::detail::input_format_t::json;
+    switch (request_format(req)) {
+    case WireFormat::Cbor: format = nlohmann::detail::input_format_t::cbor; break;
+    case WireFormat::MsgPack: format = nlohmann::detail::input_format_t::msgpack; break;
+    case WireFormat::Json: break;
+    }
+
+    EntryRequestSax sax(out);
+    json::sax_parse(req.body, &sax, format);
+}
+
+#endif // API_ENTRY_PARSER_HPP
@@ -0,0 +1,272 @@
+#ifndef API_EXPORTER_HPP
+#define API_EXPORTER_HPP
+
+#include "serializers.hpp"
+#include "../core/types.hpp"
+
+enum class ExportFormat { Csv, JsonLines, Backup };
+
+// Entries read, decrypted and serialized per step; bounds the memory an
+// export needs whatever the size of the vault
+constexpr size_t EXPORT_CHUNK_ENTRIES = 256;
+
+// Backup bundle: [magic][vault salt][secretstream header] then framed messages
+constexpr char BACKUP_MAGIC[8] = {'S', 'H', 'P', 'D', 'B', 'A', 'K', '1'};
+constexpr size_t BACKUP_SALT_SIZE = crypto_pwhash_SALTBYTES;
+constexpr size_t BACKUP_PREFIX_SIZE =
+    sizeof(BACKUP_MAGIC) + BACKUP_SALT_SIZE + crypto_secretstream_xchacha20poly1305_HEADERBYTES;
+// The stream key is a subkey of the vault key, so a bundle opens with the vault password
+constexpr char BACKUP_KDF_CONTEXT[crypto_kdf_CONTEXTBYTES] = {'S', 'H', 'P', 'D', 'B', 'K', 'U', 'P'};
+constexpr uint64_t BACKUP_SUBKEY_ID = 1;
+// Largest message a reader accepts; a chunk of entries as JSON lines is far smaller
+constexpr size_t BACKUP_MAX_MESSAGE_SIZE = 16 * 1024 * 1024;
+
+/**
+ * @brief Export format from ?format=csv|jsonl|backup (CSV when absent)
+ */
+inline ExportFormat export_format(const std::string &format) {
+    if (format.empty() || format == "csv") return ExportFormat::Csv;
+    if (format == "jsonl" || format == "ndjson") return ExportFormat::JsonLines;
+    if (format == "backup") return ExportFormat::Backup;
+    throw std::runtime_error("Unsupported export format: " + format);
+}
+
+inline const char *export_content_type(ExportFormat format) {
+    switch (format) {
+    case ExportFormat::Csv: return "text/csv";
+    case ExportFormat::JsonLines: return "application/x-ndjson";
+    case ExportFormat::Backup: return "application/octet-stream";
+    }
+    return "application/octet-stream";
+}
+
+inline const char *export_extension(ExportFormat format) {
+    switch (format) {
+    case ExportFormat::Csv: return ".csv";
+    case ExportFormat::JsonLines: return ".jsonl";
+    case ExportFormat::Backup: return ".shpdbak";
+    }
+    return "";
+}
+
+/**
+ * @brief Append one CSV field, quoted only when it has to be
+ */
+inline void append_csv_field(std::string &out, std::string_view value) {
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out += value;
+        return;
+    }
+    out += '"';
+    for (char c : value) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+/**
+ * @brief Append one entry as a JSON line (invalid UTF-8 is replaced, not thrown)
+ */
+inline void append_entry_jsonl(std::string &out, const Entry &entry) {
+    out += entry_to_json(entry).dump(-1, ' ', false, json::error_handler_t::replace);
+    out += '\n';
+}
+
+/**
+ * @brief Serializes entries chunk by chunk into CSV, JSON lines or a backup bundle
+ *
+ * CSV uses the ENTRY_FIELDS JSON keys as its header, so exports import back
+ * unchanged. A backup is the JSON lines export sealed with
+ * crypto_secretstream: every chunk becomes one authenticated message, framed
+ * by its 32-bit little-endian length, and the stream ends with a FINAL-tagged
+ * message so truncation is detected. The first message is a metadata line.
+ */
+class EntryExporter {
+private:
+    ExportFormat format;
+    crypto_secretstream_xchacha20poly1305_state state;
+    std::string plain;
+
+    void seal(std::string &out, unsigned char tag) {
+        size_t start = out.size();
+        size_t clen = plain.size() + crypto_secretstream_xchacha20poly1305_ABYTES;
+        out.resize(start + 4 + clen);
+
+        auto *frame = reinterpret_cast<unsigned char *>(out.data() + start);
+        for (int i = 0; i < 4; i++) frame[i] = static_cast<unsigned char>(clen >> (8 * i));
+        crypto_secretstream_xchacha20poly1305_push(&state, frame + 4, nullptr,
+                                                   reinterpret_cast<const unsigned char *>(plain.data()),
+                                                   plain.size(), nullptr, 0, tag);
+        sodium_memzero(plain.data(), plain.size());
+        plain.clear();
+    }
+
+public:
+    /**
+     * @param backup_key Stream key (see Vault::derive_subkey); only used for backups
+     * @param salt Vault salt recorded in the bundle so the key can be re-derived
+     */
+    EntryExporter(ExportFormat export_as, const unsigned char *backup_key = nullptr,
+                  const unsigned char *salt = nullptr)
+        : format(export_as) {
+        if (format == ExportFormat::Backup && (!backup_key || !salt)) {
+            throw std::invalid_argument("Backup export needs a key and salt");
+        }
+        if (format == ExportFormat::Backup) {
+            unsigned char stream_header[crypto_secretstream_xchacha20poly1305_HEADERBYTES];
+            crypto_secretstream_xchacha20poly1305_init_push(&state, stream_header, backup_key);
+            plain.assign(BACKUP_MAGIC, sizeof(BACKUP_MAGIC));
+            plain.append(reinterpret_cast<const char *>(salt), BACKUP_SALT_SIZE);
+            plain.append(reinterpret_cast<const char *>(stream_header), sizeof(stream_header));
+        }
+    }
+
+    ~EntryExporter() {
+        sodium_memzero(&state, sizeof(state));
+        sodium_memzero(plain.data(), plain.size());
+    }
+
+    EntryExporter(const EntryExporter &) = delete;
+    EntryExporter &operator=(const EntryExporter &) = delete;
+
+    /**
+     * @brief Bytes that open the export: CSV header, or bundle prefix and metadata message
+     */
+    std::string begin(const std::string &vault_name, size_t entry_count) {
+        std::string out;
+        if (format == ExportFormat::Csv) {
+            for_each_entry_field([&](auto I) {
+                if (I > 0) out += ',';
+                out += ENTRY_FIELDS[I].json_key;
+            });
+            out += "\r\n";
+        } else if (format == ExportFormat::Backup) {
+            out.swap(plain);
+            json meta = {{"shpd_backup", 1}, {"name", vault_name}, {"entries", entry_count}};
+            plain = meta.dump(-1, ' ', false, json::error_handler_t::replace) + "\n";
+            seal(out, crypto_secretstream_xchacha20poly1305_TAG_MESSAGE);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Append the serialized form of a chunk of entries to out
+     */
+    void write_chunk(const std::vector<Entry> &chunk, std::string &out) {
+        if (format == ExportFormat::Csv) {
+            for (const auto &entry : chunk) {
+                for_each_entry_field([&](auto I) {
+                    if (I > 0) out += ',';
+                    append_csv_field(out, entry_field_view<I>(entry));
+                });
+                out += "\r\n";
+            }
+            return;
+        }
+
+        std::string &target = format == ExportFormat::Backup ? plain : out;
+        for (const auto &entry : chunk) {
+            append_entry_jsonl(target, entry);
+        }
+        if (format == ExportFormat::Backup) {
+            seal(out, crypto_secretstream_xchacha20poly1305_TAG_MESSAGE);
+        }
+    }
+
+    /**
+     * @brief Bytes that close the export (the FINAL message of a backup)
+     */
+    std::string finish() {
+        std::string out;
+        if (format == ExportFormat::Backup) {
+            seal(out, crypto_secretstream_xchacha20poly1305_TAG_FINAL);
+        }
+        return out;
+    }
+};
+
+/**
+ * @brief Incremental reader for backup bundles
+ *
+ * Feed the bundle in any chunking; the decrypted JSON lines (metadata line
+ * first) are passed to the callback one message at a time. Throws on a
+ * corrupted, tampered or truncated bundle.
+ */
+class BackupReader {
+public:
+    // Returns the stream key for the vault salt recorded in the bundle
+    using KeyFn = std::function<void(const unsigned char *salt, unsigned char *key_out)>;
+    using PlainFn = std::function<void(const char *, size_t)>;
+
+private:
+    KeyFn derive_key;
+    crypto_secretstream_xchacha20poly1305_state state;
+    std::string buffer;
+    bool started = false;
+    bool finished = false;
+
+public:
+    explicit BackupReader(KeyFn key_for_salt) : derive_key(std::move(key_for_salt)) {}
+
+    ~BackupReader() { sodium_memzero(&state, sizeof(state)); }
+
+    BackupReader(const BackupReader &) = delete;
+    BackupReader &operator=(const BackupReader &) = delete;
+
+    void feed(const char *data, size_t len, const PlainFn &on_plain) {
+        buffer.append(data, len);
+        size_t pos = 0;
+
+        if (!started) {
+            if (buffer.size() < BACKUP_PREFIX_SIZE) return;
+            if (std::memcmp(buffer.data(), BACKUP_MAGIC, sizeof(BACKUP_MAGIC)) != 0) {
+                throw std::runtime_error("Not a vault backup");
+            }
+            const auto *prefix = reinterpret_cast<const unsigned char *>(buffer.data());
+            unsigned char key[crypto_secretstream_xchacha20poly1305_KEYBYTES];
+            derive_key(prefix + sizeof(BACKUP_MAGIC), key);
+            int rc = crypto_secretstream_xchacha20poly1305_init_pull(
+                &state, prefix + sizeof(BACKUP_MAGIC) + BACKUP_SALT_SIZE, key);
+            sodium_memzero(key, sizeof(key));
+            if (rc != 0) throw std::runtime_error("Invalid backup header");
+            started = true;
+            pos = BACKUP_PREFIX_SIZE;
+        }
+
+        std::vector<unsigned char> message;
+        while (buffer.size() - pos >= 4) {
+            if (finished) throw std::runtime_error("Data after the end of the backup");
+
+            const auto *frame = reinterpret_cast<const unsigned char *>(buffer.data() + pos);
+            size_t clen = frame[0] | (frame[1] << 8) | (frame[2] << 16) | (static_cast<size_t>(frame[3]) << 24);
+            if (clen < crypto_secretstream_xchacha20poly1305_ABYTES || clen > BACKUP_MAX_MESSAGE_SIZE) {
+                throw std::runtime_error("Corrupted backup");
+            }
+            if (buffer.size() - pos - 4 < clen) break;
+
+            message.resize(clen - crypto_secretstream_xchacha20poly1305_ABYTES);
+            unsigned long long mlen = 0;
+            unsigned char tag = 0;
+            if (crypto_secretstream_xchacha20poly1305_pull(&state, message.data(), &mlen, &tag, frame + 4, clen,
+                                                           nullptr, 0) != 0) {
+                throw std::runtime_error("Backup failed authentication (wrong password or tampered file)");
+            }
+            on_plain(reinterpret_cast<const char *>(message.data()), mlen);
+            sodium_memzero(message.data(), message.size());
+
+            finished = tag == crypto_secretstream_xchacha20poly1305_TAG_FINAL;
+            pos += 4 + clen;
+        }
+        buffer.erase(0, pos);
+    }
+
+    /**
+     * @brief Check that the bundle ended with its FINAL message
+     */
+    void finish() const {
+        if (!finished || !buffer.empty()) throw std::runtime_error("Backup is truncated");
+    }
+};
+
+#endif // API_EXPORTER_HPP
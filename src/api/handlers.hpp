@@ -4,11 +4,30 @@
 #include "../vault/vault.hpp"
 #include "../lib/httplib.h"
 #include "serializers.hpp"
-#include <dirent.h>
-#include <sys/stat.h>
+#include "wire_format.hpp"
+#include "entry_parser.hpp"
+#include "change_feed.hpp"
+#include "directory_cache.hpp"
+#include "rate_limiter.hpp"
+#include "importer.hpp"
+#include "exporter.hpp"
+#include "../vault/header_cache.hpp"
+#include "../vault/key_cache.hpp"
+#include "../vault/snapshot.hpp"
+#include "../vault/password_audit.hpp"
+#include "../vault/breach_corpus.hpp"
+#include "../crypto/password_generator.hpp"
+#include "../discovery/vault_index.hpp"
+#include "../metrics/trace.hpp"
 
 using json = nlohmann::json;
 
+// Worker threads for the HTTP server
+constexpr size_t SERVER_THREAD_COUNT = 64;
+// Each open /api/events stream holds a worker for its lifetime; past this
+// many they are refused so every other route keeps workers to run on
+constexpr size_t EVENT_MAX_STREAMS = SERVER_THREAD_COUNT / 2;
+
 /**
  * @brief HTTP API handlers for the password manager
  */
@@ -16,13 +35,162 @@ class ApiHandlers {
 private:
     Vault vault;
 
+    // Guards the vault: httplib serves requests from a thread pool
+    std::mutex vault_mutex;
+    ChangeFeed feed;
+    DirectoryCache browse_cache;
+    AuthRateLimiter auth_limiter;
+    KeyCache key_cache{key_cache_ttl()};
+    VaultIndex vault_index{discovery_roots()};
+
+    // Mapped on the first breach check; taken before vault_mutex when both are held
+    std::mutex breach_mutex;
+    BreachCorpus breach_corpus;
+
+    // Sorted listings return this many entries per page unless asked, and never more than the max
+    static constexpr size_t PAGE_DEFAULT_LIMIT = 50;
+    static constexpr size_t PAGE_MAX_LIMIT = 1000;
+
+    // Idle SSE streams send a comment this often to detect dead clients
+    static constexpr std::chrono::milliseconds EVENT_KEEPALIVE_INTERVAL{15000};
+    // Clients refused a stream, or whose stream ended, reconnect after this long
+    static constexpr int EVENT_RETRY_SECONDS = 5;
+
+    // Random per-process prefix so ETags from an earlier run never match
+    std::string etag_instance;
+
+    std::string make_etag(uint64_t revision) const {
+        return "\"" + etag_instance + "-" + std::to_string(revision) + "\"";
+    }
+
+    // Slot addressed by a request: its "id" when given, else the older "index".
+    // Call with the vault locked; sets an error response and returns false if unknown.
+    bool resolve_entry(bool has_id, const EntryId &id, size_t index, size_t &slot, json &response) {
+        if (has_id) {
+            if (vault.index_of(id, slot)) return true;
+            response["success"] = false;
+            response["error"] = "Unknown entry id";
+            return false;
+        }
+        if (index == SIZE_MAX) {
+            response["success"] = false;
+            response["error"] = "Entry id is required";
+            return false;
+        }
+        slot = index;
+        return true;
+    }
+
+    // Operational routes reveal which vault is open and how it is used, and the
+    // server listens on every interface; only local clients may read them
+    static bool from_loopback(const httplib::Request &req) {
+        const std::string &addr = req.remote_addr;
+        return addr.starts_with("127.") || addr == "::1" || addr.starts_with("::ffff:127.");
+    }
+
+    // Refuse a non-local client; true if the response was sent
+    static bool refuse_remote(const httplib::Request &req, httplib::Response &res) {
+        if (from_loopback(req)) return false;
+        json response;
+        response["success"] = false;
+        response["error"] = "Only available from localhost";
+        res.status = 403;
+        send_response(req, res, response);
+        return true;
+    }
+
+    // After a password unlock, keep the key and hand the client a session token
+    void cache_vault_key(json &response) {
+        VaultIdentity identity;
+        if (!key_cache.enabled() || !vault_identity(vault.get_path(), vault.get_salt(), identity)) return;
+
+        unsigned char key[KEY_CACHE_KEY_SIZE];
+        std::string token;
+        if (vault.copy_key(key)) {
+            key_cache.store(identity, key, token);
+        }
+        sodium_memzero(key, sizeof(key));
+
+        if (!token.empty()) {
+            response["session_token"] = token;
+            response["session_ttl"] = key_cache.time_to_live().count();
+        }
+    }
+
+    json unlock_from_cache(const std::string &token) {
+        VaultIdentity identity;
+        unsigned char key[KEY_CACHE_KEY_SIZE];
+        json response;
+
+        if (vault_identity(vault.get_path(), vault.get_salt(), identity) && key_cache.lookup(identity, token, key)) {
+            response = vault.authenticate_with_key(key);
+            response["cached"] = true;
+        } else {
+            response["success"] = false;
+            response["error"] = "Session expired, enter the password";
+            response["session_expired"] = true;
+        }
+        sodium_memzero(key, sizeof(key));
+        return response;
+    }
+
 public:
+    ApiHandlers() {
+        unsigned char instance[8];
+        randombytes_buf(instance, sizeof(instance));
+        char hex[sizeof(instance) * 2 + 1];
+        sodium_bin2hex(hex, sizeof(hex), instance, sizeof(instance));
+        etag_instance = hex;
+
+        vault.set_change_listener([this](const EntryChange &change) {
+            feed.publish({change.revision, change.type, change.index, entry_id(change.entry)});
+        });
+    }
+
+    // Begin background indexing of .shpd files for /api/vaults; false if no roots are configured
+    bool start_discovery() {
+        vault_index.start();
+        return vault_index.is_enabled();
+    }
+
+    // End every /api/events stream and refuse new ones; call before stopping the server
+    void close_event_streams() { feed.close(); }
+
+    // List vault files found by the background indexer
+    void handle_list_vaults(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            json vaults = json::array();
+            for (const auto &info : vault_index.list()) {
+                json item;
+                item["path"] = info.path;
+                item["name"] = info.name;
+                item["entries"] = info.entries;
+                item["created"] = info.created;
+                item["updated"] = info.updated;
+                vaults.push_back(item);
+            }
+
+            response["success"] = true;
+            response["discovery"] = vault_index.is_enabled();
+            response["indexing"] = vault_index.is_crawling();
+            response["vaults"] = vaults;
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
     // List directory contents for file browser
     void handle_browse(const httplib::Request &req, httplib::Response &res) {
         json response;
 
         try {
-            json request_data = json::parse(req.body);
+            json request_data = parse_request(req);
             std::string path = request_data.value("path", "");
 
             // Default to home directory
@@ -39,45 +207,32 @@ public:
                 }
             }
 
-            DIR *dir = opendir(path.c_str());
-            if (!dir) {
+            std::vector<BrowseItem> listing;
+            if (!browse_cache.list(path, listing)) {
                 response["success"] = false;
                 response["error"] = "Cannot open directory: " + path;
-                res.set_content(response.dump(), "application/json");
+                send_response(req, res, response);
                 return;
             }
 
+            std::string prefix = path;
+            if (prefix.back() != '/') prefix += '/';
+
             json items = json::array();
-            struct dirent *entry;
-
-            while ((entry = readdir(dir)) != nullptr) {
-                std::string name = entry->d_name;
-
-                // Skip . but keep ..
-                if (name == ".") continue;
-                // Skip hidden files except ..
-                if (name[0] == '.' && name != "..") continue;
-
-                std::string full_path = path;
-                if (path.back() != '/') full_path += '/';
-                full_path += name;
-
-                struct stat st;
-                if (stat(full_path.c_str(), &st) == 0) {
-                    bool is_dir = S_ISDIR(st.st_mode);
-                    bool is_shpd = name.size() > 5 && name.substr(name.size() - 5) == ".shpd";
-
-                    // Show directories and .shpd files
-                    if (is_dir || is_shpd) {
-                        json item;
-                        item["name"] = name;
-                        item["path"] = full_path;
-                        item["is_dir"] = is_dir;
-                        items.push_back(item);
-                    }
+            for (const auto &entry : listing) {
+                json item;
+                item["name"] = entry.name;
+                item["path"] = prefix + entry.name;
+                item["is_dir"] = entry.is_dir;
+
+                VaultHeader header;
+                if (!entry.is_dir && peek_header(item["path"].get_ref<const std::string &>(), header)) {
+                    item["vault_name"] = std::string(header.name, strnlen(header.name, NAME_SIZE));
+                    item["entries"] = header.entries;
+                    item["updated"] = header.updated;
                 }
+                items.push_back(item);
             }
-            closedir(dir);
 
             response["success"] = true;
             response["path"] = path;
@@ -88,7 +243,7 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle vault create request
@@ -96,7 +251,8 @@ public:
         json response;
 
         try {
-            json request_data = json::parse(req.body);
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            json request_data = parse_request(req);
             std::string path = request_data.value("path", "");
             std::string password = request_data.value("password", "");
             std::string name = request_data.value("name", "Vault");
@@ -121,7 +277,7 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle vault open request
@@ -129,7 +285,8 @@ public:
         json response;
 
         try {
-            json request_data = json::parse(req.body);
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            json request_data = parse_request(req);
             std::string path = request_data.value("path", "");
 
             // Expand ~ to home directory
@@ -152,7 +309,7 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle vault authentication
@@ -160,14 +317,39 @@ public:
         json response;
 
         try {
-            json request_data = json::parse(req.body);
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            json request_data = parse_request(req);
             std::string password = request_data.value("password", "");
+            std::string session_token = request_data.value("session_token", "");
 
-            if (password.empty()) {
+            if (password.empty() && session_token.empty()) {
                 response["success"] = false;
                 response["error"] = "Password is required";
-            } else {
+            } else if (!vault.is_open()) {
                 response = vault.authenticate(password);
+            } else {
+                // Throttle before the KDF runs, not after
+                auto wait = auth_limiter.admit(req.remote_addr, vault.get_path());
+                if (wait > std::chrono::steady_clock::duration::zero()) {
+                    auto seconds = std::chrono::ceil<std::chrono::seconds>(wait).count();
+                    metrics().add(Counter::AuthRejected, 1);
+                    res.status = 429;
+                    res.set_header("Retry-After", std::to_string(seconds));
+                    response["success"] = false;
+                    response["error"] = "Too many attempts, try again in " + std::to_string(seconds) + "s";
+                    response["retry_after"] = seconds;
+                } else if (password.empty()) {
+                    response = unlock_from_cache(session_token);
+                    // A stale token is not a guess; only successes are reported
+                    if (response.value("success", false)) {
+                        auth_limiter.report(req.remote_addr, vault.get_path(), true);
+                    }
+                } else {
+                    response = vault.authenticate(password);
+                    bool success = response.value("success", false);
+                    auth_limiter.report(req.remote_addr, vault.get_path(), success);
+                    if (success) cache_vault_key(response);
+                }
             }
         }
         catch (const std::exception &e) {
@@ -175,14 +357,15 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle loading vault data
-    void handle_load_data(const httplib::Request &, httplib::Response &res) {
+    void handle_load_data(const httplib::Request &req, httplib::Response &res) {
         json response;
 
         try {
+            std::lock_guard<std::mutex> lock(vault_mutex);
             response = vault.load_entries();
         }
         catch (const std::exception &e) {
@@ -190,36 +373,348 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle getting entries
-    void handle_get_entries(const httplib::Request &, httplib::Response &res) {
+    // Supports If-None-Match against the vault revision ETag, and
+    // ?since=<revision> to return only the changes made after that revision
+    void handle_get_entries(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            std::string etag = make_etag(vault.get_revision());
+            res.set_header("ETag", etag);
+            res.set_header("Cache-Control", "no-cache");
+            // The body depends on the negotiated format and encoding, 304s included
+            res.set_header("Vary", "Accept, Accept-Encoding");
+
+            if (req.get_header_value("If-None-Match") == etag) {
+                res.status = 304;
+                return;
+            }
+
+            std::vector<EntryChange> changes;
+            if (req.has_param("since") &&
+                vault.changes_since(std::stoull(req.get_param_value("since")), changes)) {
+                TraceSpan span("build.changes");
+                json changes_json = json::array();
+
+                for (const auto &change : changes) {
+                    json c;
+                    c["revision"] = change.revision;
+                    c["index"] = change.index;
+                    c["id"] = entry_id_hex(entry_id(change.entry));
+                    c["op"] = change_type_name(change.type);
+                    if (change.type != ChangeType::Delete) {
+                        c["entry"] = entry_to_json(change.entry);
+                    }
+                    changes_json.push_back(c);
+                }
+
+                response["success"] = true;
+                response["full"] = false;
+                response["revision"] = vault.get_revision();
+                response["changes"] = changes_json;
+                for (auto &change : changes) sodium_memzero(&change.entry, sizeof(change.entry));
+            } else {
+                TraceSpan span("build.listing");
+                const auto &entries = vault.get_entries();
+                json entries_json = json::array();
+
+                for (const auto &entry : entries) {
+                    entries_json.push_back(entry_to_json(entry));
+                }
+
+                response["success"] = true;
+                response["full"] = true;
+                response["revision"] = vault.get_revision();
+                response["entries"] = entries_json;
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle filtered listing: entries in a folder (and its subfolders) with every tag
+    // (?folder=Work/Infra&tags=prod,db), answered from the tag index
+    void handle_filter_entries(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            std::string folder = req.get_param_value("folder");
+            std::vector<std::string> tags = parse_tags(req.get_param_value("tags"));
+
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            if (!vault.is_authenticated()) {
+                response["success"] = false;
+                response["error"] = "Not authenticated";
+            } else {
+                Postings slots;
+                {
+                    TraceSpan span("tags.query");
+                    vault.get_tag_index().query(folder, tags, slots);
+                }
+
+                TraceSpan span("build.listing");
+                const auto &entries = vault.get_entries();
+                json entries_json = json::array();
+                for (uint32_t slot : slots) {
+                    entries_json.push_back(entry_to_json(entries[slot]));
+                }
+
+                response["success"] = true;
+                response["revision"] = vault.get_revision();
+                response["count"] = slots.size();
+                response["entries"] = entries_json;
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle one page of a sorted listing
+    // (?sort=name|url|modified&order=asc|desc&offset=N&limit=M; &ids=1 returns only ids)
+    void handle_page_entries(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            SortKey key = sort_key(req.get_param_value("sort"));
+            std::string order = req.has_param("order") ? req.get_param_value("order") : "asc";
+            if (order != "asc" && order != "desc") throw std::runtime_error("Unknown order: " + order);
+            size_t offset = req.has_param("offset") ? std::stoull(req.get_param_value("offset")) : 0;
+            size_t limit = req.has_param("limit") ? std::stoull(req.get_param_value("limit")) : PAGE_DEFAULT_LIMIT;
+            bool ids_only = req.get_param_value("ids") == "1";
+            if (!ids_only) limit = std::min(limit, PAGE_MAX_LIMIT);
+
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            if (!vault.is_authenticated()) {
+                response["success"] = false;
+                response["error"] = "Not authenticated";
+            } else {
+                TraceSpan span("build.page");
+                const auto &entries = vault.get_entries();
+                const SortIndex &sorted = vault.get_sort_index();
+                size_t total = sorted.size();
+                size_t end = offset < total ? offset + std::min(limit, total - offset) : offset;
+
+                json page = json::array();
+                for (size_t rank = offset; rank < end; rank++) {
+                    const Entry &entry = entries[sorted.at(key, rank, order == "desc")];
+                    if (ids_only) {
+                        page.push_back(entry_id_hex(entry_id(entry)));
+                    } else {
+                        page.push_back(entry_to_json(entry));
+                    }
+                }
+
+                response["success"] = true;
+                response["revision"] = vault.get_revision();
+                response["total"] = total;
+                response["offset"] = offset;
+                response[ids_only ? "ids" : "entries"] = page;
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle folder and tag listing with entry counts, for building filters
+    void handle_entry_groups(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            if (!vault.is_authenticated()) {
+                response["success"] = false;
+                response["error"] = "Not authenticated";
+            } else {
+                json folders = json::array();
+                for (const auto &[path, count] : vault.get_tag_index().folder_counts()) {
+                    folders.push_back({{"path", path}, {"count", count}});
+                }
+                json tags = json::array();
+                for (const auto &[tag, count] : vault.get_tag_index().tag_counts()) {
+                    tags.push_back({{"tag", tag}, {"count", count}});
+                }
+
+                response["success"] = true;
+                response["revision"] = vault.get_revision();
+                response["folders"] = folders;
+                response["tags"] = tags;
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle the password reuse audit: groups of entries sharing a password, and
+    // groups whose passwords differ only by case, substitutions or a suffix
+    void handle_audit_reuse(const httplib::Request &req, httplib::Response &res) {
         json response;
 
         try {
-            const auto &entries = vault.get_entries();
-            json entries_json = json::array();
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            if (!vault.is_authenticated()) {
+                response["success"] = false;
+                response["error"] = "Not authenticated";
+            } else {
+                unsigned char audit_key[AUDIT_KEY_SIZE];
+                if (!vault.derive_subkey(AUDIT_SUBKEY_ID, AUDIT_KDF_CONTEXT, audit_key, sizeof(audit_key))) {
+                    throw std::runtime_error("Failed to derive audit key");
+                }
+                ReuseReport report;
+                try {
+                    TraceSpan span("audit.reuse");
+                    audit_password_reuse(vault.get_entries(), audit_key, report);
+                }
+                catch (...) {
+                    sodium_memzero(audit_key, sizeof(audit_key));
+                    throw;
+                }
+                sodium_memzero(audit_key, sizeof(audit_key));
+
+                const auto &entries = vault.get_entries();
+                auto groups_json = [&](const std::vector<ReuseGroup> &groups) {
+                    json out = json::array();
+                    for (const auto &group : groups) {
+                        json ids = json::array();
+                        for (uint32_t slot : group) ids.push_back(entry_id_hex(entry_id(entries[slot])));
+                        out.push_back({{"count", group.size()}, {"ids", ids}});
+                    }
+                    return out;
+                };
 
-            for (const auto &entry : entries) {
-                json e;
-                e["name"] = entry.Name;
-                e["username"] = entry.Username;
-                e["password"] = entry.Password;
-                e["url"] = entry.Website;
-                e["notes"] = entry.Notes;
-                entries_json.push_back(e);
+                response["success"] = true;
+                response["revision"] = vault.get_revision();
+                response["checked"] = report.checked;
+                response["reused"] = groups_json(report.reused);
+                response["similar"] = groups_json(report.similar);
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle the offline breach check: entries whose password is listed in the
+    // corpus named by SHPD_BREACH_CORPUS, and how often it was seen there
+    void handle_audit_breached(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            std::lock_guard<std::mutex> corpus_lock(breach_mutex);
+            if (!breach_corpus.is_open()) {
+                std::string path = breach_corpus_path();
+                if (path.empty()) throw std::runtime_error("No breach corpus configured (set SHPD_BREACH_CORPUS)");
+                TraceSpan span("breach.index");
+                breach_corpus.open(path);
+            }
+
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            if (!vault.is_authenticated()) {
+                response["success"] = false;
+                response["error"] = "Not authenticated";
+            } else {
+                const auto &entries = vault.get_entries();
+                std::vector<BreachHit> hits;
+                {
+                    TraceSpan span("audit.breached");
+                    check_breached_passwords(entries, breach_corpus, hits);
+                }
+
+                json breached = json::array();
+                for (const auto &hit : hits) {
+                    breached.push_back({{"id", entry_id_hex(entry_id(entries[hit.slot]))}, {"count", hit.count}});
+                }
+
+                response["success"] = true;
+                response["revision"] = vault.get_revision();
+                response["checked"] = std::count_if(entries.begin(), entries.end(),
+                                                    [](const Entry &entry) { return entry.Password[0] != '\0'; });
+                response["breached"] = breached;
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle password generation from libsodium's CSPRNG; needs no open vault.
+    // {"mode": "password", "length": 20, "classes": ["upper", ...]} or
+    // {"mode": "passphrase", "words": 6, "separator": "-", "capitalize": false},
+    // either with "count" for up to GENERATE_MAX_COUNT at once
+    void handle_generate(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            json request_data = parse_request(req);
+            std::string mode = request_data.value("mode", "password");
+            size_t count = request_data.value("count", size_t{1});
+            if (count == 0 || count > GENERATE_MAX_COUNT) {
+                throw std::runtime_error("Count must be between 1 and " + std::to_string(GENERATE_MAX_COUNT));
+            }
+
+            TraceSpan span("generate");
+            RandomSampler random;
+            json passwords = json::array();
+            double bits = 0;
+
+            if (mode == "password") {
+                unsigned classes = CHARS_DEFAULT;
+                if (request_data.contains("classes")) {
+                    classes = 0;
+                    for (const auto &name : request_data["classes"]) classes |= char_class(name.get<std::string>());
+                }
+                Alphabet alphabet(classes);
+                size_t length = request_data.value("length", GENERATE_DEFAULT_LENGTH);
+                for (size_t i = 0; i < count; i++) passwords.push_back(generate_password(alphabet, length, random));
+                bits = static_cast<double>(length) * alphabet.bits_per_symbol();
+            } else if (mode == "passphrase") {
+                size_t words = request_data.value("words", PASSPHRASE_DEFAULT_WORDS);
+                std::string separator = request_data.value("separator", "-");
+                bool capitalize = request_data.value("capitalize", false);
+                for (size_t i = 0; i < count; i++) {
+                    passwords.push_back(generate_passphrase(words, separator, capitalize, random));
+                }
+                bits = static_cast<double>(words) * std::log2(static_cast<double>(PASSPHRASE_WORD_COUNT));
+            } else {
+                throw std::runtime_error("Unknown mode: " + mode);
             }
 
             response["success"] = true;
-            response["entries"] = entries_json;
+            response["passwords"] = passwords;
+            response["entropy_bits"] = std::floor(bits);
         }
         catch (const std::exception &e) {
             response["success"] = false;
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle adding a new entry
@@ -227,20 +722,17 @@ public:
         json response;
 
         try {
-            json request_data = json::parse(req.body);
-
-            Entry entry;
-            entry.setName(request_data.value("name", ""));
-            entry.setUsername(request_data.value("username", ""));
-            entry.setPassword(request_data.value("password", ""));
-            entry.setWebsite(request_data.value("url", ""));
-            entry.setNotes(request_data.value("notes", ""));
+            EntryRequest request;
+            parse_entry_request(req, request);
+
+            Entry &entry = request.entry;
             entry.Modf_Time = time(nullptr);
 
             if (strlen(entry.Name) == 0 || strlen(entry.Password) == 0) {
                 response["success"] = false;
                 response["error"] = "Name and password are required";
             } else {
+                std::lock_guard<std::mutex> lock(vault_mutex);
                 response = vault.add_entry(entry);
             }
         }
@@ -249,14 +741,349 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
+    }
+
+    // Handle bulk import of CSV (Bitwarden/KeePass/Chrome layouts) or JSON lines
+    // The body is parsed as it streams in; the vault is locked only while
+    // each batch is encrypted and appended, and every batch must land in the
+    // vault session that was unlocked when the import began
+    void handle_import_entries(const httplib::Request &req, httplib::Response &res,
+                               const httplib::ContentReader &content_reader) {
+        json response;
+        auto started = std::chrono::steady_clock::now();
+
+        try {
+            std::string path;
+            uint64_t session = 0;
+            {
+                std::lock_guard<std::mutex> lock(vault_mutex);
+                if (!vault.is_authenticated()) {
+                    response["success"] = false;
+                    response["error"] = "Not authenticated";
+                    send_response(req, res, response);
+                    return;
+                }
+                path = vault.get_path();
+                session = vault.get_session();
+            }
+
+            ImportFormat format = import_format(req.get_param_value("format"), req.get_header_value("Content-Type"));
+            EntryImporter importer(format, [this, &path, session](const std::vector<Entry> &batch) {
+                std::lock_guard<std::mutex> lock(vault_mutex);
+                if (!vault.is_authenticated() || vault.get_session() != session || vault.get_path() != path) {
+                    throw std::runtime_error("vault changed during import");
+                }
+                json appended = vault.append_entries(batch);
+                if (!appended.value("success", false)) {
+                    throw std::runtime_error(appended.value("error", "Append failed"));
+                }
+            });
+
+            try {
+                content_reader([&](const char *data, size_t len) {
+                    importer.feed(data, len);
+                    return true;
+                });
+                importer.finish();
+                response = importer.report();
+                response["success"] = true;
+            }
+            catch (const std::exception &e) {
+                // Batches appended before the failure stay in the vault
+                response = importer.report();
+                response["success"] = false;
+                response["error"] = std::string("Exception: ") + e.what();
+            }
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            response["seconds"] = seconds;
+            response["entries_per_sec"] = seconds > 0 ? response["imported"].get<size_t>() / seconds : 0.0;
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle export as CSV, JSON lines or an encrypted backup bundle
+    // Streams chunks of EXPORT_CHUNK_ENTRIES read from the file, locking the
+    // vault per chunk; aborts the transfer if the vault changes underneath
+    void handle_export(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            ExportFormat format = export_format(req.get_param_value("format"));
+
+            struct ExportState {
+                std::unique_ptr<EntryExporter> exporter;
+                uint64_t revision = 0;
+                size_t total = 0;
+                size_t next = 0;
+                bool begun = false;
+                std::vector<Entry> chunk;
+                std::string bytes;
+            };
+            auto state = std::make_shared<ExportState>();
+            std::string vault_name;
+
+            {
+                std::lock_guard<std::mutex> lock(vault_mutex);
+                if (!vault.is_open() || !vault.is_authenticated()) {
+                    response["success"] = false;
+                    response["error"] = "Not authenticated";
+                    send_response(req, res, response);
+                    return;
+                }
+
+                if (format == ExportFormat::Backup) {
+                    unsigned char backup_key[crypto_secretstream_xchacha20poly1305_KEYBYTES];
+                    if (!vault.derive_subkey(BACKUP_SUBKEY_ID, BACKUP_KDF_CONTEXT, backup_key, sizeof(backup_key))) {
+                        throw std::runtime_error("Failed to derive backup key");
+                    }
+                    state->exporter = std::make_unique<EntryExporter>(format, backup_key, vault.get_salt());
+                    sodium_memzero(backup_key, sizeof(backup_key));
+                } else {
+                    state->exporter = std::make_unique<EntryExporter>(format);
+                }
+                state->revision = vault.get_revision();
+                state->total = vault.entry_count();
+                vault_name = vault.get_name();
+            }
+
+            std::string filename = vault_name.empty() ? "vault" : vault_name;
+            std::replace_if(filename.begin(), filename.end(),
+                            [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_'; },
+                            '_');
+            res.set_header("Content-Disposition",
+                           "attachment; filename=\"" + filename + export_extension(format) + "\"");
+            res.set_header("Cache-Control", "no-store");
+
+            res.set_chunked_content_provider(export_content_type(format),
+                [this, state, vault_name](size_t, httplib::DataSink &sink) {
+                    TraceSpan span("export.chunk");
+                    state->bytes.clear();
+
+                    if (!state->begun) {
+                        state->bytes = state->exporter->begin(vault_name, state->total);
+                        state->begun = true;
+                    }
+
+                    if (state->next < state->total) {
+                        std::lock_guard<std::mutex> lock(vault_mutex);
+                        // Indices shift on delete; a half-old, half-new export would be wrong
+                        if (vault.get_revision() != state->revision) return false;
+                        json read = vault.read_entries(state->next, EXPORT_CHUNK_ENTRIES, state->chunk);
+                        if (!read.value("success", false) || state->chunk.empty()) return false;
+                    } else {
+                        state->chunk.clear();
+                    }
+
+                    state->next += state->chunk.size();
+                    state->exporter->write_chunk(state->chunk, state->bytes);
+                    for (auto &entry : state->chunk) sodium_memzero(&entry, sizeof(entry));
+
+                    if (state->next >= state->total) state->bytes += state->exporter->finish();
+                    if (!state->bytes.empty() && !sink.write(state->bytes.data(), state->bytes.size())) return false;
+                    sodium_memzero(state->bytes.data(), state->bytes.size());
+
+                    if (state->next >= state->total) sink.done();
+                    return true;
+                });
+            return;
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle point-in-time snapshots of the open vault file
+    // Reflinks when the filesystem allows; otherwise copies without the lock
+    // and then, locked, recopies only what the change log says was rewritten
+    void handle_snapshot(const httplib::Request &req, httplib::Response &res) {
+        json response;
+        auto started = std::chrono::steady_clock::now();
+
+        try {
+            json request_data = parse_request(req);
+            std::string path = request_data.value("path", "");
+
+            // Expand ~ to home directory
+            if (!path.empty() && path[0] == '~') {
+                const char *home = getenv("HOME");
+                if (home) {
+                    path = std::string(home) + path.substr(1);
+                }
+            }
+
+            if (path.empty()) {
+                response["success"] = false;
+                response["error"] = "Path is required";
+            } else if (std::filesystem::exists(path)) {
+                response["success"] = false;
+                response["error"] = "File already exists: " + path;
+            } else {
+                SnapshotWriter writer(path);
+                int src = -1;
+                bool consistent = false;
+                uint64_t revision = 0;
+
+                {
+                    std::lock_guard<std::mutex> lock(vault_mutex);
+                    if (!vault.is_open() || !vault.is_authenticated()) {
+                        throw std::runtime_error("Not authenticated");
+                    }
+                    src = ::open(vault.get_path().c_str(), O_RDONLY | O_CLOEXEC);
+                    if (src < 0) throw std::system_error(errno, std::generic_category(), "cannot read vault");
+                    consistent = writer.clone(src);
+                    revision = vault.get_revision();
+                }
+
+                try {
+                    if (!consistent) {
+                        TraceSpan span("snapshot.copy");
+                        writer.copy(src);
+
+                        std::lock_guard<std::mutex> lock(vault_mutex);
+                        TraceSpan repair_span("snapshot.repair");
+                        std::vector<EntryChange> changes;
+                        if (vault.get_revision() == revision) {
+                            // Nothing was written while copying
+                        } else if (vault.changes_since(revision, changes)) {
+                            writer.repair(src, dirty_ranges(changes));
+                            for (auto &change : changes) sodium_memzero(&change.entry, sizeof(change.entry));
+                        } else {
+                            // The log no longer reaches back (or the vault was reloaded)
+                            writer.repair(src, {{0, SNAPSHOT_TO_END}});
+                        }
+                    }
+                    ::close(src);
+                }
+                catch (...) {
+                    ::close(src);
+                    throw;
+                }
+
+                writer.commit();
+
+                response["success"] = true;
+                response["path"] = path;
+                response["method"] = writer.copy_method();
+                response["revision"] = revision;
+                response["bytes_copied"] = writer.bytes_copied();
+                response["bytes_repaired"] = writer.bytes_repaired();
+                response["seconds"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle entry history: previous versions, newest first (?id=HEX&limit=M, or ?index=N)
+    void handle_entry_history(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            EntryId id;
+            bool has_id = req.has_param("id");
+            if (has_id && !parse_entry_id(req.get_param_value("id"), id)) {
+                throw std::runtime_error("Field 'id' must be a 32-digit hex id");
+            }
+            size_t requested = req.has_param("index") ? std::stoull(req.get_param_value("index")) : SIZE_MAX;
+            size_t limit = req.has_param("limit") ? std::stoull(req.get_param_value("limit")) : SIZE_MAX;
+
+            std::vector<EntryVersion> versions;
+            size_t index = SIZE_MAX;
+            {
+                std::lock_guard<std::mutex> lock(vault_mutex);
+                if (resolve_entry(has_id, id, requested, index, response)) {
+                    response = vault.entry_history(index, limit, versions);
+                }
+            }
+
+            if (response.value("success", false)) {
+                json versions_json = json::array();
+                for (size_t i = 0; i < versions.size(); i++) {
+                    json v = entry_to_json(versions[i].entry);
+                    v["version"] = i + 1;
+                    v["replaced_at"] = versions[i].replaced_at;
+                    versions_json.push_back(v);
+                }
+                response["index"] = index;
+                response["versions"] = versions_json;
+            }
+            for (auto &version : versions) sodium_memzero(&version.entry, sizeof(version.entry));
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
+    }
+
+    // Handle rollback to a previous version ({"id": HEX, "version": V}, 1 = most recent)
+    // The version being replaced goes into the history like any other edit
+    void handle_rollback_entry(const httplib::Request &req, httplib::Response &res) {
+        json response;
+
+        try {
+            json request_data = parse_request(req);
+            EntryId id;
+            bool has_id = request_data.contains(ENTRY_ID_KEY);
+            if (has_id && !parse_entry_id(request_data[ENTRY_ID_KEY].get<std::string>(), id)) {
+                throw std::runtime_error("Field 'id' must be a 32-digit hex id");
+            }
+            size_t requested = request_data.value("index", SIZE_MAX);
+            size_t version = request_data.value("version", 0);
+            size_t index;
+
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            if (version == 0) {
+                response["success"] = false;
+                response["error"] = "Version is required";
+            } else if (resolve_entry(has_id, id, requested, index, response)) {
+                std::vector<EntryVersion> versions;
+                response = vault.entry_history(index, version, versions);
+
+                if (response.value("success", false)) {
+                    if (versions.size() < version) {
+                        response = json::object();
+                        response["success"] = false;
+                        response["error"] = "No such version";
+                    } else {
+                        Entry restored = versions[version - 1].entry;
+                        restored.Modf_Time = time(nullptr);
+                        response = vault.modify_entry(index, restored);
+                        sodium_memzero(&restored, sizeof(restored));
+                    }
+                }
+                for (auto &v : versions) sodium_memzero(&v.entry, sizeof(v.entry));
+            }
+        }
+        catch (const std::exception &e) {
+            response["success"] = false;
+            response["error"] = std::string("Exception: ") + e.what();
+        }
+
+        send_response(req, res, response);
     }
 
     // Handle vault close
-    void handle_close_vault(const httplib::Request &, httplib::Response &res) {
+    void handle_close_vault(const httplib::Request &req, httplib::Response &res) {
         json response;
 
         try {
+            std::lock_guard<std::mutex> lock(vault_mutex);
             response = vault.close();
         }
         catch (const std::exception &e) {
@@ -264,7 +1091,7 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle delete entry
@@ -272,13 +1099,12 @@ public:
         json response;
 
         try {
-            json request_data = json::parse(req.body);
-            size_t index = request_data.value("index", SIZE_MAX);
+            EntryRequest request;
+            parse_entry_request(req, request);
 
-            if (index == SIZE_MAX) {
-                response["success"] = false;
-                response["error"] = "Entry index is required";
-            } else {
+            std::lock_guard<std::mutex> lock(vault_mutex);
+            size_t index;
+            if (resolve_entry(request.has_id, request.id, request.index, index, response)) {
                 response = vault.delete_entry(index);
             }
         }
@@ -287,7 +1113,7 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle modify entry
@@ -295,25 +1121,19 @@ public:
         json response;
 
         try {
-            json request_data = json::parse(req.body);
-            size_t index = request_data.value("index", SIZE_MAX);
+            EntryRequest request;
+            parse_entry_request(req, request);
 
-            if (index == SIZE_MAX) {
+            Entry &entry = request.entry;
+            entry.Modf_Time = time(nullptr);
+
+            if (strlen(entry.Name) == 0 || strlen(entry.Password) == 0) {
                 response["success"] = false;
-                response["error"] = "Entry index is required";
+                response["error"] = "Name and password are required";
             } else {
-                Entry entry;
-                entry.setName(request_data.value("name", ""));
-                entry.setUsername(request_data.value("username", ""));
-                entry.setPassword(request_data.value("password", ""));
-                entry.setWebsite(request_data.value("url", ""));
-                entry.setNotes(request_data.value("notes", ""));
-                entry.Modf_Time = time(nullptr);
-
-                if (strlen(entry.Name) == 0 || strlen(entry.Password) == 0) {
-                    response["success"] = false;
-                    response["error"] = "Name and password are required";
-                } else {
+                std::lock_guard<std::mutex> lock(vault_mutex);
+                size_t index;
+                if (resolve_entry(request.has_id, request.id, request.index, index, response)) {
                     response = vault.modify_entry(index, entry);
                 }
             }
@@ -323,14 +1143,15 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
     }
 
     // Handle vault status check
-    void handle_vault_status(const httplib::Request &, httplib::Response &res) {
+    void handle_vault_status(const httplib::Request &req, httplib::Response &res) {
         json response;
 
         try {
+            std::lock_guard<std::mutex> lock(vault_mutex);
             response["success"] = true;
             response["is_open"] = vault.is_open();
             response["is_authenticated"] = vault.is_authenticated();
@@ -340,7 +1161,106 @@ public:
             response["error"] = std::string("Exception: ") + e.what();
         }
 
-        res.set_content(response.dump(), "application/json");
+        send_response(req, res, response);
+    }
+
+    // Handle Prometheus scrapes, from localhost only
+    // Never takes the vault lock, so a scrape cannot stall behind a KDF
+    void handle_metrics(const httplib::Request &req, httplib::Response &res) {
+        if (refuse_remote(req, res)) return;
+
+        std::string body = metrics().render();
+
+        body += "# HELP shpd_vault_revision Revision of the in-memory entry list\n"
+                "# TYPE shpd_vault_revision gauge\n"
+                "shpd_vault_revision " + std::to_string(feed.current_revision()) + "\n";
+        body += "# HELP shpd_events_subscribers Change feed streams currently waiting\n"
+                "# TYPE shpd_events_subscribers gauge\n"
+                "shpd_events_subscribers " + std::to_string(feed.subscriber_count()) + "\n";
+        body += "# HELP shpd_events_streams Change feed streams currently open\n"
+                "# TYPE shpd_events_streams gauge\n"
+                "shpd_events_streams " + std::to_string(feed.stream_count()) + "\n";
+        body += "# HELP shpd_discovered_vaults Vault files in the discovery catalog\n"
+                "# TYPE shpd_discovered_vaults gauge\n"
+                "shpd_discovered_vaults " + std::to_string(vault_index.list().size()) + "\n";
+
+        res.set_content(std::move(body), "text/plain; version=0.0.4");
+    }
+
+    // Handle trace dumps: Chrome trace-event JSON of the retained spans, from
+    // localhost only
+    void handle_trace(const httplib::Request &req, httplib::Response &res) {
+        if (refuse_remote(req, res)) return;
+
+        res.set_header("Content-Disposition", "attachment; filename=\"shpd-trace.json\"");
+        res.set_content(tracer().render_chrome_trace(), "application/json");
+    }
+
+    // Handle the Server-Sent Events change feed
+    // Streams add/modify/delete/reset events with their revision as the event
+    // id; resumes after ?since=<rev> or the Last-Event-ID header
+    void handle_events(const httplib::Request &req, httplib::Response &res) {
+        uint64_t cursor = feed.current_revision();
+
+        try {
+            if (req.has_param("since")) {
+                cursor = std::stoull(req.get_param_value("since"));
+            } else if (req.has_header("Last-Event-ID")) {
+                cursor = std::stoull(req.get_header_value("Last-Event-ID"));
+            }
+        }
+        catch (const std::exception &) {
+            // Unparseable cursor: start from zero so the client gets a reset
+            cursor = 0;
+        }
+
+        if (!feed.open_stream(EVENT_MAX_STREAMS)) {
+            json response;
+            response["success"] = false;
+            response["error"] = "Too many event streams open, try again later";
+            res.status = 503;
+            res.set_header("Retry-After", std::to_string(EVENT_RETRY_SECONDS));
+            send_response(req, res, response);
+            return;
+        }
+
+        res.set_header("Cache-Control", "no-cache");
+        res.set_chunked_content_provider("text/event-stream",
+            [this, cursor, begun = false](size_t, httplib::DataSink &sink) mutable {
+                // Open with the reconnect delay so the client sees the stream start
+                // before the first event or keepalive
+                if (!begun) {
+                    begun = true;
+                    std::string retry = "retry: " + std::to_string(EVENT_RETRY_SECONDS * 1000) + "\n\n";
+                    return sink.write(retry.data(), retry.size());
+                }
+
+                std::vector<ChangeEvent> events;
+                if (!feed.wait(cursor, EVENT_KEEPALIVE_INTERVAL, events)) {
+                    sink.done();
+                    return true;
+                }
+
+                std::string chunk;
+                if (events.empty()) {
+                    chunk = ": keepalive\n\n";
+                }
+                for (const auto &event : events) {
+                    json data;
+                    data["revision"] = event.revision;
+                    data["op"] = change_type_name(event.type);
+                    data["index"] = event.index;
+                    if (!event.id.is_nil()) data["id"] = entry_id_hex(event.id);
+
+                    chunk += "id: " + std::to_string(event.revision) + "\n";
+                    chunk += "event: change\n";
+                    chunk += "data: " + data.dump() + "\n\n";
+                    cursor = event.revision;
+                }
+                return sink.write(chunk.data(), chunk.size());
+            },
+            // Runs when the response is destroyed, however the stream ended
+            [this](bool) { feed.close_stream(); });
     }
 };
 
@@ -0,0 +1,407 @@
+#ifndef API_IMPORTER_HPP
+#define API_IMPORTER_HPP
+
+#include "../core/entry_fields.hpp"
+#include "../lib/json.hpp"
+#include <array>
+#include <cctype>
+#include <string_view>
+
+using json = nlohmann::json;
+
+enum class ImportFormat { Csv, JsonLines };
+
+// Entries handed to the sink at once: one parallel encrypt and one write each
+constexpr size_t IMPORT_BATCH_SIZE = 1024;
+// Rejected rows described in the report; later ones are only counted
+constexpr size_t IMPORT_MAX_ERRORS = 100;
+// Longest record (CSV row or JSON line) accepted; bounds the parser's buffer
+// when a file is malformed, e.g. has an unterminated quote
+constexpr size_t IMPORT_MAX_RECORD_SIZE = 64 * 1024;
+
+/**
+ * @brief Column header or JSON key understood as an Entry field
+ * Headers are compared lowercased, with surrounding whitespace removed.
+ */
+struct ImportAlias {
+    const char *header;
+    size_t field; // index into ENTRY_FIELDS
+};
+
+constexpr size_t NAME_FIELD = entry_field_by_key("name");
+constexpr size_t USERNAME_FIELD = entry_field_by_key("username");
+constexpr size_t WEBSITE_FIELD = entry_field_by_key("url");
+constexpr size_t PASSWORD_FIELD = entry_field_by_key("password");
+constexpr size_t NOTES_FIELD = entry_field_by_key("notes");
+constexpr size_t FOLDER_FIELD = entry_field_by_key("folder");
+constexpr size_t TAGS_FIELD = entry_field_by_key("tags");
+
+// Bitwarden: folder,favorite,type,name,notes,fields,reprompt,login_uri,login_username,login_password,login_totp
+// KeePassXC: Group,Title,Username,Password,URL,Notes,...
+// KeePass 2: Account,Login Name,Password,Web Site,Comments
+// Chrome:    name,url,username,password,note
+constexpr ImportAlias IMPORT_ALIASES[] = {
+    {"name", NAME_FIELD},          {"title", NAME_FIELD},
+    {"account", NAME_FIELD},       {"username", USERNAME_FIELD},
+    {"user name", USERNAME_FIELD}, {"login name", USERNAME_FIELD},
+    {"login_username", USERNAME_FIELD}, {"url", WEBSITE_FIELD},
+    {"website", WEBSITE_FIELD},    {"web site", WEBSITE_FIELD},
+    {"uri", WEBSITE_FIELD},        {"login_uri", WEBSITE_FIELD},
+    {"password", PASSWORD_FIELD},  {"login_password", PASSWORD_FIELD},
+    {"notes", NOTES_FIELD},        {"note", NOTES_FIELD},
+    {"comments", NOTES_FIELD},     {"folder", FOLDER_FIELD},
+    {"group", FOLDER_FIELD},       {"tags", TAGS_FIELD},
+};
+
+inline std::string normalize_import_header(std::string_view header) {
+    while (!header.empty() && std::isspace(static_cast<unsigned char>(header.front()))) header.remove_prefix(1);
+    while (!header.empty() && std::isspace(static_cast<unsigned char>(header.back()))) header.remove_suffix(1);
+
+    std::string out(header);
+    for (auto &c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return out;
+}
+
+/**
+ * @brief Entry field for a column header or JSON key, or ENTRY_FIELDS.size()
+ */
+inline size_t import_field_for(std::string_view header) {
+    std::string normalized = normalize_import_header(header);
+    for (const auto &alias : IMPORT_ALIASES) {
+        if (normalized == alias.header) return alias.field;
+    }
+    return ENTRY_FIELDS.size();
+}
+
+/**
+ * @brief Name the exporter that wrote a CSV header row, for the import report
+ */
+inline std::string detect_import_layout(const std::vector<std::string> &headers) {
+    std::vector<std::string> names;
+    for (const auto &h : headers) names.push_back(normalize_import_header(h));
+    auto has = [&](const char *name) { return std::find(names.begin(), names.end(), name) != names.end(); };
+
+    if (has("login_uri") || has("login_password")) return "bitwarden";
+    if (has("group") && has("title")) return "keepassxc";
+    if (has("account") && has("login name")) return "keepass";
+    if (has("name") && has("url") && has("username") && has("password")) return "chrome";
+    return "generic";
+}
+
+/**
+ * @brief Incremental RFC 4180 CSV reader
+ *
+ * Accepts the input in arbitrary chunks and calls back once per complete
+ * record, so only the record being parsed is ever buffered. Quoted fields
+ * may contain commas, doubled quotes and line breaks. Lenient where
+ * exporters are sloppy: CRLF or LF line endings, a leading UTF-8 BOM, and
+ * stray quotes inside unquoted fields are all accepted.
+ */
+class CsvReader {
+public:
+    // Called with the record's fields and the line it started on
+    using RecordFn = std::function<void(const std::vector<std::string> &, size_t)>;
+
+private:
+    enum class State { FieldStart, Unquoted, Quoted, QuoteInQuoted };
+
+    State state = State::FieldStart;
+    std::vector<std::string> fields;
+    std::string field;
+    size_t record_bytes = 0;
+    size_t line = 1;
+    size_t record_line = 1;
+    size_t bom_matched = 0;
+    bool at_start = true;
+
+    void end_field() {
+        fields.push_back(std::move(field));
+        field.clear();
+        state = State::FieldStart;
+    }
+
+    void end_record(const RecordFn &on_record) {
+        end_field();
+        // A blank line is one empty field; skip it
+        if (!(fields.size() == 1 && fields[0].empty())) {
+            on_record(fields, record_line);
+        }
+        fields.clear();
+        record_bytes = 0;
+        record_line = line;
+    }
+
+public:
+    void feed(const char *data, size_t len, const RecordFn &on_record) {
+        static constexpr char BOM[] = "\xEF\xBB\xBF";
+
+        for (size_t i = 0; i < len; i++) {
+            char c = data[i];
+
+            if (at_start) {
+                if (bom_matched < 3 && c == BOM[bom_matched]) {
+                    bom_matched++;
+                    continue;
+                }
+                at_start = false;
+            }
+
+            if (++record_bytes > IMPORT_MAX_RECORD_SIZE) {
+                throw std::runtime_error("Record starting on line " + std::to_string(record_line) +
+                                         " is longer than " + std::to_string(IMPORT_MAX_RECORD_SIZE) + " bytes");
+            }
+            if (c == '\n') line++;
+
+            switch (state) {
+            case State::FieldStart:
+            case State::Unquoted:
+                if (c == '"' && state == State::FieldStart) {
+                    state = State::Quoted;
+                } else if (c == ',') {
+                    end_field();
+                } else if (c == '\n') {
+                    end_record(on_record);
+                } else if (c != '\r') {
+                    field += c;
+                    state = State::Unquoted;
+                }
+                break;
+            case State::Quoted:
+                if (c == '"') {
+                    state = State::QuoteInQuoted;
+                } else {
+                    field += c;
+                }
+                break;
+            case State::QuoteInQuoted:
+                if (c == '"') {
+                    field += '"';
+                    state = State::Quoted;
+                } else if (c == ',') {
+                    end_field();
+                } else if (c == '\n') {
+                    end_record(on_record);
+                } else if (c != '\r') {
+                    field += c;
+                    state = State::Unquoted;
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Emit the last record if the input did not end with a newline
+     */
+    void finish(const RecordFn &on_record) {
+        if (state == State::Quoted) {
+            throw std::runtime_error("Unterminated quoted field starting on line " + std::to_string(record_line));
+        }
+        if (state != State::FieldStart || !fields.empty()) {
+            end_record(on_record);
+        }
+    }
+};
+
+/**
+ * @brief Streaming import of CSV or JSON lines into batches of entries
+ *
+ * Stages: the input is parsed record by record as it arrives, each record
+ * is validated against the ENTRY_FIELDS limits, and valid entries are
+ * collected into batches of IMPORT_BATCH_SIZE that are handed to the sink
+ * (which encrypts and appends them). Memory use is one batch plus one
+ * record, whatever the size of the source file. Rejected records are
+ * counted and, up to IMPORT_MAX_ERRORS, reported with their line number.
+ */
+class EntryImporter {
+public:
+    using Sink = std::function<void(const std::vector<Entry> &)>;
+
+private:
+    ImportFormat format;
+    Sink sink;
+    time_t import_time;
+
+    // CSV: column index -> field index (ENTRY_FIELDS.size() for ignored columns)
+    CsvReader csv;
+    std::vector<size_t> columns;
+    bool have_header = false;
+    std::string layout;
+
+    // JSON lines: the line being assembled
+    std::string pending_line;
+    size_t line = 1;
+
+    std::vector<Entry> batch;
+    size_t imported = 0;
+    size_t rejected = 0;
+    json errors = json::array();
+
+    void reject(size_t at_line, const std::string &reason) {
+        rejected++;
+        if (errors.size() < IMPORT_MAX_ERRORS) {
+            errors.push_back({{"line", at_line}, {"error", reason}});
+        }
+    }
+
+    void flush_batch() {
+        if (batch.empty()) return;
+        sink(batch);
+        imported += batch.size();
+        batch.clear();
+    }
+
+    // Validate one record's values and queue it; values are indexed like ENTRY_FIELDS
+    void add_record(const std::array<std::string, ENTRY_FIELDS.size()> &values, size_t at_line) {
+        Entry entry;
+        std::string error;
+
+        for_each_entry_field([&](auto I) {
+            constexpr EntryField field = ENTRY_FIELDS[I];
+            const std::string &value = values[I];
+
+            if (error.empty() && value.empty() && (I == NAME_FIELD || I == PASSWORD_FIELD)) {
+                error = "Missing required field: " + std::string(field.json_key);
+            }
+            if (error.empty() && value.length() > field.size - 1) {
+                error = std::string(field.name) + " too long (max " + std::to_string(field.size - 1) + " characters)";
+            }
+            set_entry_field<I>(entry, value);
+        });
+
+        if (!error.empty()) {
+            reject(at_line, error);
+            return;
+        }
+
+        entry.Modf_Time = import_time;
+        batch.push_back(entry);
+        if (batch.size() >= IMPORT_BATCH_SIZE) flush_batch();
+    }
+
+    void on_csv_record(const std::vector<std::string> &record, size_t at_line) {
+        if (!have_header) {
+            have_header = true;
+            layout = detect_import_layout(record);
+            bool any_known = false;
+            for (const auto &header : record) {
+                columns.push_back(import_field_for(header));
+                any_known |= columns.back() < ENTRY_FIELDS.size();
+            }
+            if (!any_known) {
+                throw std::runtime_error("CSV header has no recognised columns (expected e.g. name, username, url, password, notes)");
+            }
+            return;
+        }
+
+        std::array<std::string, ENTRY_FIELDS.size()> values;
+        for (size_t i = 0; i < record.size() && i < columns.size(); i++) {
+            // Several columns may map to one field; the first non-empty one wins
+            if (columns[i] < ENTRY_FIELDS.size() && values[columns[i]].empty()) {
+                values[columns[i]] = record[i];
+            }
+        }
+        add_record(values, at_line);
+    }
+
+    void on_json_line(size_t at_line) {
+        std::string_view text = pending_line;
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+        if (text.find_first_not_of(" \t") == std::string_view::npos) return;
+
+        json record = json::parse(text, nullptr, false);
+        if (record.is_discarded() || !record.is_object()) {
+            reject(at_line, "Not a JSON object");
+            return;
+        }
+
+        std::array<std::string, ENTRY_FIELDS.size()> values;
+        for (const auto &[key, value] : record.items()) {
+            size_t field = import_field_for(key);
+            if (field >= ENTRY_FIELDS.size() || value.is_null()) continue;
+            if (!value.is_string()) {
+                reject(at_line, "Field " + key + " must be a string");
+                return;
+            }
+            if (values[field].empty()) values[field] = value.get<std::string>();
+        }
+        add_record(values, at_line);
+    }
+
+public:
+    EntryImporter(ImportFormat input_format, Sink batch_sink)
+        : format(input_format), sink(std::move(batch_sink)), import_time(time(nullptr)) {
+        batch.reserve(IMPORT_BATCH_SIZE);
+        if (format == ImportFormat::JsonLines) layout = "jsonl";
+    }
+
+    /**
+     * @brief Parse the next chunk of input; full batches go to the sink
+     */
+    void feed(const char *data, size_t len) {
+        if (format == ImportFormat::Csv) {
+            csv.feed(data, len, [this](const std::vector<std::string> &record, size_t at_line) {
+                on_csv_record(record, at_line);
+            });
+            return;
+        }
+
+        for (size_t i = 0; i < len; i++) {
+            if (data[i] != '\n') {
+                pending_line += data[i];
+                if (pending_line.size() > IMPORT_MAX_RECORD_SIZE) {
+                    throw std::runtime_error("Line " + std::to_string(line) + " is longer than " +
+                                             std::to_string(IMPORT_MAX_RECORD_SIZE) + " bytes");
+                }
+                continue;
+            }
+            on_json_line(line++);
+            pending_line.clear();
+        }
+    }
+
+    /**
+     * @brief Parse whatever is left and hand the final partial batch to the sink
+     */
+    void finish() {
+        if (format == ImportFormat::Csv) {
+            csv.finish([this](const std::vector<std::string> &record, size_t at_line) {
+                on_csv_record(record, at_line);
+            });
+        } else if (!pending_line.empty()) {
+            on_json_line(line);
+            pending_line.clear();
+        }
+        flush_batch();
+    }
+
+    /**
+     * @brief Counts so far: imported, rejected, errors (capped) and detected layout
+     */
+    json report() const {
+        json out;
+        out["imported"] = imported;
+        out["rejected"] = rejected;
+        out["errors"] = errors;
+        out["layout"] = layout.empty() ? "generic" : layout;
+        return out;
+    }
+};
+
+/**
+ * @brief Input format from ?format=csv|jsonl, else from the Content-Type
+ */
+inline ImportFormat import_format(const std::string &format_param, const std::string &content_type) {
+    std::string format = normalize_import_header(format_param);
+    if (format == "jsonl" || format == "ndjson" || format == "json") return ImportFormat::JsonLines;
+    if (format == "csv") return ImportFormat::Csv;
+    if (!format.empty()) throw std::runtime_error("Unsupported import format: " + format_param);
+
+    if (content_type.find("ndjson") != std::string::npos || content_type.find("jsonl") != std::string::npos ||
+        content_type.find("json-lines") != std::string::npos) {
+        return ImportFormat::JsonLines;
+    }
+    return ImportFormat::Csv;
+}
+
+#endif // API_IMPORTER_HPP
@@ -0,0 +1,237 @@
+#ifndef API_RATE_LIMITER_HPP
+#define API_RATE_LIMITER_HPP
+
+#include "../core/types.hpp"
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief Token bucket and failure backoff settings for one kind of key
+ */
+struct RateLimitPolicy {
+    double burst;                              // attempts available at once
+    std::chrono::milliseconds refill_interval; // time to earn back one attempt
+    std::chrono::milliseconds backoff_base;    // lockout after the first failure, doubled per failure
+    std::chrono::milliseconds backoff_cap;     // longest lockout; also how long failures are remembered
+};
+
+// One client may try 5 passwords at once, then one every 12s
+constexpr RateLimitPolicy AUTH_CLIENT_POLICY{5, 12s, 1s, 5min};
+// All clients together may try 20 passwords on one vault, then one every 3s;
+// the shorter cap keeps an attacker from locking the owner out for long
+constexpr RateLimitPolicy AUTH_VAULT_POLICY{20, 3s, 250ms, 30s};
+
+// Expiry wheel: one slot per tick, covering WHEEL_SLOTS * WHEEL_TICK
+constexpr size_t RATE_LIMIT_WHEEL_SLOTS = 512;
+constexpr std::chrono::seconds RATE_LIMIT_WHEEL_TICK{1};
+
+/**
+ * @brief Per-key token buckets with exponential backoff after failures
+ *
+ * Idle keys are dropped by a hashed timing wheel: each key sits in the slot
+ * of the tick at which its bucket is full again and its failures are
+ * forgotten. Advancing the clock visits only the slots that have come due,
+ * so expiry costs O(1) per key instead of scanning the whole map. Keys are
+ * rescheduled lazily: a slot may hold stale references, which are skipped.
+ * Not thread-safe; see AuthRateLimiter.
+ */
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct Bucket {
+        double tokens;
+        Clock::time_point refilled;
+        unsigned failures = 0;
+        Clock::time_point last_failure;
+        Clock::time_point blocked_until;
+        uint64_t wheel_tick = 0;
+    };
+
+    RateLimitPolicy policy;
+    Clock::time_point epoch;
+    uint64_t current_tick = 0;
+    std::unordered_map<std::string, Bucket> buckets;
+    std::vector<std::vector<std::string>> wheel;
+
+    uint64_t tick_of(Clock::time_point t) const {
+        if (t <= epoch) return 0;
+        return static_cast<uint64_t>((t - epoch) / RATE_LIMIT_WHEEL_TICK);
+    }
+
+    void refill(Bucket &bucket, Clock::time_point now) const {
+        if (now <= bucket.refilled) return;
+        double earned = std::chrono::duration<double>(now - bucket.refilled) / policy.refill_interval;
+        bucket.tokens = std::min(policy.burst, bucket.tokens + earned);
+        bucket.refilled = now;
+    }
+
+    // When the key carries no state worth keeping
+    Clock::time_point expiry(const Bucket &bucket) const {
+        auto full = bucket.refilled + std::chrono::duration_cast<Clock::duration>(
+                                          policy.refill_interval * (policy.burst - bucket.tokens));
+        auto expires = std::max(full, bucket.blocked_until);
+        if (bucket.failures > 0) expires = std::max(expires, bucket.last_failure + policy.backoff_cap);
+        return expires;
+    }
+
+    void schedule(const std::string &key, Bucket &bucket) {
+        // Round up so a key is never dropped before it expires
+        uint64_t tick = tick_of(expiry(bucket)) + 1;
+        tick = std::clamp(tick, current_tick + 1, current_tick + RATE_LIMIT_WHEEL_SLOTS - 1);
+        if (bucket.wheel_tick == tick) return;
+        bucket.wheel_tick = tick;
+        wheel[tick % RATE_LIMIT_WHEEL_SLOTS].push_back(key);
+    }
+
+    Bucket &bucket_for(const std::string &key, Clock::time_point now) {
+        auto [it, created] = buckets.try_emplace(key);
+        if (created) {
+            it->second.tokens = policy.burst;
+            it->second.refilled = now;
+        } else {
+            refill(it->second, now);
+        }
+        return it->second;
+    }
+
+public:
+    explicit RateLimiter(const RateLimitPolicy &limits, Clock::time_point start = Clock::now())
+        : policy(limits), epoch(start), wheel(RATE_LIMIT_WHEEL_SLOTS) {}
+
+    /**
+     * @brief Expire keys whose wheel slots have come due
+     */
+    void advance(Clock::time_point now) {
+        uint64_t target = tick_of(now);
+        if (target <= current_tick) return;
+
+        // After a long idle gap every slot is due; visit each only once
+        uint64_t first = std::max(current_tick + 1, target > RATE_LIMIT_WHEEL_SLOTS ? target - RATE_LIMIT_WHEEL_SLOTS + 1 : 0);
+        current_tick = target;
+
+        for (uint64_t tick = first; tick <= target; tick++) {
+            std::vector<std::string> due;
+            due.swap(wheel[tick % RATE_LIMIT_WHEEL_SLOTS]);
+
+            for (const auto &key : due) {
+                auto it = buckets.find(key);
+                if (it == buckets.end()) continue;
+                // Skip stale references, except the ones a long gap jumped over
+                if (it->second.wheel_tick > target) continue;
+
+                refill(it->second, now);
+                if (expiry(it->second) <= now) {
+                    buckets.erase(it);
+                } else {
+                    it->second.wheel_tick = 0;
+                    schedule(key, it->second);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief How long the key must wait before its next attempt; zero if it may go now
+     */
+    Clock::duration retry_after(const std::string &key, Clock::time_point now) const {
+        auto it = buckets.find(key);
+        if (it == buckets.end()) return Clock::duration::zero();
+
+        Bucket bucket = it->second;
+        refill(bucket, now);
+
+        Clock::duration wait = Clock::duration::zero();
+        if (bucket.blocked_until > now) wait = bucket.blocked_until - now;
+        if (bucket.tokens < 1.0) {
+            auto until_token = std::chrono::duration_cast<Clock::duration>(policy.refill_interval * (1.0 - bucket.tokens));
+            wait = std::max(wait, until_token);
+        }
+        return wait;
+    }
+
+    /**
+     * @brief Spend one token; call only after retry_after() returned zero
+     */
+    void take(const std::string &key, Clock::time_point now) {
+        Bucket &bucket = bucket_for(key, now);
+        bucket.tokens = std::max(0.0, bucket.tokens - 1.0);
+        schedule(key, bucket);
+    }
+
+    /**
+     * @brief Record an attempt's outcome: failures back off, a success clears them
+     */
+    void record_result(const std::string &key, bool success, Clock::time_point now) {
+        Bucket &bucket = bucket_for(key, now);
+        if (success) {
+            bucket.failures = 0;
+            bucket.blocked_until = now;
+        } else {
+            bucket.failures++;
+            bucket.last_failure = now;
+            unsigned doublings = std::min(bucket.failures - 1, 20u);
+            auto lockout = std::min<std::chrono::milliseconds>(policy.backoff_base * (1u << doublings),
+                                                               policy.backoff_cap);
+            bucket.blocked_until = now + lockout;
+        }
+        schedule(key, bucket);
+    }
+
+    size_t tracked_keys() const { return buckets.size(); }
+};
+
+/**
+ * @brief Admission control for password attempts, per client and per vault
+ *
+ * An attempt proceeds only if both the client's and the vault's buckets
+ * allow it, and is charged to both; rejected attempts cost no tokens and,
+ * more importantly, no KDF work.
+ */
+class AuthRateLimiter {
+public:
+    using Clock = RateLimiter::Clock;
+
+private:
+    std::mutex mutex;
+    RateLimiter by_client;
+    RateLimiter by_vault;
+
+public:
+    explicit AuthRateLimiter(Clock::time_point start = Clock::now())
+        : by_client(AUTH_CLIENT_POLICY, start), by_vault(AUTH_VAULT_POLICY, start) {}
+
+    /**
+     * @brief Admit an attempt, or say how long to wait
+     * @return zero if the attempt may run its KDF now
+     */
+    Clock::duration admit(const std::string &client, const std::string &vault, Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        by_client.advance(now);
+        by_vault.advance(now);
+
+        auto wait = std::max(by_client.retry_after(client, now), by_vault.retry_after(vault, now));
+        if (wait > Clock::duration::zero()) return wait;
+
+        by_client.take(client, now);
+        by_vault.take(vault, now);
+        return Clock::duration::zero();
+    }
+
+    void report(const std::string &client, const std::string &vault, bool success, Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        by_client.record_result(client, success, now);
+        by_vault.record_result(vault, success, now);
+    }
+
+    size_t tracked_keys() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return by_client.tracked_keys() + by_vault.tracked_keys();
+    }
+};
+
+#endif // API_RATE_LIMITER_HPP
@@ -2,6 +2,8 @@
 #define API_SERIALIZERS_HPP
 
 #include "../core/entry.hpp"
+#include "../core/entry_fields.hpp"
+#include "../core/entry_id.hpp"
 #include "../core/constants.hpp"
 #include "../lib/json.hpp"
 
@@ -10,96 +12,75 @@ using json = nlohmann::json;
 /**
  * @brief Convert an Entry struct to JSON
  */
-json entry_to_json(const Entry &e) {
-    return json{
-        {"name", e.Name},
-        {"username", e.Username},
-        {"website", e.Website},
-        {"password", e.Password},
-        {"notes", e.Notes},
-        {"modf_time", e.Modf_Time}
-    };
+inline json entry_to_json(const Entry &e) {
+    json::object_t j;
+    for_each_entry_field([&](auto I) {
+        j.emplace(ENTRY_FIELDS[I].json_key, json::string_t(entry_field_view<I>(e)));
+    });
+    j.emplace(ENTRY_TIME_KEY, e.Modf_Time);
+    j.emplace(ENTRY_ID_KEY, entry_id_hex(entry_id(e)));
+    return json(std::move(j));
 }
 
 /**
  * @brief Convert JSON to an Entry struct
  */
-Entry json_to_entry(const json &j) {
+inline Entry json_to_entry(const json &j) {
     Entry e;
-    e.setName(j.value("name", ""));
-    e.setUsername(j.value("username", ""));
-    e.setWebsite(j.value("website", ""));
-    e.setPassword(j.value("password", ""));
-    e.setNotes(j.value("notes", ""));
-    e.Modf_Time = j.value("modf_time", time(nullptr));
+    for_each_entry_field([&](auto I) {
+        auto it = j.find(ENTRY_FIELDS[I].json_key);
+        if (it != j.end()) {
+            set_entry_field<I>(e, it->template get_ref<const std::string &>());
+        }
+    });
+    e.Modf_Time = j.value(ENTRY_TIME_KEY, time(nullptr));
     return e;
 }
 
 /**
  * @brief Convert an Entry struct to a string representation
  */
-std::string entry_to_string(const Entry &e) {
-    return "Name: " + std::string(e.Name) + " " +
-           "Username: " + std::string(e.Username) + " " +
-           "Website: " + std::string(e.Website) + " " +
-           "Password: " + std::string(e.Password) + " " +
-           "Notes: " + std::string(e.Notes) + " " +
-           "Modified: " + std::to_string(e.Modf_Time);
+inline std::string entry_to_string(const Entry &e) {
+    std::string out;
+    for_each_entry_field([&](auto I) {
+        out += ENTRY_FIELDS[I].name;
+        out += ": ";
+        out += entry_field_view<I>(e);
+        out += " ";
+    });
+    return out + "Modified: " + std::to_string(e.Modf_Time);
 }
 
 /**
  * @brief Create an Entry from JSON input with validation
  */
-json create_entry_from_json(const json &input_json) {
+inline json create_entry_from_json(const json &input_json) {
     json response;
 
     try {
         Entry entry;
-
-        std::string name = input_json.value("name", "");
-        std::string username = input_json.value("username", "");
-        std::string website = input_json.value("website", "");
-        std::string password = input_json.value("password", "");
-        std::string notes = input_json.value("notes", "");
-
-        // Validate required fields
-        if (name.empty() || username.empty() || website.empty() || password.empty()) {
-            response["success"] = false;
-            response["error"] = "Missing required fields: name, username, website, or password";
-            return response;
-        }
-
-        // Validate field lengths
-        if (name.length() > ENTRY_NAME_SIZE - 1) {
-            response["success"] = false;
-            response["error"] = "Name too long (max " + std::to_string(ENTRY_NAME_SIZE - 1) + " characters)";
-            return response;
-        }
-
-        if (username.length() > ENTRY_USERNAME_SIZE - 1) {
-            response["success"] = false;
-            response["error"] = "Username too long (max " + std::to_string(ENTRY_USERNAME_SIZE - 1) + " characters)";
-            return response;
-        }
-
-        if (website.length() > ENTRY_WEBSITE_SIZE - 1) {
-            response["success"] = false;
-            response["error"] = "Website too long (max " + std::to_string(ENTRY_WEBSITE_SIZE - 1) + " characters)";
-            return response;
-        }
-
-        if (notes.length() > ENTRY_NOTES_SIZE - 1) {
+        std::string error;
+
+        for_each_entry_field([&](auto I) {
+            constexpr EntryField field = ENTRY_FIELDS[I];
+            std::string value = input_json.value(field.json_key, "");
+
+            if (error.empty() && value.empty() && !field.optional) {
+                error = "Missing required field: " + std::string(field.json_key);
+            }
+            if (error.empty() && value.length() > field.size - 1) {
+                error = std::string(field.name) + " too long (max " + std::to_string(field.size - 1) + " characters)";
+            }
+            set_entry_field<I>(entry, value);
+        });
+
+        if (!error.empty()) {
             response["success"] = false;
-            response["error"] = "Notes too long (max " + std::to_string(ENTRY_NOTES_SIZE - 1) + " characters)";
+            response["error"] = error;
             return response;
         }
 
-        entry.setName(name);
-        entry.setUsername(username);
-        entry.setWebsite(website);
-        entry.setPassword(password);
-        entry.setNotes(notes);
-        entry.Modf_Time = input_json.value("modf_time", time(nullptr));
+        entry.Modf_Time = input_json.value(ENTRY_TIME_KEY, time(nullptr));
 
         response["success"] = true;
         response["entry"] = entry_to_json(entry);
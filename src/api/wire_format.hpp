@@ -0,0 +1,119 @@
+#ifndef API_WIRE_FORMAT_HPP
+#define API_WIRE_FORMAT_HPP
+
+#include "../core/types.hpp"
+#include "../lib/httplib.h"
+#include "../lib/json.hpp"
+#include "compression.hpp"
+#include "../metrics/trace.hpp"
+
+using json = nlohmann::json;
+
+enum class WireFormat { Json, Cbor, MsgPack };
+
+/**
+ * @brief Map a media type (parameters ignored) to a wire format
+ * @return true if the media type names a supported format
+ */
+inline bool media_type_format(std::string media_type, WireFormat &format) {
+    media_type = media_type.substr(0, media_type.find(';'));
+    media_type.erase(0, media_type.find_first_not_of(" \t"));
+    media_type.erase(media_type.find_last_not_of(" \t") + 1);
+    std::transform(media_type.begin(), media_type.end(), media_type.begin(), ::tolower);
+
+    if (media_type == "application/json" || media_type == "application/*" || media_type == "*/*") {
+        format = WireFormat::Json;
+    } else if (media_type == "application/cbor") {
+        format = WireFormat::Cbor;
+    } else if (media_type == "application/msgpack" || media_type == "application/x-msgpack" ||
+               media_type == "application/vnd.msgpack") {
+        format = WireFormat::MsgPack;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Format of the request body, from Content-Type (JSON if absent)
+ */
+inline WireFormat request_format(const httplib::Request &req) {
+    WireFormat format = WireFormat::Json;
+    media_type_format(req.get_header_value("Content-Type"), format);
+    return format;
+}
+
+/**
+ * @brief Preferred response format from the Accept header
+ * Highest q-value wins; earlier entries win ties; JSON if nothing matches
+ */
+inline WireFormat response_format(const httplib::Request &req) {
+    WireFormat best = WireFormat::Json;
+    double best_q = 0.0;
+
+    std::istringstream tokens(req.get_header_value("Accept"));
+    std::string token;
+    while (std::getline(tokens, token, ',')) {
+        WireFormat format;
+        if (!media_type_format(token, format)) continue;
+
+        double q = 1.0;
+        size_t q_pos = token.find("q=");
+        if (q_pos != std::string::npos) {
+            q = std::strtod(token.c_str() + q_pos + 2, nullptr);
+        }
+        if (q > best_q) {
+            best = format;
+            best_q = q;
+        }
+    }
+    return best;
+}
+
+inline const char *wire_content_type(WireFormat format) {
+    switch (format) {
+    case WireFormat::Cbor: return "application/cbor";
+    case WireFormat::MsgPack: return "application/msgpack";
+    case WireFormat::Json: break;
+    }
+    return "application/json";
+}
+
+/**
+ * @brief Decode a request body in the format named by its Content-Type
+ * Throws nlohmann::json::exception on malformed input, like json::parse
+ */
+inline json parse_request(const httplib::Request &req) {
+    switch (request_format(req)) {
+    case WireFormat::Cbor: return json::from_cbor(req.body);
+    case WireFormat::MsgPack: return json::from_msgpack(req.body);
+    case WireFormat::Json: break;
+    }
+    return json::parse(req.body);
+}
+
+/**
+ * @brief Encode a response in the negotiated format, compressing if allowed
+ */
+inline void send_response(const httplib::Request &req, httplib::Response &res, const json &response) {
+    TraceSpan span("serialize.response");
+    WireFormat format = response_format(req);
+    if (format == WireFormat::Json) {
+        send_json(req, res, response);
+        return;
+    }
+
+    auto writer = std::make_shared<CompressingWriter>(
+        negotiate_encoding(req.get_header_value("Accept-Encoding")));
+    nlohmann::detail::binary_writer<json, char> binary(writer);
+
+    if (format == WireFormat::Cbor) {
+        binary.write_cbor(response);
+    } else {
+        binary.write_msgpack(response);
+    }
+
+    set_compressed_content(res, *writer, wire_content_type(format));
+}
+
+#endif // API_WIRE_FORMAT_HPP
@@ -0,0 +1,190 @@
+#ifndef CLI_EXPORT_COMMAND_HPP
+#define CLI_EXPORT_COMMAND_HPP
+
+#include "../vault/vault.hpp"
+#include "../api/exporter.hpp"
+#include <termios.h>
+#include <unistd.h>
+
+// Bytes read from a backup file per step
+constexpr size_t BACKUP_READ_CHUNK = 64 * 1024;
+
+/**
+ * @brief Read a password from the terminal without echo, or a line from piped stdin
+ */
+inline std::string read_password(const char *prompt) {
+    bool tty = isatty(STDIN_FILENO);
+    termios saved{};
+    if (tty) {
+        std::cerr << prompt << std::flush;
+        tcgetattr(STDIN_FILENO, &saved);
+        termios quiet = saved;
+        quiet.c_lflag &= ~ECHO;
+        tcsetattr(STDIN_FILENO, TCSANOW, &quiet);
+    }
+
+    std::string password;
+    std::getline(std::cin, password);
+
+    if (tty) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+        std::cerr << std::endl;
+    }
+    return password;
+}
+
+/**
+ * @brief Parse "--name value" pairs; false on a stray or unknown argument
+ */
+inline bool parse_command_options(int argc, char **argv, std::initializer_list<const char *> known,
+                           std::unordered_map<std::string, std::string> &out) {
+    for (int i = 2; i < argc; i += 2) {
+        std::string name = argv[i];
+        if (i + 1 >= argc || std::find(known.begin(), known.end(), name) == known.end()) return false;
+        out[name] = argv[i + 1];
+    }
+    return true;
+}
+
+/**
+ * @brief password_manager export --vault PATH [--format csv|jsonl|backup] [--out FILE]
+ * Streams the vault out a chunk at a time, like GET /api/vault/export. The
+ * vault is opened read-only: an older format is read as it is, not upgraded.
+ */
+inline int run_export_command(int argc, char **argv) {
+    std::unordered_map<std::string, std::string> opts;
+    if (!parse_command_options(argc, argv, {"--vault", "--format", "--out"}, opts) || !opts.count("--vault")) {
+        std::cerr << "Usage: password_manager export --vault PATH [--format csv|jsonl|backup] [--out FILE]"
+                  << std::endl;
+        return 2;
+    }
+
+    try {
+        ExportFormat format = export_format(opts["--format"]);
+
+        Vault vault;
+        json result = vault.open(opts["--vault"], true);
+        if (result.value("success", false)) {
+            std::string password = read_password("Vault password: ");
+            result = vault.authenticate(password);
+            sodium_memzero(password.data(), password.size());
+        }
+        if (!result.value("success", false)) {
+            std::cerr << result.value("error", "Failed to unlock vault") << std::endl;
+            return 1;
+        }
+
+        std::unique_ptr<EntryExporter> exporter;
+        if (format == ExportFormat::Backup) {
+            unsigned char backup_key[crypto_secretstream_xchacha20poly1305_KEYBYTES];
+            if (!vault.derive_subkey(BACKUP_SUBKEY_ID, BACKUP_KDF_CONTEXT, backup_key, sizeof(backup_key))) {
+                std::cerr << "Failed to derive backup key" << std::endl;
+                return 1;
+            }
+            exporter = std::make_unique<EntryExporter>(format, backup_key, vault.get_salt());
+            sodium_memzero(backup_key, sizeof(backup_key));
+        } else {
+            exporter = std::make_unique<EntryExporter>(format);
+        }
+
+        std::ofstream file;
+        if (opts.count("--out")) {
+            file.open(opts["--out"], std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "Cannot write " << opts["--out"] << std::endl;
+                return 1;
+            }
+        }
+        std::ostream &out = file.is_open() ? static_cast<std::ostream &>(file) : std::cout;
+
+        std::string bytes = exporter->begin(vault.get_name(), vault.entry_count());
+        std::vector<Entry> chunk;
+        for (size_t next = 0; next < vault.entry_count(); next += chunk.size()) {
+            result = vault.read_entries(next, EXPORT_CHUNK_ENTRIES, chunk);
+            if (!result.value("success", false) || chunk.empty()) {
+                std::cerr << result.value("error", "Failed to read entries") << std::endl;
+                return 1;
+            }
+            exporter->write_chunk(chunk, bytes);
+            for (auto &entry : chunk) sodium_memzero(&entry, sizeof(entry));
+            out.write(bytes.data(), bytes.size());
+            sodium_memzero(bytes.data(), bytes.size());
+            bytes.clear();
+        }
+        bytes += exporter->finish();
+        out.write(bytes.data(), bytes.size());
+        out.flush();
+
+        std::cerr << "Exported " << vault.entry_count() << " entries" << std::endl;
+        return out ? 0 : 1;
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Export failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief password_manager decrypt-backup --in FILE [--out FILE]
+ * Writes the entries of a backup bundle as JSON lines, ready for
+ * POST /api/entries/import?format=jsonl; the metadata line goes to stderr.
+ */
+inline int run_decrypt_backup_command(int argc, char **argv) {
+    std::unordered_map<std::string, std::string> opts;
+    if (!parse_command_options(argc, argv, {"--in", "--out"}, opts) || !opts.count("--in")) {
+        std::cerr << "Usage: password_manager decrypt-backup --in FILE [--out FILE]" << std::endl;
+        return 2;
+    }
+
+    std::ifstream in(opts["--in"], std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Cannot read " << opts["--in"] << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (opts.count("--out")) {
+        file.open(opts["--out"], std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Cannot write " << opts["--out"] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = file.is_open() ? static_cast<std::ostream &>(file) : std::cout;
+
+    try {
+        std::string password = read_password("Vault password: ");
+        BackupReader reader([&](const unsigned char *salt, unsigned char *key_out) {
+            unsigned char vault_key[crypto_secretbox_KEYBYTES];
+            bool derived = derive_key_from_password(password, salt, vault_key) &&
+                           crypto_kdf_derive_from_key(key_out, crypto_secretstream_xchacha20poly1305_KEYBYTES,
+                                                      BACKUP_SUBKEY_ID, BACKUP_KDF_CONTEXT, vault_key) == 0;
+            sodium_memzero(vault_key, sizeof(vault_key));
+            sodium_memzero(password.data(), password.size());
+            if (!derived) throw std::runtime_error("Failed to derive key");
+        });
+
+        bool metadata = true;
+        std::vector<char> buffer(BACKUP_READ_CHUNK);
+        while (in) {
+            in.read(buffer.data(), buffer.size());
+            reader.feed(buffer.data(), static_cast<size_t>(in.gcount()), [&](const char *data, size_t len) {
+                if (metadata) {
+                    std::cerr.write(data, len);
+                    metadata = false;
+                } else {
+                    out.write(data, len);
+                }
+            });
+        }
+        reader.finish();
+        out.flush();
+        return out ? 0 : 1;
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Decrypt failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+#endif // CLI_EXPORT_COMMAND_HPP
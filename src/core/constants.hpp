@@ -17,14 +17,32 @@ constexpr size_t ENTRY_USERNAME_SIZE = 32;
 constexpr size_t ENTRY_WEBSITE_SIZE = 64;
 constexpr size_t ENTRY_PASSWORD_SIZE = 64;
 constexpr size_t ENTRY_NOTES_SIZE = 128;
-constexpr size_t ENTRY_SIZE = ENTRY_NAME_SIZE + ENTRY_USERNAME_SIZE + ENTRY_WEBSITE_SIZE + ENTRY_PASSWORD_SIZE + ENTRY_NOTES_SIZE + sizeof(time_t);
+constexpr size_t ENTRY_ID_SIZE = 16;
+constexpr size_t ENTRY_FOLDER_SIZE = 128;
+constexpr size_t ENTRY_TAGS_SIZE = 128;
+constexpr size_t ENTRY_SIZE = ENTRY_NAME_SIZE + ENTRY_USERNAME_SIZE + ENTRY_WEBSITE_SIZE + ENTRY_PASSWORD_SIZE + ENTRY_NOTES_SIZE + sizeof(time_t) + ENTRY_ID_SIZE + ENTRY_FOLDER_SIZE + ENTRY_TAGS_SIZE;
 
 // Encrypted entry size: NONCE(12) + sizeof(Entry) + TAG(16)
-// sizeof(Entry) = 320 (fields) + 8 (time_t) = 328, plus NONCE + TAG = 356
-constexpr size_t ENCRYPTED_ENTRY_SIZE = 356;
+// sizeof(Entry) = 320 (fields) + 8 (time_t) + 16 (id) + 256 (folder, tags) = 600, plus NONCE + TAG = 628
+constexpr size_t ENCRYPTED_ENTRY_SIZE = 628;
 
 // Vault file signature and version
 constexpr char SIGNATURE[SIGNATURE_SIZE] = "SHPD";
-constexpr char CURR_VERSION[VERSION_SIZE] = "0.1";
+constexpr char CURR_VERSION[VERSION_SIZE] = "0.3";
+
+/**
+ * @brief An earlier vault format; its entries are a prefix of the current Entry
+ * 0.1 had no id, 0.2 no folder or tags. Such vaults are upgraded on unlock.
+ */
+struct LegacyFormat {
+    char version[VERSION_SIZE];
+    size_t entry_size;
+    size_t encrypted_size;
+};
+
+constexpr LegacyFormat LEGACY_FORMATS[] = {
+    {"0.1", 328, 356},
+    {"0.2", 344, 372},
+};
 
 #endif // CORE_CONSTANTS_HPP
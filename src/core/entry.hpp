@@ -6,7 +6,10 @@
 
 /**
  * @brief Struct to represent a vault entry.
- * Contains: Name, Username, Website, Password, Notes, Modification Time
+ * Contains: Name, Username, Website, Password, Notes, Modification Time, Id, Folder, Tags
+ * Id is a random 128-bit identifier that stays with the entry for its lifetime.
+ * Folder is a '/'-separated path and Tags a comma-separated list (see tag_index.hpp).
+ * Fields are only ever added at the end, so older layouts stay a prefix of this one.
  */
 struct Entry {
     char Name[ENTRY_NAME_SIZE]{};
@@ -15,6 +18,9 @@ struct Entry {
     char Password[ENTRY_PASSWORD_SIZE]{};
     char Notes[ENTRY_NOTES_SIZE]{};
     time_t Modf_Time{};
+    unsigned char Id[ENTRY_ID_SIZE]{};
+    char Folder[ENTRY_FOLDER_SIZE]{};
+    char Tags[ENTRY_TAGS_SIZE]{};
 
     Entry() : Modf_Time(0) {}
 
@@ -43,6 +49,16 @@ struct Entry {
         std::memset(Notes, '\0', ENTRY_NOTES_SIZE);
         std::memcpy(Notes, val.c_str(), std::min(val.size(), ENTRY_NOTES_SIZE - 1));
     }
+
+    void setFolder(const std::string &val) {
+        std::memset(Folder, '\0', ENTRY_FOLDER_SIZE);
+        std::memcpy(Folder, val.c_str(), std::min(val.size(), ENTRY_FOLDER_SIZE - 1));
+    }
+
+    void setTags(const std::string &val) {
+        std::memset(Tags, '\0', ENTRY_TAGS_SIZE);
+        std::memcpy(Tags, val.c_str(), std::min(val.size(), ENTRY_TAGS_SIZE - 1));
+    }
 };
 
 #endif // CORE_ENTRY_HPP
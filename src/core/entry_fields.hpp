@@ -0,0 +1,97 @@
+#ifndef CORE_ENTRY_FIELDS_HPP
+#define CORE_ENTRY_FIELDS_HPP
+
+#include "types.hpp"
+#include "entry.hpp"
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief Compile-time description of one fixed-size text field of Entry
+ */
+struct EntryField {
+    const char *name;
+    size_t offset;
+    size_t size;
+    const char *json_key;
+    bool optional = false; // may be left empty when creating an entry
+};
+
+/**
+ * @brief Every text field of Entry, in struct order
+ * The single source of truth for JSON keys, field limits and layout;
+ * serializers, parsers and importers are generated from it.
+ */
+constexpr std::array<EntryField, 7> ENTRY_FIELDS = {{
+    {"Name", offsetof(Entry, Name), ENTRY_NAME_SIZE, "name"},
+    {"Username", offsetof(Entry, Username), ENTRY_USERNAME_SIZE, "username"},
+    {"Website", offsetof(Entry, Website), ENTRY_WEBSITE_SIZE, "url"},
+    {"Password", offsetof(Entry, Password), ENTRY_PASSWORD_SIZE, "password"},
+    {"Notes", offsetof(Entry, Notes), ENTRY_NOTES_SIZE, "notes", true},
+    {"Folder", offsetof(Entry, Folder), ENTRY_FOLDER_SIZE, "folder", true},
+    {"Tags", offsetof(Entry, Tags), ENTRY_TAGS_SIZE, "tags", true},
+}};
+
+// JSON key of Entry::Modf_Time, the only non-text field
+constexpr const char *ENTRY_TIME_KEY = "modf_time";
+
+static_assert(std::is_standard_layout_v<Entry>, "Entry field offsets require a standard-layout struct");
+static_assert(ENTRY_NAME_SIZE + ENTRY_USERNAME_SIZE + ENTRY_WEBSITE_SIZE + ENTRY_PASSWORD_SIZE + ENTRY_NOTES_SIZE ==
+                  offsetof(Entry, Modf_Time) &&
+                  offsetof(Entry, Folder) + ENTRY_FOLDER_SIZE + ENTRY_TAGS_SIZE == sizeof(Entry),
+              "ENTRY_FIELDS must cover every text field of Entry");
+
+/**
+ * @brief Invoke f(std::integral_constant<size_t, I>) for every field index
+ * Unrolled at compile time, so ENTRY_FIELDS[I] is a constant in the body.
+ */
+template <typename F>
+constexpr void for_each_entry_field(F &&f) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<size_t, I>{}), ...);
+    }(std::make_index_sequence<ENTRY_FIELDS.size()>{});
+}
+
+template <size_t I>
+char *entry_field(Entry &entry) {
+    return reinterpret_cast<char *>(&entry) + ENTRY_FIELDS[I].offset;
+}
+
+template <size_t I>
+const char *entry_field(const Entry &entry) {
+    return reinterpret_cast<const char *>(&entry) + ENTRY_FIELDS[I].offset;
+}
+
+/**
+ * @brief Field contents up to the first NUL, never reading past the field
+ */
+template <size_t I>
+std::string_view entry_field_view(const Entry &entry) {
+    const char *data = entry_field<I>(entry);
+    return std::string_view(data, strnlen(data, ENTRY_FIELDS[I].size));
+}
+
+/**
+ * @brief Store a value into a field the way the Entry setters do
+ * Zero-fills the field and truncates to leave room for the terminator.
+ */
+template <size_t I>
+void set_entry_field(Entry &entry, std::string_view value) {
+    char *data = entry_field<I>(entry);
+    std::memset(data, '\0', ENTRY_FIELDS[I].size);
+    std::memcpy(data, value.data(), std::min(value.size(), ENTRY_FIELDS[I].size - 1));
+}
+
+/**
+ * @brief Index of the field with the given JSON key, or ENTRY_FIELDS.size()
+ */
+constexpr size_t entry_field_by_key(std::string_view key) {
+    for (size_t i = 0; i < ENTRY_FIELDS.size(); i++) {
+        if (key == ENTRY_FIELDS[i].json_key) return i;
+    }
+    return ENTRY_FIELDS.size();
+}
+
+#endif // CORE_ENTRY_FIELDS_HPP
@@ -0,0 +1,69 @@
+#ifndef CORE_ENTRY_ID_HPP
+#define CORE_ENTRY_ID_HPP
+
+#include "types.hpp"
+#include "entry.hpp"
+#include <string_view>
+#include <unordered_map>
+
+// JSON key of Entry::Id, sent as 32 lowercase hex digits
+constexpr const char *ENTRY_ID_KEY = "id";
+
+/**
+ * @brief Stable identifier of an entry, independent of its slot
+ */
+struct EntryId {
+    unsigned char bytes[ENTRY_ID_SIZE]{};
+
+    bool operator==(const EntryId &other) const { return std::memcmp(bytes, other.bytes, ENTRY_ID_SIZE) == 0; }
+
+    bool is_nil() const {
+        static constexpr unsigned char nil[ENTRY_ID_SIZE]{};
+        return std::memcmp(bytes, nil, ENTRY_ID_SIZE) == 0;
+    }
+};
+
+// Ids are uniformly random, so any eight of their bytes are already a good hash
+struct EntryIdHash {
+    size_t operator()(const EntryId &id) const {
+        size_t h;
+        std::memcpy(&h, id.bytes, sizeof(h));
+        return h;
+    }
+};
+
+inline EntryId entry_id(const Entry &entry) {
+    EntryId id;
+    std::memcpy(id.bytes, entry.Id, ENTRY_ID_SIZE);
+    return id;
+}
+
+inline void set_entry_id(Entry &entry, const EntryId &id) {
+    std::memcpy(entry.Id, id.bytes, ENTRY_ID_SIZE);
+}
+
+inline EntryId new_entry_id() {
+    EntryId id;
+    do {
+        randombytes_buf(id.bytes, ENTRY_ID_SIZE);
+    } while (id.is_nil());
+    return id;
+}
+
+inline std::string entry_id_hex(const EntryId &id) {
+    char hex[ENTRY_ID_SIZE * 2 + 1];
+    sodium_bin2hex(hex, sizeof(hex), id.bytes, ENTRY_ID_SIZE);
+    return hex;
+}
+
+/**
+ * @brief Parse 32 hex digits; false if the text is not exactly an id
+ */
+inline bool parse_entry_id(std::string_view hex, EntryId &out) {
+    size_t len = 0;
+    return hex.size() == ENTRY_ID_SIZE * 2 &&
+           sodium_hex2bin(out.bytes, ENTRY_ID_SIZE, hex.data(), hex.size(), nullptr, &len, nullptr) == 0 &&
+           len == ENTRY_ID_SIZE;
+}
+
+#endif // CORE_ENTRY_ID_HPP
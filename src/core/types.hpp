@@ -7,6 +7,8 @@
 #include <cstring>
 #include <ctime>
 #include <vector>
+#include <deque>
+#include <functional>
 #include <unordered_set>
 #include <fstream>
 #include <sstream>
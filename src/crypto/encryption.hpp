@@ -14,7 +14,7 @@ constexpr int NONCE_SIZE = crypto_aead_chacha20poly1305_ietf_NPUBBYTES;
  * @param entry Entry struct to encrypt
  * @param out_buff Output buffer: [NONCE][CIPHERTEXT+TAG]
  */
-void encrypt_entry(
+inline void encrypt_entry(
     const unsigned char *key,
     const Entry &entry,
     std::vector<unsigned char> &out_buff) {
@@ -55,7 +55,7 @@ void encrypt_entry(
  * @param cipher Input buffer containing [NONCE][CIPHERTEXT+TAG]
  * @param cipher_len Length of the input buffer
  */
-void decrypt_entry(
+inline void decrypt_entry(
     const unsigned char *key,
     Entry &entry,
     const unsigned char *cipher,
@@ -87,4 +87,37 @@ void decrypt_entry(
     std::memcpy(&entry, plaintext.data(), sizeof(Entry));
 }
 
+/**
+ * @brief Decrypt an entry sealed by an earlier vault format
+ * The old layout is a prefix of the current one; fields it lacked are left zero.
+ * @param cipher Input buffer of format.encrypted_size bytes
+ */
+inline void decrypt_legacy_entry(
+    const unsigned char *key,
+    const LegacyFormat &format,
+    Entry &entry,
+    const unsigned char *cipher) {
+
+    unsigned char plaintext[sizeof(Entry)];
+    unsigned long long plen;
+
+    if (crypto_aead_chacha20poly1305_ietf_decrypt(
+            plaintext, &plen,
+            nullptr,
+            cipher + NONCE_SIZE, format.encrypted_size - NONCE_SIZE,
+            nullptr, 0,
+            cipher,
+            key) != 0) {
+        throw std::runtime_error("decrypt failed");
+    }
+
+    if (plen != format.entry_size) {
+        sodium_memzero(plaintext, sizeof(plaintext));
+        throw std::runtime_error("decrypted size mismatch");
+    }
+    entry = Entry{};
+    std::memcpy(static_cast<void *>(&entry), plaintext, format.entry_size);
+    sodium_memzero(plaintext, sizeof(plaintext));
+}
+
 #endif // CRYPTO_ENCRYPTION_HPP
@@ -15,7 +15,7 @@ constexpr int HASH_SIZE = crypto_pwhash_STRBYTES;
  * @param password Password to hash
  * @return Hashed password string
  */
-std::string hash_password(const std::string &password) {
+inline std::string hash_password(const std::string &password) {
     char hashed[crypto_pwhash_STRBYTES];
     if (crypto_pwhash_argon2id_str(
             hashed,
@@ -34,7 +34,7 @@ std::string hash_password(const std::string &password) {
  * @param password The password to verify
  * @return JSON response with success status
  */
-json verify_password(const std::string &stored_hash, const std::string &password) {
+inline json verify_password(const std::string &stored_hash, const std::string &password) {
     json response;
 
     try {
@@ -63,7 +63,7 @@ json verify_password(const std::string &stored_hash, const std::string &password
  * @param key Output buffer for the derived key
  * @return true if key derivation is successful, false otherwise
  */
-bool derive_key_from_password(
+inline bool derive_key_from_password(
     const std::string &password,
     const unsigned char *salt,
     unsigned char key[crypto_secretbox_KEYBYTES]) {
@@ -0,0 +1,195 @@
+#ifndef CRYPTO_PASSWORD_GENERATOR_HPP
+#define CRYPTO_PASSWORD_GENERATOR_HPP
+
+#include "../core/types.hpp"
+#include "../core/constants.hpp"
+#include "wordlist.hpp"
+#include <bit>
+#include <cmath>
+
+// Generated secrets must fit an entry's Password field
+constexpr size_t GENERATED_MAX_BYTES = ENTRY_PASSWORD_SIZE - 1;
+// Most secrets one request may ask for
+constexpr size_t GENERATE_MAX_COUNT = 10000;
+constexpr size_t PASSPHRASE_MAX_SEPARATOR = 3;
+constexpr size_t GENERATE_DEFAULT_LENGTH = 20;
+constexpr size_t PASSPHRASE_DEFAULT_WORDS = 6;
+
+/**
+ * @brief Character classes a password can draw from, as bit flags
+ */
+enum CharClass : unsigned {
+    CHARS_UPPER = 1,
+    CHARS_LOWER = 2,
+    CHARS_DIGITS = 4,
+    CHARS_SYMBOLS = 8,
+    CHARS_EXTENDED = 16,
+};
+
+struct CharClassInfo {
+    std::string_view name;
+    CharClass flag;
+    std::string_view symbols; // UTF-8
+};
+
+constexpr CharClassInfo CHAR_CLASSES[] = {
+    {"upper", CHARS_UPPER, "ABCDEFGHIJKLMNOPQRSTUVWXYZ"},
+    {"lower", CHARS_LOWER, "abcdefghijklmnopqrstuvwxyz"},
+    {"digits", CHARS_DIGITS, "0123456789"},
+    {"symbols", CHARS_SYMBOLS, "!@#$%^&*()_+-=[]{}|;:,.<>?"},
+    {"extended", CHARS_EXTENDED, "±§µ¶·¸¹º»¼½¾¿ÀÁÂÃÄÅÆÇÈÉÊËÌÍÎÏ"},
+};
+
+constexpr unsigned CHARS_DEFAULT = CHARS_UPPER | CHARS_LOWER | CHARS_DIGITS | CHARS_SYMBOLS;
+
+/**
+ * @brief Class flag for a name ("upper", "lower", "digits", "symbols", "extended"); throws on anything else
+ */
+inline CharClass char_class(std::string_view name) {
+    for (const auto &info : CHAR_CLASSES) {
+        if (info.name == name) return info.flag;
+    }
+    throw std::runtime_error("Unknown character class: " + std::string(name));
+}
+
+/**
+ * @brief Uniform integers from libsodium's CSPRNG, drawn a buffer at a time
+ *
+ * randombytes_uniform() rejects the biased top of a 32-bit draw; this does
+ * the same over one byte (bounds up to 256) or two (up to 65536), so a
+ * 20-character password costs one randombytes_buf() call instead of 20.
+ * Larger bounds go to randombytes_uniform().
+ */
+class RandomSampler {
+private:
+    unsigned char buffer[256];
+    size_t used = sizeof(buffer);
+
+    unsigned next_byte() {
+        if (used == sizeof(buffer)) {
+            randombytes_buf(buffer, sizeof(buffer));
+            used = 0;
+        }
+        return buffer[used++];
+    }
+
+public:
+    RandomSampler() = default;
+    RandomSampler(const RandomSampler &) = delete;
+    RandomSampler &operator=(const RandomSampler &) = delete;
+    ~RandomSampler() { sodium_memzero(buffer, sizeof(buffer)); }
+
+    // Uniform in [0, bound); bound must be non-zero
+    uint32_t uniform(uint32_t bound) {
+        if (bound <= 256) {
+            unsigned limit = 256 - 256 % bound;
+            for (;;) {
+                unsigned v = next_byte();
+                if (v < limit) return v % bound;
+            }
+        }
+        if (bound <= 65536) {
+            uint32_t limit = 65536 - 65536 % bound;
+            for (;;) {
+                uint32_t v = next_byte() << 8 | next_byte();
+                if (v < limit) return v % bound;
+            }
+        }
+        return randombytes_uniform(bound);
+    }
+};
+
+/**
+ * @brief The symbols of a set of character classes
+ */
+struct Alphabet {
+    std::vector<std::string_view> symbols; // one UTF-8 character each
+    std::vector<unsigned> class_of;        // flag of the class each symbol came from
+    unsigned classes = 0;
+    size_t max_symbol_bytes = 0;
+
+    explicit Alphabet(unsigned wanted) : classes(wanted) {
+        if (wanted == 0) throw std::runtime_error("Select at least one character class");
+        for (const auto &info : CHAR_CLASSES) {
+            if (!(wanted & info.flag)) continue;
+            std::string_view rest = info.symbols;
+            while (!rest.empty()) {
+                auto lead = static_cast<unsigned char>(rest[0]);
+                size_t len = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+                symbols.push_back(rest.substr(0, len));
+                class_of.push_back(info.flag);
+                max_symbol_bytes = std::max(max_symbol_bytes, len);
+                rest.remove_prefix(len);
+            }
+        }
+    }
+
+    // Longest password, in characters, that always fits GENERATED_MAX_BYTES
+    size_t max_length() const { return GENERATED_MAX_BYTES / max_symbol_bytes; }
+
+    double bits_per_symbol() const { return std::log2(static_cast<double>(symbols.size())); }
+};
+
+/**
+ * @brief A random password of `length` characters with every class present
+ *
+ * Whole passwords missing a class are discarded and redrawn, so the result
+ * is uniform over the passwords that pass; fixing one character per class
+ * in place would make those positions guessable.
+ */
+inline std::string generate_password(const Alphabet &alphabet, size_t length, RandomSampler &random) {
+    if (length < static_cast<size_t>(std::popcount(alphabet.classes))) {
+        throw std::runtime_error("Length is too short to include every character class");
+    }
+    if (length > alphabet.max_length()) {
+        throw std::runtime_error("Passwords are limited to " + std::to_string(alphabet.max_length()) +
+                                 " characters with these classes");
+    }
+
+    std::string out;
+    out.reserve(length * alphabet.max_symbol_bytes);
+    for (;;) {
+        out.clear();
+        unsigned seen = 0;
+        for (size_t i = 0; i < length; i++) {
+            uint32_t pick = random.uniform(static_cast<uint32_t>(alphabet.symbols.size()));
+            out += alphabet.symbols[pick];
+            seen |= alphabet.class_of[pick];
+        }
+        if (seen == alphabet.classes) return out;
+    }
+}
+
+/**
+ * @brief Longest passphrase, in words, that always fits GENERATED_MAX_BYTES
+ */
+inline size_t passphrase_max_words(std::string_view separator) {
+    return (GENERATED_MAX_BYTES + separator.size()) / (PASSPHRASE_WORD_MAX + separator.size());
+}
+
+/**
+ * @brief Words drawn uniformly from PASSPHRASE_WORDS, joined by a separator
+ * @param capitalize Upper-case the first letter of each word
+ */
+inline std::string generate_passphrase(size_t words, std::string_view separator, bool capitalize, RandomSampler &random) {
+    if (words == 0) throw std::runtime_error("A passphrase needs at least one word");
+    if (separator.size() > PASSPHRASE_MAX_SEPARATOR) throw std::runtime_error("Separator is too long");
+    if (words > passphrase_max_words(separator)) {
+        throw std::runtime_error("Passphrases are limited to " + std::to_string(passphrase_max_words(separator)) +
+                                 " words with this separator");
+    }
+
+    std::string out;
+    for (size_t i = 0; i < words; i++) {
+        if (i > 0) out += separator;
+        std::string_view word = PASSPHRASE_WORDS[random.uniform(PASSPHRASE_WORD_COUNT)];
+        out += word;
+        if (capitalize) {
+            char &first = out[out.size() - word.size()];
+            first = static_cast<char>(std::toupper(static_cast<unsigned char>(first)));
+        }
+    }
+    return out;
+}
+
+#endif // CRYPTO_PASSWORD_GENERATOR_HPP
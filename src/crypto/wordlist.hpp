@@ -0,0 +1,101 @@
+#ifndef CRYPTO_WORDLIST_HPP
+#define CRYPTO_WORDLIST_HPP
+
+#include <array>
+#include <string_view>
+
+// Passphrase words: 1024 (10 bits each), distinct, lowercase, 3-6 letters
+constexpr size_t PASSPHRASE_WORD_COUNT = 1024;
+constexpr size_t PASSPHRASE_WORD_MAX = 6;
+
+constexpr std::array<std::string_view, PASSPHRASE_WORD_COUNT> PASSPHRASE_WORDS = {
+    "able", "acid", "acorn", "acre", "actor", "adapt", "admit", "adobe", "adult", "agent", "agile", "aging",
+    "agree", "ahead", "aide", "aim", "air", "alarm", "album", "alert", "alien", "alley", "allow", "ally",
+    "almond", "alone", "alpha", "alpine", "amber", "ample", "amuse", "anchor", "angle", "angry", "ankle",
+    "annex", "answer", "antler", "anvil", "apple", "april", "apron", "arbor", "arcade", "arch", "arctic",
+    "arena", "argue", "arise", "armor", "aroma", "arrow", "artist", "ascend", "ashore", "aspen", "asset",
+    "atlas", "atom", "atrium", "attic", "audio", "august", "aunt", "autumn", "avenue", "avid", "awake", "award",
+    "axis", "bacon", "badge", "bagel", "baker", "ballad", "bamboo", "banana", "band", "banjo", "banner",
+    "barley", "barn", "barrel", "basil", "basin", "basket", "batch", "bath", "baton", "beach", "beacon", "beam",
+    "bean", "bear", "beaver", "beef", "beetle", "begin", "bell", "belt", "bench", "berry", "bike", "birch",
+    "bird", "bison", "blade", "blank", "blast", "blaze", "blend", "bless", "blimp", "blink", "bliss", "block",
+    "bloom", "blue", "blunt", "blush", "board", "boat", "bobcat", "body", "boil", "bold", "bolt", "bonus",
+    "book", "boost", "boot", "border", "bottle", "bounce", "bowl", "boxer", "brain", "brake", "branch", "brass",
+    "brave", "bread", "breeze", "brick", "bride", "bridge", "brief", "bright", "brim", "brisk", "broad",
+    "bronze", "brook", "broom", "brush", "bubble", "bucket", "buckle", "budget", "bugle", "build", "bulb",
+    "bundle", "bunny", "burst", "bush", "butter", "button", "buyer", "cabin", "cable", "cactus", "cadet",
+    "cake", "calm", "camel", "camera", "camp", "canal", "candle", "candy", "canoe", "canvas", "canyon", "cape",
+    "carbon", "card", "cargo", "carpet", "carrot", "cart", "carve", "case", "cashew", "castle", "casual",
+    "catch", "cattle", "cave", "cavern", "cedar", "celery", "cello", "cement", "census", "cereal", "chalk",
+    "champ", "change", "chant", "chapel", "charm", "chart", "chase", "cheek", "cheese", "cherry", "chess",
+    "chest", "chief", "child", "chili", "chin", "chip", "chorus", "chrome", "cider", "cinema", "circle",
+    "circus", "citrus", "city", "civic", "claim", "clam", "clap", "clay", "clean", "clerk", "click", "cliff",
+    "climb", "clinic", "clip", "cloak", "clock", "cloud", "clover", "clown", "club", "clue", "coach", "coast",
+    "cobalt", "cobra", "cobweb", "cocoa", "code", "coffee", "coil", "coin", "collar", "colony", "color",
+    "comet", "comic", "condor", "cone", "coral", "cord", "core", "corn", "corner", "cosmic", "cotton", "couch",
+    "cougar", "count", "cousin", "cover", "coyote", "crab", "cradle", "craft", "crane", "crater", "crayon",
+    "cream", "credit", "creek", "crew", "crisp", "crop", "crown", "crumb", "crust", "cube", "curb", "curl",
+    "curve", "cycle", "cymbal", "dairy", "daisy", "dance", "dancer", "dash", "date", "dawn", "deck", "deer",
+    "delta", "denim", "dental", "depot", "depth", "desert", "design", "desk", "detour", "dial", "diary",
+    "diesel", "digit", "dime", "diner", "dinner", "dipper", "direct", "disco", "dish", "ditch", "diver", "dock",
+    "doctor", "dollar", "domain", "donkey", "donut", "door", "dose", "dough", "dove", "dragon", "drama",
+    "drawer", "dream", "dress", "drift", "drill", "drive", "drum", "duck", "dune", "dusk", "dust", "eagle",
+    "early", "earth", "easel", "east", "easy", "echo", "edge", "eel", "effort", "eight", "elbow", "elder",
+    "elect", "elk", "elm", "ember", "emblem", "empire", "enamel", "energy", "engine", "enjoy", "entry", "envoy",
+    "epic", "equal", "erase", "errand", "essay", "estate", "ether", "event", "exact", "exit", "expert",
+    "fabric", "face", "fact", "falcon", "fame", "family", "fancy", "farm", "fast", "fate", "feast", "fence",
+    "fern", "ferry", "fever", "fiber", "fiddle", "field", "fiesta", "figure", "film", "final", "finch",
+    "finger", "fire", "firm", "fish", "flag", "flame", "flash", "flask", "fleet", "flint", "float", "flock",
+    "flood", "floor", "flour", "flower", "fluid", "flute", "foam", "focus", "fog", "folk", "forest", "forge",
+    "fork", "format", "fort", "fossil", "fox", "frame", "fresh", "friend", "frog", "frost", "fruit", "fudge",
+    "fuel", "galaxy", "gale", "gallon", "game", "garage", "garden", "garlic", "gate", "gauge", "gear", "gecko",
+    "gem", "genius", "giant", "gift", "ginger", "glad", "glass", "glide", "globe", "glove", "glow", "glue",
+    "goat", "gold", "golf", "gong", "goose", "gospel", "gown", "grace", "grain", "grape", "graph", "grass",
+    "gravel", "gravy", "great", "green", "grid", "grill", "grin", "grip", "grove", "guard", "guava", "guest",
+    "guide", "guitar", "gull", "gust", "habit", "hail", "hall", "halo", "hammer", "hand", "harbor", "harp",
+    "hat", "hawk", "hazel", "heart", "hedge", "helmet", "herb", "hero", "heron", "hill", "hinge", "hippo",
+    "hobby", "hockey", "honey", "hood", "hook", "hope", "horn", "horse", "hotel", "hound", "house", "hover",
+    "humble", "hunt", "husky", "hut", "ice", "icon", "idea", "igloo", "image", "inch", "index", "indigo", "ink",
+    "inlet", "input", "insect", "island", "ivory", "ivy", "jacket", "jade", "jaguar", "jam", "jar", "jazz",
+    "jelly", "jewel", "jigsaw", "jockey", "jog", "join", "joke", "jolly", "joy", "judge", "juice", "jumbo",
+    "jump", "jungle", "junior", "jury", "kayak", "keen", "kettle", "key", "kid", "kind", "king", "kiosk",
+    "kite", "kitten", "kiwi", "knee", "knife", "knot", "koala", "label", "lace", "ladder", "lady", "lagoon",
+    "lake", "lamb", "lamp", "lance", "land", "lane", "laptop", "large", "laser", "latch", "lava", "lawn",
+    "layer", "leaf", "lemon", "lens", "level", "lever", "lid", "light", "lilac", "lily", "lime", "linen",
+    "lion", "list", "llama", "lobby", "local", "lodge", "logic", "lotus", "lucky", "lunar", "lunch", "lynx",
+    "lyric", "macro", "maize", "mango", "manor", "maple", "march", "marsh", "mask", "mason", "mast", "match",
+    "medal", "melon", "menu", "mercy", "merit", "mesa", "metal", "metro", "mild", "mill", "mimic", "mind",
+    "mint", "mist", "mixer", "model", "modem", "molar", "monk", "month", "moon", "moose", "moss", "motel",
+    "moth", "motor", "mound", "mouse", "mud", "mule", "mural", "music", "myth", "nail", "navy", "nest", "net",
+    "night", "ninja", "noble", "north", "note", "novel", "nurse", "nut", "oak", "oasis", "oat", "ocean", "odor",
+    "offer", "olive", "omega", "onion", "onyx", "open", "opera", "orbit", "organ", "otter", "ounce", "oval",
+    "oven", "owl", "pace", "page", "paint", "palm", "panda", "panel", "paper", "park", "party", "pasta",
+    "patch", "path", "patio", "pause", "peach", "peak", "pear", "pearl", "pecan", "pedal", "perch", "pet",
+    "piano", "pier", "pig", "pilot", "pine", "pink", "pipe", "pitch", "pixel", "pizza", "plain", "plank",
+    "plant", "plate", "plaza", "plot", "plum", "plume", "plus", "poem", "poet", "polar", "pole", "polka",
+    "pond", "pony", "pool", "poppy", "porch", "port", "pouch", "prawn", "prism", "prize", "probe", "prose",
+    "proud", "prune", "pulse", "puma", "pump", "punch", "pupil", "puppy", "quail", "quake", "queen", "quest",
+    "quick", "quiet", "quilt", "quota", "radar", "radio", "raft", "rail", "rain", "rake", "ramp", "ranch",
+    "range", "rapid", "raven", "razor", "reef", "relay", "relic", "reply", "rhino", "rice", "rider", "ridge",
+    "ring", "river", "road", "robin", "robot", "rodeo", "roof", "room", "root", "rope", "rose", "rotor",
+    "round", "route", "royal", "ruby", "rug", "ruler", "rural", "rust", "saga", "sail", "salad", "salon",
+    "salsa", "salt", "sand", "satin", "sauce", "scale", "scarf", "scene", "scone", "scout", "scrap", "seal",
+    "seat", "seed", "shake", "shark", "shelf", "shell", "shift", "shine", "ship", "shirt", "shore", "short",
+    "shrub", "silk", "siren", "skate", "ski", "skill", "skirt", "sky", "slate", "sled", "slice", "slope",
+    "sloth", "smile", "smoke", "snack", "snail", "snake", "snow", "soap", "sock", "soda", "sofa", "solar",
+    "solid", "sonic", "soup", "south", "space", "spade", "spark", "spear", "spell", "spice", "spike", "spine",
+    "spoon", "sport", "spot", "squad", "squid", "staff", "stage", "stair", "stamp", "star", "steam", "steel",
+    "stem", "step", "stick", "stool", "stork", "storm", "story", "stove", "straw", "sugar", "suit", "sun",
+    "super", "surf", "swamp", "swan", "swift", "swing", "syrup", "table", "taco", "tail", "tango", "tank",
+    "tape", "taxi", "tea", "team", "tempo", "tent", "thorn", "tide", "tiger", "tile", "timer", "tiny", "toast",
+    "token", "tonic", "tool", "topaz", "torch", "total", "totem", "towel", "tower", "town", "toy", "track",
+    "trade", "trail", "train", "tram", "tray", "tree", "trend", "tribe", "trick", "trout", "truck", "trunk",
+    "tulip", "tuna", "tutor", "twig", "twin", "type", "ultra", "uncle", "union", "unit", "upper", "urban",
+    "usher", "valve", "vapor", "vase", "vault", "venue", "verse", "video", "view", "villa", "vine", "vinyl",
+    "visa", "visor", "vital", "vivid", "vocal", "voice", "vote", "wafer", "wagon", "wand", "warm", "wave",
+    "wax", "web", "wedge", "whale", "wheat", "wheel", "whisk", "wing", "wire", "wolf", "wood", "wool", "word",
+    "world", "worm", "yacht", "yak", "yard", "yarn", "yeast", "yoga", "young", "yummy", "zeal", "zebra", "zero",
+    "zinc", "zone", "zoo",
+};
+
+#endif // CRYPTO_WORDLIST_HPP
@@ -0,0 +1,421 @@
+#ifndef DISCOVERY_VAULT_INDEX_HPP
+#define DISCOVERY_VAULT_INDEX_HPP
+
+#include "../core/types.hpp"
+#include "../vault/header_cache.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Crawl limits: directories deeper than this below a root are not indexed
+constexpr int DISCOVERY_MAX_DEPTH = 12;
+constexpr unsigned DISCOVERY_MAX_THREADS = 8;
+constexpr int DISCOVERY_POLL_MS = 500;
+
+constexpr uint32_t DISCOVERY_WATCH_MASK =
+    IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+
+/**
+ * @brief Catalog record for a discovered vault file
+ */
+struct VaultInfo {
+    std::string path;
+    std::string name;
+    size_t entries;
+    time_t created;
+    time_t updated;
+};
+
+/**
+ * @brief Read the catalog fields from a vault file's header
+ * @return false if the file is not a readable vault
+ */
+inline bool read_vault_info(const std::string &path, VaultInfo &info) {
+    VaultHeader header;
+    if (!peek_header(path, header)) return false;
+
+    info.path = path;
+    info.name = std::string(header.name, strnlen(header.name, NAME_SIZE));
+    info.entries = header.entries;
+    info.created = header.created;
+    info.updated = header.updated;
+    return true;
+}
+
+/**
+ * @brief Background catalog of .shpd vault files under configured roots
+ *
+ * The initial crawl runs on a pool of workers, each owning a deque of
+ * directories: a worker pops from the back of its own deque and, when
+ * empty, steals from the front of another's, so one deep subtree keeps
+ * every thread busy. Every crawled directory gets an inotify watch; a
+ * watcher thread then keeps the catalog fresh as vaults are created,
+ * written, renamed or deleted. With no roots nothing is crawled or watched.
+ */
+class VaultIndex {
+private:
+    struct WorkItem {
+        std::string path;
+        int depth;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<WorkItem> items;
+    };
+
+    using DirectoryId = std::pair<dev_t, ino_t>;
+
+    struct Watch {
+        std::string path;
+        DirectoryId id;
+    };
+
+    struct Cataloged {
+        VaultInfo info;
+        // Full crawl that last saw the file; older ones are swept after a recrawl
+        uint64_t generation;
+    };
+
+    std::vector<std::string> roots;
+
+    mutable std::mutex catalog_mutex;
+    std::map<std::string, Cataloged> catalog;
+    uint64_t generation = 0;
+
+    std::mutex watch_mutex;
+    std::unordered_map<int, Watch> watches;
+    // Directories crawled and still watched; guards against bind mounts and
+    // overlapping roots, and keeps incremental crawls out of watched subtrees
+    std::set<DirectoryId> visited;
+
+    int inotify_fd = -1;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> crawling{false};
+    std::thread indexer;
+
+    static bool is_shpd(const char *name, size_t len) {
+        return len > 5 && std::memcmp(name + len - 5, ".shpd", 5) == 0;
+    }
+
+    static std::string join(const std::string &dir, const char *name) {
+        std::string path = dir;
+        if (path.empty() || path.back() != '/') path += '/';
+        return path + name;
+    }
+
+    void update_vault(const std::string &path) {
+        VaultInfo info;
+        bool found = read_vault_info(path, info);
+
+        std::lock_guard<std::mutex> lock(catalog_mutex);
+        if (found) {
+            catalog[path] = {std::move(info), generation};
+        } else {
+            catalog.erase(path);
+        }
+    }
+
+    void remove_subtree(const std::string &dir) {
+        std::string prefix = join(dir, "");
+        std::lock_guard<std::mutex> lock(catalog_mutex);
+        auto it = catalog.lower_bound(prefix);
+        while (it != catalog.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = catalog.erase(it);
+        }
+    }
+
+    // Claim a directory for crawling; false if already visited via another path
+    bool claim(int dirfd, const std::string &path) {
+        struct stat st;
+        if (fstat(dirfd, &st) != 0) return false;
+
+        DirectoryId id{st.st_dev, st.st_ino};
+        std::lock_guard<std::mutex> lock(watch_mutex);
+        if (!visited.insert(id).second) return false;
+
+        if (inotify_fd >= 0) {
+            int wd = inotify_add_watch(inotify_fd, path.c_str(), DISCOVERY_WATCH_MASK);
+            if (wd >= 0) watches[wd] = {path, id};
+        }
+        return true;
+    }
+
+    // Index one directory; subdirectories are handed to `push`
+    template <typename Push>
+    void scan_directory(const WorkItem &item, Push &&push) {
+        int dirfd = open(item.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirfd < 0) return;
+        if (!claim(dirfd, item.path)) {
+            close(dirfd);
+            return;
+        }
+
+        DIR *dir = fdopendir(dirfd);
+        if (!dir) {
+            close(dirfd);
+            return;
+        }
+
+        struct dirent *entry;
+        while (!stopping && (entry = readdir(dir)) != nullptr) {
+            const char *name = entry->d_name;
+            if (name[0] == '.') continue;
+
+            unsigned char type = entry->d_type;
+            if (type == DT_UNKNOWN) {
+                struct stat st;
+                if (fstatat(dirfd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) continue;
+                type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : DT_UNKNOWN;
+            }
+
+            // Symlinked directories are not followed, so the crawl cannot loop
+            if (type == DT_DIR) {
+                if (item.depth < DISCOVERY_MAX_DEPTH) {
+                    push(WorkItem{join(item.path, name), item.depth + 1});
+                }
+            } else if ((type == DT_REG || type == DT_LNK) && is_shpd(name, std::strlen(name))) {
+                update_vault(join(item.path, name));
+            }
+        }
+        closedir(dir);
+    }
+
+    // Forget a moved or deleted subtree, so it is crawled again if it reappears
+    void unwatch_subtree(const std::string &dir) {
+        std::string prefix = join(dir, "");
+        std::lock_guard<std::mutex> lock(watch_mutex);
+        for (auto it = watches.begin(); it != watches.end();) {
+            const std::string &path = it->second.path;
+            if (path == dir || path.compare(0, prefix.size(), prefix) == 0) {
+                inotify_rm_watch(inotify_fd, it->first);
+                visited.erase(it->second.id);
+                it = watches.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Work-stealing parallel crawl of the given directories; directories
+    // already visited (and watched) are skipped
+    void crawl(const std::vector<std::string> &starts) {
+        unsigned workers = std::clamp(std::thread::hardware_concurrency(), 2u, DISCOVERY_MAX_THREADS);
+        std::vector<WorkQueue> queues(workers);
+        std::atomic<size_t> pending{starts.size()};
+
+        for (size_t i = 0; i < starts.size(); i++) {
+            queues[i % workers].items.push_back({starts[i], 0});
+        }
+
+        auto worker = [&](unsigned self) {
+            while (pending > 0 && !stopping) {
+                WorkItem item;
+                bool found = false;
+
+                {
+                    std::lock_guard<std::mutex> lock(queues[self].mutex);
+                    if (!queues[self].items.empty()) {
+                        item = std::move(queues[self].items.back());
+                        queues[self].items.pop_back();
+                        found = true;
+                    }
+                }
+
+                for (unsigned k = 1; !found && k < workers; k++) {
+                    WorkQueue &victim = queues[(self + k) % workers];
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    if (!victim.items.empty()) {
+                        item = std::move(victim.items.front());
+                        victim.items.pop_front();
+                        found = true;
+                    }
+                }
+
+                if (!found) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                scan_directory(item, [&](WorkItem child) {
+                    pending++;
+                    std::lock_guard<std::mutex> lock(queues[self].mutex);
+                    queues[self].items.push_back(std::move(child));
+                });
+                pending--;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 1; i < workers; i++) {
+            threads.emplace_back(worker, i);
+        }
+        worker(0);
+        for (auto &t : threads) t.join();
+    }
+
+    /**
+     * @brief Crawl every root from scratch, then drop what it did not see
+     * Mark and sweep: catalog entries and watches left over from before
+     * (vaults and directories deleted while events were lost) are removed.
+     */
+    void full_crawl() {
+        std::unordered_map<int, Watch> previous;
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            previous.swap(watches);
+            visited.clear();
+        }
+        {
+            std::lock_guard<std::mutex> lock(catalog_mutex);
+            generation++;
+        }
+
+        crawl(roots);
+        if (stopping) return;
+
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            for (const auto &[wd, watch] : previous) {
+                if (!watches.count(wd)) inotify_rm_watch(inotify_fd, wd);
+            }
+        }
+        std::lock_guard<std::mutex> lock(catalog_mutex);
+        std::erase_if(catalog, [&](const auto &item) { return item.second.generation != generation; });
+    }
+
+    void handle_event(const struct inotify_event *event) {
+        // Events were dropped; only a full recrawl can resynchronise
+        if (event->mask & IN_Q_OVERFLOW) {
+            full_crawl();
+            return;
+        }
+
+        std::string dir;
+        {
+            std::lock_guard<std::mutex> lock(watch_mutex);
+            auto it = watches.find(event->wd);
+            if (it == watches.end()) return;
+            dir = it->second.path;
+            if (event->mask & (IN_IGNORED | IN_DELETE_SELF)) {
+                visited.erase(it->second.id);
+                watches.erase(it);
+            }
+        }
+
+        if (event->mask & IN_DELETE_SELF) {
+            remove_subtree(dir);
+            return;
+        }
+        if (event->len == 0 || event->name[0] == '.') return;
+
+        std::string path = join(dir, event->name);
+        if (event->mask & IN_ISDIR) {
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                crawl({path});
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                remove_subtree(path);
+                unwatch_subtree(path);
+            }
+        } else if (is_shpd(event->name, std::strlen(event->name))) {
+            update_vault(path);
+        }
+    }
+
+    void watch_loop() {
+        alignas(struct inotify_event) char buffer[64 * 1024];
+        struct pollfd pfd{inotify_fd, POLLIN, 0};
+
+        while (!stopping) {
+            if (poll(&pfd, 1, DISCOVERY_POLL_MS) <= 0) continue;
+
+            ssize_t len = read(inotify_fd, buffer, sizeof(buffer));
+            if (len <= 0) continue;
+
+            for (char *p = buffer; p < buffer + len;) {
+                auto *event = reinterpret_cast<struct inotify_event *>(p);
+                handle_event(event);
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+
+public:
+    explicit VaultIndex(std::vector<std::string> search_roots) : roots(std::move(search_roots)) {}
+
+    VaultIndex(const VaultIndex &) = delete;
+    VaultIndex &operator=(const VaultIndex &) = delete;
+
+    ~VaultIndex() { stop(); }
+
+    /**
+     * @brief Crawl the roots and keep watching them on a background thread
+     * Does nothing without roots: discovery is opt-in.
+     */
+    void start() {
+        if (indexer.joinable() || roots.empty()) return;
+
+        inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd < 0) {
+            std::cerr << "Vault discovery: inotify unavailable, catalog will not auto-refresh" << std::endl;
+        }
+
+        crawling = true;
+        indexer = std::thread([this] {
+            full_crawl();
+            crawling = false;
+            if (inotify_fd >= 0) watch_loop();
+        });
+    }
+
+    void stop() {
+        stopping = true;
+        if (indexer.joinable()) indexer.join();
+        if (inotify_fd >= 0) {
+            close(inotify_fd);
+            inotify_fd = -1;
+        }
+    }
+
+    bool is_crawling() const { return crawling; }
+    bool is_enabled() const { return !roots.empty(); }
+
+    std::vector<VaultInfo> list() const {
+        std::lock_guard<std::mutex> lock(catalog_mutex);
+        std::vector<VaultInfo> out;
+        out.reserve(catalog.size());
+        for (const auto &[path, cataloged] : catalog) {
+            out.push_back(cataloged.info);
+        }
+        return out;
+    }
+};
+
+/**
+ * @brief Roots to index: SHPD_VAULT_ROOTS (colon-separated), or none
+ * Crawling all of $HOME would put an inotify watch on every directory in
+ * it and run into max_user_watches, so discovery only runs when asked.
+ */
+inline std::vector<std::string> discovery_roots() {
+    std::vector<std::string> roots;
+    const char *configured = getenv("SHPD_VAULT_ROOTS");
+    if (!configured) return roots;
+
+    std::istringstream list(configured);
+    std::string root;
+    while (std::getline(list, root, ':')) {
+        if (!root.empty()) roots.push_back(root);
+    }
+    return roots;
+}
+
+#endif // DISCOVERY_VAULT_INDEX_HPP
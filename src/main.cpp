@@ -1,19 +1,46 @@
 #include <iostream>
 #include "api/handlers.hpp"
+#include "cli/export_command.hpp"
 
 using namespace httplib;
 using json = nlohmann::json;
 
-int main() {
+int main(int argc, char **argv) {
     if (sodium_init() < 0) {
         std::cerr << "Failed to initialize libsodium" << std::endl;
         return 1;
     }
 
+    // One-shot commands instead of the server
+    if (argc > 1 && std::string(argv[1]) == "export") return run_export_command(argc, argv);
+    if (argc > 1 && std::string(argv[1]) == "decrypt-backup") return run_decrypt_backup_command(argc, argv);
+
+    // kill -USR1 <pid> writes the trace ring buffers to a file; must run
+    // before any other thread exists
+    start_trace_signal_listener();
+
     // Create server instance on port 8080
     Server svr;
     ApiHandlers handlers;
 
+    // Every open /api/events stream holds a worker thread for its lifetime;
+    // handle_events stops at EVENT_MAX_STREAMS to leave the rest for other routes
+    svr.new_task_queue = [] { return new ThreadPool(SERVER_THREAD_COUNT); };
+
+    // Compressed bodies are often a single small write; don't let Nagle hold them
+    svr.set_tcp_nodelay(true);
+
+    // Per-route latency, status metrics and request spans; runs on the worker thread once
+    // the response is built, before it is written
+    svr.set_post_routing_handler([](const Request &req, Response &res) {
+        auto end = std::chrono::steady_clock::now();
+        size_t route = metric_route_index(req.matched_route);
+        metrics().record_request(route, res.status, end - req.start_time_);
+        if (tracer().is_enabled()) {
+            tracer().record(METRIC_ROUTES[route].data(), req.start_time_, end);
+        }
+        });
+
     // Serve static files from webui directory
     svr.set_mount_point("/", "./webui");
 
@@ -22,6 +49,10 @@ int main() {
         handlers.handle_browse(req, res);
         });
 
+    svr.Get("/api/vaults", [&handlers](const Request &req, Response &res) {
+        handlers.handle_list_vaults(req, res);
+        });
+
     svr.Post("/api/vault/create", [&handlers](const Request &req, Response &res) {
         handlers.handle_create_vault(req, res);
         });
@@ -58,10 +89,67 @@ int main() {
         handlers.handle_modify_entry(req, res);
         });
 
+    svr.Get("/api/entries/filter", [&handlers](const Request &req, Response &res) {
+        handlers.handle_filter_entries(req, res);
+        });
+
+    svr.Get("/api/entries/page", [&handlers](const Request &req, Response &res) {
+        handlers.handle_page_entries(req, res);
+        });
+
+    svr.Get("/api/entries/groups", [&handlers](const Request &req, Response &res) {
+        handlers.handle_entry_groups(req, res);
+        });
+
+    svr.Get("/api/audit/reuse", [&handlers](const Request &req, Response &res) {
+        handlers.handle_audit_reuse(req, res);
+        });
+
+    svr.Get("/api/audit/breached", [&handlers](const Request &req, Response &res) {
+        handlers.handle_audit_breached(req, res);
+        });
+
+    svr.Post("/api/generate", [&handlers](const Request &req, Response &res) {
+        handlers.handle_generate(req, res);
+        });
+
+    svr.Get("/api/entries/history", [&handlers](const Request &req, Response &res) {
+        handlers.handle_entry_history(req, res);
+        });
+
+    svr.Post("/api/entries/rollback", [&handlers](const Request &req, Response &res) {
+        handlers.handle_rollback_entry(req, res);
+        });
+
+    svr.Post("/api/entries/import",
+             [&handlers](const Request &req, Response &res, const ContentReader &content_reader) {
+        handlers.handle_import_entries(req, res, content_reader);
+        });
+
+    svr.Get("/api/vault/export", [&handlers](const Request &req, Response &res) {
+        handlers.handle_export(req, res);
+        });
+
+    svr.Post("/api/vault/snapshot", [&handlers](const Request &req, Response &res) {
+        handlers.handle_snapshot(req, res);
+        });
+
+    svr.Get("/api/events", [&handlers](const Request &req, Response &res) {
+        handlers.handle_events(req, res);
+        });
+
     svr.Get("/api/vault/status", [&handlers](const Request &req, Response &res) {
         handlers.handle_vault_status(req, res);
         });
 
+    svr.Get("/metrics", [&handlers](const Request &req, Response &res) {
+        handlers.handle_metrics(req, res);
+        });
+
+    svr.Get("/api/admin/trace", [&handlers](const Request &req, Response &res) {
+        handlers.handle_trace(req, res);
+        });
+
     // Handle root path to serve index.html
     svr.Get("/", [](const Request &, Response &res) {
         std::ifstream file("./webui/index.html");
@@ -77,6 +165,10 @@ int main() {
 
     // Error handler
     svr.set_error_handler([](const Request &req, Response &res) {
+        // Handlers that already explain the error (e.g. 429) keep their body
+        if (!res.body.empty()) {
+            return;
+        }
         json error_response = {
             {"success", false},
             {"error", "Error: " + std::to_string(res.status)},
@@ -85,6 +177,10 @@ int main() {
         res.set_content(error_response.dump(), "application/json");
         });
 
+    if (!handlers.start_discovery()) {
+        std::cout << "Vault discovery is off; set SHPD_VAULT_ROOTS to index vault files" << std::endl;
+    }
+
     std::cout << "Starting Password Manager server on port 8080..." << std::endl;
     std::cout << "Open your browser and go to http://localhost:8080 to access the UI" << std::endl;
 
@@ -0,0 +1,309 @@
+#ifndef METRICS_METRICS_HPP
+#define METRICS_METRICS_HPP
+
+#include "../core/types.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+// Log-linear latency buckets: 2^HISTOGRAM_SUB_BITS buckets per power of two
+// of nanoseconds, from 2^HISTOGRAM_MIN_EXP ns (~1us) up to 2^HISTOGRAM_MAX_EXP
+// ns (~69s). Relative error per bucket is at most 25%.
+constexpr int HISTOGRAM_MIN_EXP = 10;
+constexpr int HISTOGRAM_MAX_EXP = 36;
+constexpr int HISTOGRAM_SUB_BITS = 2;
+// First bucket holds everything under 2^MIN_EXP, last one everything past 2^MAX_EXP
+constexpr size_t HISTOGRAM_BUCKETS = 2 + (static_cast<size_t>(HISTOGRAM_MAX_EXP - HISTOGRAM_MIN_EXP) << HISTOGRAM_SUB_BITS);
+
+/**
+ * @brief Timed operations outside the HTTP layer
+ */
+enum class Timer : size_t { KdfHash, KdfDerive, KdfVerify, EntryEncrypt, EntryDecrypt, VaultFlush, Count };
+
+/**
+ * @brief Monotonic byte/event counters
+ */
+enum class Counter : size_t { VaultReadBytes, VaultWriteBytes, AuthRejected, Count };
+
+struct MetricName {
+    const char *family;
+    const char *help;
+    const char *labels; // pre-rendered label set, may be empty
+};
+
+constexpr std::array<MetricName, static_cast<size_t>(Timer::Count)> TIMER_NAMES = {{
+    {"shpd_kdf_duration_seconds", "Argon2id time per call", "op=\"hash\""},
+    {"shpd_kdf_duration_seconds", "Argon2id time per call", "op=\"derive\""},
+    {"shpd_kdf_duration_seconds", "Argon2id time per call", "op=\"verify\""},
+    {"shpd_entry_crypto_duration_seconds", "Per-entry AEAD time", "op=\"encrypt\""},
+    {"shpd_entry_crypto_duration_seconds", "Per-entry AEAD time", "op=\"decrypt\""},
+    {"shpd_vault_flush_duration_seconds", "Vault file stream flush time (write(2), no fsync)", ""},
+}};
+
+constexpr std::array<MetricName, static_cast<size_t>(Counter::Count)> COUNTER_NAMES = {{
+    {"shpd_vault_io_bytes_total", "Bytes read from and written to vault files", "direction=\"read\""},
+    {"shpd_vault_io_bytes_total", "Bytes read from and written to vault files", "direction=\"write\""},
+    {"shpd_auth_rate_limited_total", "Password attempts rejected before any KDF work", ""},
+}};
+
+// Route patterns as registered in main.cpp; anything else (static files,
+// 404s) is counted under the last slot so label cardinality stays fixed
+constexpr std::array<std::string_view, 28> METRIC_ROUTES = {
+    "/api/browse", "/api/vaults", "/api/vault/create", "/api/vault/open",
+    "/api/vault/authenticate", "/api/vault/close", "/api/vault/status", "/api/entries/load",
+    "/api/entries", "/api/entries/add", "/api/entries/delete", "/api/entries/edit",
+    "/api/entries/import", "/api/entries/filter", "/api/entries/groups", "/api/entries/page",
+    "/api/entries/history", "/api/entries/rollback", "/api/vault/export", "/api/vault/snapshot",
+    "/api/audit/reuse", "/api/audit/breached", "/api/generate", "/api/events",
+    "/metrics", "/api/admin/trace", "/", "other",
+};
+
+/**
+ * @brief Histogram bucket holding a duration in nanoseconds
+ */
+constexpr size_t histogram_bucket(uint64_t ns) {
+    if (ns < (uint64_t{1} << HISTOGRAM_MIN_EXP)) return 0;
+    int msb = std::bit_width(ns) - 1;
+    if (msb >= HISTOGRAM_MAX_EXP) return HISTOGRAM_BUCKETS - 1;
+    size_t sub = (ns >> (msb - HISTOGRAM_SUB_BITS)) & ((size_t{1} << HISTOGRAM_SUB_BITS) - 1);
+    return 1 + (static_cast<size_t>(msb - HISTOGRAM_MIN_EXP) << HISTOGRAM_SUB_BITS) + sub;
+}
+
+/**
+ * @brief Exclusive upper bound of a bucket in nanoseconds (not defined for the last)
+ */
+constexpr uint64_t histogram_bucket_limit(size_t bucket) {
+    if (bucket == 0) return uint64_t{1} << HISTOGRAM_MIN_EXP;
+    size_t octave = (bucket - 1) >> HISTOGRAM_SUB_BITS;
+    size_t sub = (bucket - 1) & ((size_t{1} << HISTOGRAM_SUB_BITS) - 1);
+    int shift = HISTOGRAM_MIN_EXP + static_cast<int>(octave) - HISTOGRAM_SUB_BITS;
+    return ((size_t{1} << HISTOGRAM_SUB_BITS) + sub + 1) << shift;
+}
+
+inline size_t metric_route_index(std::string_view route) {
+    for (size_t i = 0; i + 1 < METRIC_ROUTES.size(); i++) {
+        if (METRIC_ROUTES[i] == route) return i;
+    }
+    return METRIC_ROUTES.size() - 1;
+}
+
+/**
+ * @brief Process-wide metrics with one shard per recording thread
+ *
+ * Every shard has a single writer, so recording is a relaxed load and store
+ * on thread-local cache lines: no locked instructions and no sharing between
+ * threads. Scrapes sum all shards with relaxed loads; a scrape racing a
+ * writer may miss that one sample, never tear it. A thread's shard goes back
+ * to a free list when the thread exits and is reused with its totals intact.
+ */
+class Metrics {
+private:
+    struct Histogram {
+        std::atomic<uint64_t> buckets[HISTOGRAM_BUCKETS]{};
+        std::atomic<uint64_t> sum_ns{0};
+
+        void record(uint64_t ns) {
+            auto &bucket = buckets[histogram_bucket(ns)];
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            sum_ns.store(sum_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        }
+    };
+
+    struct alignas(64) Shard {
+        Histogram timers[static_cast<size_t>(Timer::Count)];
+        Histogram routes[METRIC_ROUTES.size()];
+        // Responses per route by status class 1xx..5xx
+        std::atomic<uint64_t> statuses[METRIC_ROUTES.size()][5]{};
+        std::atomic<uint64_t> counters[static_cast<size_t>(Counter::Count)]{};
+    };
+
+    struct Totals {
+        std::array<uint64_t, HISTOGRAM_BUCKETS> buckets{};
+        uint64_t sum_ns = 0;
+    };
+
+    struct ShardLease {
+        Metrics *owner = nullptr;
+        Shard *shard = nullptr;
+        ~ShardLease() {
+            if (owner) owner->release(shard);
+        }
+    };
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<Shard *> free_shards;
+
+    Shard &local() {
+        thread_local ShardLease lease;
+        if (!lease.shard) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!free_shards.empty()) {
+                lease.shard = free_shards.back();
+                free_shards.pop_back();
+            } else {
+                shards.push_back(std::make_unique<Shard>());
+                lease.shard = shards.back().get();
+            }
+            lease.owner = this;
+        }
+        return *lease.shard;
+    }
+
+    void release(Shard *shard) {
+        std::lock_guard<std::mutex> lock(mutex);
+        free_shards.push_back(shard);
+    }
+
+    static void bump(std::atomic<uint64_t> &value, uint64_t n) {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static void accumulate(Totals &totals, const Histogram &histogram) {
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            totals.buckets[i] += histogram.buckets[i].load(std::memory_order_relaxed);
+        }
+        totals.sum_ns += histogram.sum_ns.load(std::memory_order_relaxed);
+    }
+
+    static void write_header(std::string &out, const char *family, const char *help, const char *type) {
+        out += "# HELP ";
+        out += family;
+        out += ' ';
+        out += help;
+        out += "\n# TYPE ";
+        out += family;
+        out += ' ';
+        out += type;
+        out += '\n';
+    }
+
+    static void write_histogram(std::string &out, const char *family, const std::string &labels,
+                                const Totals &totals) {
+        char line[256];
+        std::string sep = labels.empty() ? "" : ",";
+        uint64_t cumulative = 0;
+
+        for (size_t i = 0; i + 1 < HISTOGRAM_BUCKETS; i++) {
+            cumulative += totals.buckets[i];
+            std::snprintf(line, sizeof(line), "%s_bucket{%s%sle=\"%.9g\"} %llu\n", family, labels.c_str(),
+                          sep.c_str(), histogram_bucket_limit(i) / 1e9, static_cast<unsigned long long>(cumulative));
+            out += line;
+        }
+        cumulative += totals.buckets[HISTOGRAM_BUCKETS - 1];
+
+        std::string braces = labels.empty() ? "" : "{" + labels + "}";
+        std::snprintf(line, sizeof(line), "%s_bucket{%s%sle=\"+Inf\"} %llu\n%s_sum%s %.9g\n%s_count%s %llu\n",
+                      family, labels.c_str(), sep.c_str(), static_cast<unsigned long long>(cumulative), family,
+                      braces.c_str(), totals.sum_ns / 1e9, family, braces.c_str(),
+                      static_cast<unsigned long long>(cumulative));
+        out += line;
+    }
+
+public:
+    void record(Timer timer, std::chrono::nanoseconds elapsed) {
+        local().timers[static_cast<size_t>(timer)].record(static_cast<uint64_t>(elapsed.count()));
+    }
+
+    void add(Counter counter, uint64_t n) { bump(local().counters[static_cast<size_t>(counter)], n); }
+
+    void record_request(size_t route, int status, std::chrono::nanoseconds elapsed) {
+        Shard &shard = local();
+        shard.routes[route].record(static_cast<uint64_t>(elapsed.count()));
+        size_t status_class = static_cast<size_t>(std::clamp(status / 100, 1, 5) - 1);
+        bump(shard.statuses[route][status_class], 1);
+    }
+
+    /**
+     * @brief Render every metric in Prometheus text exposition format
+     */
+    std::string render() const {
+        std::vector<Totals> timers(static_cast<size_t>(Timer::Count));
+        std::vector<Totals> routes(METRIC_ROUTES.size());
+        std::vector<std::array<uint64_t, 5>> statuses(METRIC_ROUTES.size());
+        std::array<uint64_t, static_cast<size_t>(Counter::Count)> counters{};
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto &shard : shards) {
+                for (size_t t = 0; t < timers.size(); t++) accumulate(timers[t], shard->timers[t]);
+                for (size_t r = 0; r < routes.size(); r++) {
+                    accumulate(routes[r], shard->routes[r]);
+                    for (size_t c = 0; c < 5; c++) {
+                        statuses[r][c] += shard->statuses[r][c].load(std::memory_order_relaxed);
+                    }
+                }
+                for (size_t c = 0; c < counters.size(); c++) {
+                    counters[c] += shard->counters[c].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::string out;
+        out.reserve(64 * 1024);
+
+        write_header(out, "shpd_http_request_duration_seconds",
+                     "Time from request start until the response is ready to send", "histogram");
+        for (size_t r = 0; r < routes.size(); r++) {
+            write_histogram(out, "shpd_http_request_duration_seconds",
+                            "route=\"" + std::string(METRIC_ROUTES[r]) + "\"", routes[r]);
+        }
+
+        write_header(out, "shpd_http_responses_total", "Responses by route and status class", "counter");
+        for (size_t r = 0; r < routes.size(); r++) {
+            for (size_t c = 0; c < 5; c++) {
+                if (statuses[r][c] == 0) continue;
+                out += "shpd_http_responses_total{route=\"" + std::string(METRIC_ROUTES[r]) + "\",code=\"" +
+                       std::to_string(c + 1) + "xx\"} " + std::to_string(statuses[r][c]) + "\n";
+            }
+        }
+
+        const char *last_family = "";
+        for (size_t t = 0; t < timers.size(); t++) {
+            if (std::strcmp(last_family, TIMER_NAMES[t].family) != 0) {
+                write_header(out, TIMER_NAMES[t].family, TIMER_NAMES[t].help, "histogram");
+                last_family = TIMER_NAMES[t].family;
+            }
+            write_histogram(out, TIMER_NAMES[t].family, TIMER_NAMES[t].labels, timers[t]);
+        }
+
+        last_family = "";
+        for (size_t c = 0; c < counters.size(); c++) {
+            if (std::strcmp(last_family, COUNTER_NAMES[c].family) != 0) {
+                write_header(out, COUNTER_NAMES[c].family, COUNTER_NAMES[c].help, "counter");
+                last_family = COUNTER_NAMES[c].family;
+            }
+            std::string labels = COUNTER_NAMES[c].labels;
+            out += std::string(COUNTER_NAMES[c].family) + (labels.empty() ? "" : "{" + labels + "}") + " " +
+                   std::to_string(counters[c]) + "\n";
+        }
+        return out;
+    }
+};
+
+inline Metrics &metrics() {
+    static Metrics instance;
+    return instance;
+}
+
+/**
+ * @brief Records the lifetime of a scope into a Timer histogram
+ */
+class ScopedTimer {
+private:
+    Timer timer;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(Timer t) : timer(t), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { metrics().record(timer, std::chrono::steady_clock::now() - start); }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+};
+
+#endif // METRICS_METRICS_HPP
@@ -0,0 +1,253 @@
+#ifndef METRICS_TRACE_HPP
+#define METRICS_TRACE_HPP
+
+#include "metrics.hpp"
+#include "../lib/json.hpp"
+#include <csignal>
+#include <thread>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+// Completed spans kept per thread; older spans are overwritten
+constexpr size_t TRACE_RING_CAPACITY = 1024;
+
+/**
+ * @brief Per-thread rings of completed spans, dumpable as Chrome trace JSON
+ *
+ * Each thread writes only its own ring. Slots are guarded by a sequence
+ * number (odd while being written), so a dump running concurrently skips
+ * a slot that is mid-update instead of locking out the writer. Rings of
+ * exited threads go back to a free list and keep their history.
+ * Set SHPD_TRACE=0 to turn recording off.
+ */
+class Tracer {
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<const char *> name{nullptr};
+        std::atomic<uint64_t> start_ns{0};
+        std::atomic<uint64_t> duration_ns{0};
+        std::atomic<uint32_t> tid{0};
+    };
+
+    struct Ring {
+        std::atomic<uint64_t> head{0};
+        uint32_t tid = 0;
+        Slot slots[TRACE_RING_CAPACITY];
+    };
+
+    struct RingLease {
+        Tracer *owner = nullptr;
+        Ring *ring = nullptr;
+        ~RingLease() {
+            if (owner) owner->release(ring);
+        }
+    };
+
+    struct Event {
+        const char *name;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+        uint32_t tid;
+    };
+
+    std::atomic<bool> enabled;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::vector<Ring *> free_rings;
+
+    Ring &local() {
+        thread_local RingLease lease;
+        if (!lease.ring) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!free_rings.empty()) {
+                lease.ring = free_rings.back();
+                free_rings.pop_back();
+            } else {
+                rings.push_back(std::make_unique<Ring>());
+                lease.ring = rings.back().get();
+            }
+            lease.ring->tid = static_cast<uint32_t>(syscall(SYS_gettid));
+            lease.owner = this;
+        }
+        return *lease.ring;
+    }
+
+    void release(Ring *ring) {
+        std::lock_guard<std::mutex> lock(mutex);
+        free_rings.push_back(ring);
+    }
+
+    static uint64_t to_ns(std::chrono::steady_clock::time_point t) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+    }
+
+    // Copy out the spans of one ring that were not being rewritten
+    static void collect(const Ring &ring, std::vector<Event> &out) {
+        uint64_t head = ring.head.load(std::memory_order_acquire);
+        uint64_t first = head > TRACE_RING_CAPACITY ? head - TRACE_RING_CAPACITY : 0;
+
+        for (uint64_t pos = first; pos < head; pos++) {
+            const Slot &slot = ring.slots[pos % TRACE_RING_CAPACITY];
+            uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != 2 * pos + 2) continue;
+
+            Event event{slot.name.load(std::memory_order_relaxed), slot.start_ns.load(std::memory_order_relaxed),
+                        slot.duration_ns.load(std::memory_order_relaxed), slot.tid.load(std::memory_order_relaxed)};
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == seq) {
+                out.push_back(event);
+            }
+        }
+    }
+
+public:
+    Tracer() {
+        const char *setting = getenv("SHPD_TRACE");
+        enabled = !(setting && std::strcmp(setting, "0") == 0);
+    }
+
+    bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+    void set_enabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+
+    /**
+     * @brief Append a completed span to the calling thread's ring
+     * @param name Must outlive the tracer (string literal or static table entry)
+     */
+    void record(const char *name, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end) {
+        Ring &ring = local();
+        uint64_t pos = ring.head.load(std::memory_order_relaxed);
+        Slot &slot = ring.slots[pos % TRACE_RING_CAPACITY];
+
+        slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start_ns.store(to_ns(start), std::memory_order_relaxed);
+        slot.duration_ns.store(to_ns(end) - to_ns(start), std::memory_order_relaxed);
+        slot.tid.store(ring.tid, std::memory_order_relaxed);
+        slot.seq.store(2 * pos + 2, std::memory_order_release);
+        ring.head.store(pos + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Every retained span as Chrome trace-event JSON (chrome://tracing, Perfetto)
+     */
+    std::string render_chrome_trace() const {
+        std::vector<Event> events;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto &ring : rings) collect(*ring, events);
+        }
+        std::sort(events.begin(), events.end(),
+                  [](const Event &a, const Event &b) { return a.start_ns < b.start_ns; });
+
+        json trace_events = json::array();
+        int pid = getpid();
+        for (const auto &event : events) {
+            trace_events.push_back({{"name", event.name},
+                                    {"cat", "shpd"},
+                                    {"ph", "X"},
+                                    {"ts", event.start_ns / 1000.0},
+                                    {"dur", event.duration_ns / 1000.0},
+                                    {"pid", pid},
+                                    {"tid", event.tid}});
+        }
+
+        json trace;
+        trace["traceEvents"] = std::move(trace_events);
+        trace["displayTimeUnit"] = "ms";
+        return trace.dump();
+    }
+};
+
+inline Tracer &tracer() {
+    static Tracer instance;
+    return instance;
+}
+
+/**
+ * @brief Scope recorded as a trace span and, optionally, into a metrics Timer
+ *
+ * Both sinks share one pair of clock reads; with tracing off and no Timer
+ * the span costs a relaxed load.
+ */
+class TraceSpan {
+private:
+    const char *name;
+    Timer timer = Timer::Count;
+    bool traced;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit TraceSpan(const char *span_name) : name(span_name), traced(tracer().is_enabled()) {
+        if (traced) start = std::chrono::steady_clock::now();
+    }
+
+    TraceSpan(const char *span_name, Timer t)
+        : name(span_name), timer(t), traced(tracer().is_enabled()), start(std::chrono::steady_clock::now()) {}
+
+    ~TraceSpan() {
+        if (!traced && timer == Timer::Count) return;
+        auto end = std::chrono::steady_clock::now();
+        if (timer != Timer::Count) metrics().record(timer, end - start);
+        if (traced) tracer().record(name, start, end);
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+};
+
+/**
+ * @brief Write the current trace to SHPD_TRACE_DIR (or the temp dir)
+ * @return Path of the written file, empty on failure
+ */
+inline std::string dump_trace_file() {
+    static std::atomic<unsigned> dump_count{0};
+
+    const char *dir = getenv("SHPD_TRACE_DIR");
+    std::filesystem::path path = dir && *dir ? std::filesystem::path(dir) : std::filesystem::temp_directory_path();
+    path /= "shpd-trace-" + std::to_string(getpid()) + "-" + std::to_string(dump_count++) + ".json";
+
+    std::ofstream out(path);
+    if (!out.is_open()) return "";
+    out << tracer().render_chrome_trace();
+    return out ? path.string() : "";
+}
+
+/**
+ * @brief Dump the trace to a file on every SIGUSR1
+ *
+ * Blocks SIGUSR1 in the calling thread and starts a thread that sigwait()s
+ * for it, so the dump runs as ordinary code rather than in a signal
+ * handler. Call before any other thread is started so they all inherit
+ * the blocked mask.
+ */
+inline void start_trace_signal_listener() {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+    if (pthread_sigmask(SIG_BLOCK, &set, nullptr) != 0) {
+        std::cerr << "Tracing: could not block SIGUSR1, signal dumps disabled" << std::endl;
+        return;
+    }
+
+    std::thread([set] {
+        int signal = 0;
+        while (sigwait(&set, &signal) == 0) {
+            std::string path = dump_trace_file();
+            if (path.empty()) {
+                std::cerr << "Tracing: failed to write trace dump" << std::endl;
+            } else {
+                std::cerr << "Tracing: wrote " << path << std::endl;
+            }
+        }
+    }).detach();
+}
+
+#endif // METRICS_TRACE_HPP
@@ -0,0 +1,397 @@
+#ifndef VAULT_BREACH_CORPUS_HPP
+#define VAULT_BREACH_CORPUS_HPP
+
+#include "../core/types.hpp"
+#include "../core/entry.hpp"
+#include <array>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr size_t SHA1_SIZE = 20;
+using Sha1Digest = std::array<unsigned char, SHA1_SIZE>;
+
+// The corpus is indexed by the first BREACH_PREFIX_BITS of each hash
+constexpr unsigned BREACH_PREFIX_BITS = 16;
+constexpr size_t BREACH_BUCKETS = size_t{1} << BREACH_PREFIX_BITS;
+// Search ranges smaller than this are scanned line by line
+constexpr size_t BREACH_SCAN_BYTES = 256;
+constexpr size_t BREACH_HEX_SIZE = SHA1_SIZE * 2;
+
+// Lookups are split across at most BREACH_MAX_THREADS threads, each taking
+// at least BREACH_MIN_PER_THREAD entries; a cold corpus makes them wait on
+// page faults rather than CPU, so more threads than cores still help
+constexpr size_t BREACH_MAX_THREADS = 16;
+constexpr size_t BREACH_MIN_PER_THREAD = 256;
+
+/**
+ * @brief SHA-1 of a byte string (FIPS 180-4)
+ * Only used to match the breach corpus format, never for anything secret.
+ * libsodium has no SHA-1.
+ */
+inline Sha1Digest sha1(std::string_view data) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    auto rotl = [](uint32_t x, int n) { return (x << n) | (x >> (32 - n)); };
+
+    auto compress = [&](const unsigned char *block) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            w[i] = (uint32_t{block[4 * i]} << 24) | (uint32_t{block[4 * i + 1]} << 16) |
+                   (uint32_t{block[4 * i + 2]} << 8) | uint32_t{block[4 * i + 3]};
+        }
+        for (int i = 16; i < 80; i++) w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t t = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    };
+
+    const auto *p = reinterpret_cast<const unsigned char *>(data.data());
+    size_t full = data.size() / 64 * 64;
+    for (size_t i = 0; i < full; i += 64) compress(p + i);
+
+    // Final one or two blocks: the tail, 0x80, zeros, bit length big-endian
+    unsigned char tail[128] = {};
+    size_t rest = data.size() - full;
+    std::memcpy(tail, p + full, rest);
+    tail[rest] = 0x80;
+    size_t tail_len = rest + 9 <= 64 ? 64 : 128;
+    uint64_t bits = static_cast<uint64_t>(data.size()) * 8;
+    for (int i = 0; i < 8; i++) tail[tail_len - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+    compress(tail);
+    if (tail_len == 128) compress(tail + 64);
+    sodium_memzero(tail, sizeof(tail));
+
+    Sha1Digest out;
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 4; j++) out[4 * i + j] = static_cast<unsigned char>(h[i] >> (24 - 8 * j));
+    }
+    return out;
+}
+
+/**
+ * @brief An entry whose password appears in the corpus
+ */
+struct BreachHit {
+    uint32_t slot;
+    uint32_t count; // times the corpus saw the password
+};
+
+/**
+ * @brief Read-only view of a breach corpus in the HIBP downloadable format
+ *
+ * The file is lines of "<40 hex SHA-1>:<count>", sorted by hash (the
+ * "ordered by hash" download, LF or CRLF). It is mapped, never read in
+ * full: opening builds a table of where each 16-bit hash prefix starts
+ * (512 KiB) by searching the mapping, and a lookup searches one bucket.
+ * SHA-1 is uniform, so searches start from an interpolated guess and
+ * usually touch one or two pages. Lookups are const and safe from many threads.
+ */
+class BreachCorpus {
+private:
+    std::string path;
+    const char *data = nullptr;
+    size_t size = 0;
+    std::vector<uint64_t> bucket_starts; // byte offset of each prefix's first line, plus the end
+
+    // Start of the first line at or after pos
+    size_t line_at_or_after(size_t pos) const {
+        if (pos == 0 || pos >= size || data[pos - 1] == '\n') return std::min(pos, size);
+        const void *newline = std::memchr(data + pos, '\n', size - pos);
+        return newline ? static_cast<size_t>(static_cast<const char *>(newline) - data) + 1 : size;
+    }
+
+    size_t next_line(size_t line) const { return line_at_or_after(line + 1); }
+
+    static int hex_value(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    // Hash on the line starting at `line`; throws if it is not one
+    void read_hash(size_t line, Sha1Digest &out) const {
+        if (size - line < BREACH_HEX_SIZE) throw std::runtime_error("Truncated breach corpus line");
+        for (size_t i = 0; i < SHA1_SIZE; i++) {
+            int hi = hex_value(data[line + 2 * i]);
+            int lo = hex_value(data[line + 2 * i + 1]);
+            if (hi < 0 || lo < 0) {
+                throw std::runtime_error("Malformed breach corpus line at offset " + std::to_string(line));
+            }
+            out[i] = static_cast<unsigned char>(hi << 4 | lo);
+        }
+    }
+
+    uint32_t read_count(size_t line) const {
+        uint64_t count = 0;
+        for (size_t i = line + BREACH_HEX_SIZE + 1; i < size && data[i] >= '0' && data[i] <= '9'; i++) {
+            count = std::min<uint64_t>(count * 10 + static_cast<uint64_t>(data[i] - '0'), UINT32_MAX);
+        }
+        return static_cast<uint32_t>(count);
+    }
+
+    // First eight bytes, big-endian: the hash as a number for interpolation
+    static uint64_t hash_value(const Sha1Digest &hash) {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; i++) v = v << 8 | hash[i];
+        return v;
+    }
+
+    // Start of the line containing pos, but not before lo
+    size_t line_containing(size_t lo, size_t pos) const {
+        const void *newline = memrchr(data + lo, '\n', pos - lo);
+        return newline ? static_cast<size_t>(static_cast<const char *>(newline) - data) + 1 : lo;
+    }
+
+    // Most comparisons are settled by the first eight bytes; parse the rest only on a tie
+    bool sorts_before(size_t line, const Sha1Digest &key) const {
+        if (size - line < BREACH_HEX_SIZE) throw std::runtime_error("Truncated breach corpus line");
+        uint64_t value = 0;
+        for (size_t i = 0; i < 16; i++) {
+            int digit = hex_value(data[line + i]);
+            if (digit < 0) throw std::runtime_error("Malformed breach corpus line at offset " + std::to_string(line));
+            value = value << 4 | static_cast<uint64_t>(digit);
+        }
+        uint64_t target = hash_value(key);
+        if (value != target) return value < target;
+
+        Sha1Digest probe;
+        read_hash(line, probe);
+        return std::memcmp(probe.data(), key.data(), SHA1_SIZE) < 0;
+    }
+
+    /**
+     * @brief First line in [lo, hi) whose hash is >= key, or hi
+     * @param lo, hi Line starts (or the end of the file)
+     * @param klo, khi Hash values bounding the range, to interpolate between
+     *
+     * One probe at the interpolated position, then gallops outwards from it
+     * until the key is bracketed and bisects what is left. On uniform
+     * hashes the guess is within a few lines, so every probe after the
+     * first lands on the same or the next page; skewed data costs
+     * O(log n) probes, as plain bisection would.
+     */
+    size_t lower_bound(size_t lo, size_t hi, uint64_t klo, uint64_t khi, const Sha1Digest &key) const {
+        uint64_t target = hash_value(key);
+
+        if (hi - lo > BREACH_SCAN_BYTES && klo < khi && target >= klo && target <= khi) {
+            long double fraction = static_cast<long double>(target - klo) / static_cast<long double>(khi - klo);
+            size_t guess = std::min(hi - 1, lo + static_cast<size_t>(fraction * static_cast<long double>(hi - lo)));
+            size_t line = line_containing(lo, guess);
+
+            size_t step = BREACH_SCAN_BYTES;
+            if (sorts_before(line, key)) {
+                lo = next_line(line);
+                while (hi - lo > step) {
+                    size_t at = line_at_or_after(lo + step);
+                    if (at >= hi) break;
+                    if (!sorts_before(at, key)) {
+                        hi = at;
+                        break;
+                    }
+                    lo = next_line(at);
+                    step *= 2;
+                }
+            } else {
+                hi = line;
+                while (hi - lo > step) {
+                    size_t at = line_containing(lo, hi - step);
+                    if (at == lo) break;
+                    if (sorts_before(at, key)) {
+                        lo = next_line(at);
+                        break;
+                    }
+                    hi = at;
+                    step *= 2;
+                }
+            }
+        }
+
+        while (hi - lo > BREACH_SCAN_BYTES) {
+            size_t line = line_containing(lo, lo + (hi - lo) / 2);
+            if (line == lo) line = next_line(lo);
+            if (line >= hi) break;
+            if (sorts_before(line, key)) {
+                lo = next_line(line);
+            } else {
+                hi = line;
+            }
+        }
+
+        for (size_t line = lo; line < hi; line = next_line(line)) {
+            if (!sorts_before(line, key)) return line;
+        }
+        return hi;
+    }
+
+public:
+    BreachCorpus() = default;
+    BreachCorpus(const BreachCorpus &) = delete;
+    BreachCorpus &operator=(const BreachCorpus &) = delete;
+    ~BreachCorpus() { close(); }
+
+    /**
+     * @brief Map a corpus file and index its hash prefixes
+     * Throws std::system_error if it cannot be mapped and std::runtime_error
+     * if it does not look like a SHA-1 corpus.
+     */
+    void open(const std::string &corpus_path) {
+        close();
+        int fd = ::open(corpus_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "cannot open " + corpus_path);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "cannot stat " + corpus_path);
+        }
+        if (st.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error("Breach corpus is empty: " + corpus_path);
+        }
+
+        void *mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        int err = errno;
+        ::close(fd);
+        if (mapped == MAP_FAILED) throw std::system_error(err, std::generic_category(), "cannot map " + corpus_path);
+        madvise(mapped, static_cast<size_t>(st.st_size), MADV_RANDOM);
+
+        data = static_cast<const char *>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        path = corpus_path;
+
+        try {
+            Sha1Digest first;
+            read_hash(0, first);
+
+            bucket_starts.assign(BREACH_BUCKETS + 1, size);
+            bucket_starts[0] = 0;
+            Sha1Digest key{};
+            for (size_t b = 1; b < BREACH_BUCKETS; b++) {
+                key[0] = static_cast<unsigned char>(b >> 8);
+                key[1] = static_cast<unsigned char>(b);
+                bucket_starts[b] = lower_bound(bucket_starts[b - 1], size, hash_value(key) - (uint64_t{1} << 48),
+                                               UINT64_MAX, key);
+            }
+        }
+        catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    void close() {
+        if (data) munmap(const_cast<char *>(data), size);
+        data = nullptr;
+        size = 0;
+        path.clear();
+        bucket_starts.clear();
+    }
+
+    bool is_open() const { return data != nullptr; }
+    const std::string &corpus_path() const { return path; }
+    uint64_t size_bytes() const { return size; }
+
+    /**
+     * @brief Times the corpus saw a hash; 0 if it is not listed
+     */
+    uint32_t lookup(const Sha1Digest &hash) const {
+        if (!data) return 0;
+        size_t b = static_cast<size_t>(hash[0]) << 8 | hash[1];
+        uint64_t base = static_cast<uint64_t>(b) << (64 - BREACH_PREFIX_BITS);
+        size_t end = bucket_starts[b + 1];
+        size_t line = lower_bound(bucket_starts[b], end, base, base | (UINT64_MAX >> BREACH_PREFIX_BITS), hash);
+        if (line >= end) return 0;
+
+        Sha1Digest found;
+        read_hash(line, found);
+        return found == hash ? std::max<uint32_t>(read_count(line), 1) : 0;
+    }
+};
+
+/**
+ * @brief Check every entry's password against the corpus, in parallel
+ * @param out Entries whose password is listed, by slot
+ */
+inline void check_breached_passwords(const std::vector<Entry> &entries, const BreachCorpus &corpus,
+                              std::vector<BreachHit> &out) {
+    out.clear();
+    std::vector<uint32_t> counts(entries.size(), 0);
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    auto check_range = [&](size_t begin, size_t end) {
+        try {
+            for (size_t i = begin; i < end; i++) {
+                std::string_view password(entries[i].Password, strnlen(entries[i].Password, ENTRY_PASSWORD_SIZE));
+                if (password.empty()) continue;
+                Sha1Digest hash = sha1(password);
+                counts[i] = corpus.lookup(hash);
+                sodium_memzero(hash.data(), hash.size());
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failure) failure = std::current_exception();
+        }
+    };
+
+    size_t workers = std::min({static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())) * 2,
+                               BREACH_MAX_THREADS,
+                               std::max<size_t>(1, (entries.size() + BREACH_MIN_PER_THREAD - 1) / BREACH_MIN_PER_THREAD)});
+    size_t per_worker = (entries.size() + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; w++) {
+        size_t begin = std::min(entries.size(), w * per_worker);
+        threads.emplace_back(check_range, begin, std::min(entries.size(), begin + per_worker));
+    }
+    check_range(0, std::min(entries.size(), per_worker));
+    for (auto &t : threads) t.join();
+    if (failure) std::rethrow_exception(failure);
+
+    for (size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] > 0) out.push_back({static_cast<uint32_t>(i), counts[i]});
+    }
+}
+
+/**
+ * @brief Corpus file named by SHPD_BREACH_CORPUS; empty when unset
+ */
+inline std::string breach_corpus_path() {
+    const char *configured = getenv("SHPD_BREACH_CORPUS");
+    return configured ? configured : "";
+}
+
+#endif // VAULT_BREACH_CORPUS_HPP
@@ -0,0 +1,38 @@
+#ifndef VAULT_CHANGES_HPP
+#define VAULT_CHANGES_HPP
+
+#include "../core/types.hpp"
+#include "../core/entry.hpp"
+
+// Number of mutations kept for delta fetches; older clients get a full listing
+constexpr size_t CHANGE_LOG_CAPACITY = 1024;
+
+// Reset means the entry list was replaced wholesale (load/close); it is
+// announced to listeners but never stored in the change log
+enum class ChangeType { Add, Modify, Delete, Reset };
+
+/**
+ * @brief A single mutation recorded in the vault change log
+ * Entry holds the contents after the change (empty for deletes)
+ */
+struct EntryChange {
+    uint64_t revision;
+    ChangeType type;
+    size_t index;
+    Entry entry;
+};
+
+/**
+ * @brief Wire name of a change type
+ */
+inline const char *change_type_name(ChangeType type) {
+    switch (type) {
+    case ChangeType::Add: return "add";
+    case ChangeType::Modify: return "modify";
+    case ChangeType::Delete: return "delete";
+    case ChangeType::Reset: return "reset";
+    }
+    return "unknown";
+}
+
+#endif // VAULT_CHANGES_HPP
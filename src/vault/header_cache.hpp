@@ -0,0 +1,101 @@
+#ifndef VAULT_HEADER_CACHE_HPP
+#define VAULT_HEADER_CACHE_HPP
+
+#include "vault_header.hpp"
+#include <mutex>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Headers remembered by peek_header; the cache is simply reset when full
+constexpr size_t HEADER_CACHE_CAPACITY = 4096;
+
+/**
+ * @brief Vault headers keyed by file identity, valid while mtime/size hold
+ */
+class HeaderCache {
+private:
+    struct Key {
+        dev_t dev;
+        ino_t ino;
+        bool operator==(const Key &other) const { return dev == other.dev && ino == other.ino; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            return std::hash<uint64_t>()(static_cast<uint64_t>(key.ino) * 31 + static_cast<uint64_t>(key.dev));
+        }
+    };
+
+    struct Cached {
+        struct timespec mtime;
+        off_t size;
+        VaultHeader header;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<Key, Cached, KeyHash> headers;
+
+    static bool same_version(const Cached &cached, const struct stat &st) {
+        return cached.mtime.tv_sec == st.st_mtim.tv_sec && cached.mtime.tv_nsec == st.st_mtim.tv_nsec &&
+               cached.size == st.st_size;
+    }
+
+public:
+    bool find(const struct stat &st, VaultHeader &header) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = headers.find({st.st_dev, st.st_ino});
+        if (it == headers.end() || !same_version(it->second, st)) return false;
+        header = it->second.header;
+        return true;
+    }
+
+    void store(const struct stat &st, const VaultHeader &header) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (headers.size() >= HEADER_CACHE_CAPACITY) headers.clear();
+        headers[{st.st_dev, st.st_ino}] = {st.st_mtim, st.st_size, header};
+    }
+};
+
+inline HeaderCache &header_cache() {
+    static HeaderCache cache;
+    return cache;
+}
+
+/**
+ * @brief Read a vault header without opening the vault
+ *
+ * A cache hit costs one fstatat; a miss adds open + a single pread of the
+ * header + close. The file is never held open.
+ * @param dirfd Directory fd for relative paths, or AT_FDCWD
+ * @param path File to read
+ * @param header Output header
+ * @return false if the file is missing, short or not a vault
+ */
+inline bool peek_header_at(int dirfd, const char *path, VaultHeader &header) {
+    struct stat st;
+    if (fstatat(dirfd, path, &st, 0) != 0 || !S_ISREG(st.st_mode)) return false;
+    if (st.st_size < static_cast<off_t>(sizeof(VaultHeader))) return false;
+
+    if (header_cache().find(st, header)) return true;
+
+    int fd = openat(dirfd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    ssize_t got = pread(fd, &header, sizeof(VaultHeader), 0);
+    close(fd);
+
+    if (got != static_cast<ssize_t>(sizeof(VaultHeader)) ||
+        std::strncmp(header.signature, SIGNATURE, SIGNATURE_SIZE) != 0) {
+        return false;
+    }
+
+    header_cache().store(st, header);
+    return true;
+}
+
+inline bool peek_header(const std::string &path, VaultHeader &header) {
+    return peek_header_at(AT_FDCWD, path.c_str(), header);
+}
+
+#endif // VAULT_HEADER_CACHE_HPP
@@ -0,0 +1,291 @@
+#ifndef VAULT_HISTORY_HPP
+#define VAULT_HISTORY_HPP
+
+#include "../core/types.hpp"
+#include "../core/entry.hpp"
+#include "../crypto/hashing.hpp"
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+
+// History segment lives next to the vault file as <vault>.hist
+constexpr const char *HISTORY_SUFFIX = ".hist";
+// Records are sealed with a crypto_kdf subkey of the vault key
+constexpr char HISTORY_KDF_CONTEXT[crypto_kdf_CONTEXTBYTES] = {'S', 'H', 'P', 'D', 'H', 'I', 'S', 'T'};
+constexpr uint64_t HISTORY_SUBKEY_ID = 1;
+constexpr size_t HISTORY_KEY_SIZE = crypto_aead_chacha20poly1305_ietf_KEYBYTES;
+constexpr size_t HISTORY_NONCE_SIZE = crypto_aead_chacha20poly1305_ietf_NPUBBYTES;
+// op, index, count, time
+constexpr size_t HISTORY_RECORD_FIXED = 1 + 8 + 8 + 8;
+// No record is larger than its fixed part plus a worst-case delta (every
+// other byte changed: 5 coded bytes per 2 entry bytes)
+constexpr size_t HISTORY_MAX_RECORD = HISTORY_RECORD_FIXED + 3 * sizeof(Entry) + HISTORY_NONCE_SIZE +
+                                      crypto_aead_chacha20poly1305_ietf_ABYTES;
+
+/**
+ * @brief What a history record describes
+ * Append and Delete carry no entry data; they let a reader follow an
+ * entry's index back through the shifts caused by later deletes.
+ */
+enum class HistoryOp : uint8_t { Append = 1, Modify = 2, Delete = 3 };
+
+struct HistoryRecord {
+    HistoryOp op;
+    uint64_t index;
+    uint64_t count; // entries appended (Append only)
+    int64_t time;
+    std::string delta; // Modify only: XOR of the new and previous Entry bytes, run-length coded
+};
+
+/**
+ * @brief A previous version of an entry, newest first
+ */
+struct EntryVersion {
+    Entry entry;
+    time_t replaced_at; // when this version was overwritten
+};
+
+/**
+ * @brief XOR two entries and run-length code the result
+ *
+ * An edit usually touches one field, so the XOR is mostly zero bytes.
+ * Coded as repeated [u16 zero run][u16 literal length][literal bytes].
+ * Applying the delta to either entry yields the other.
+ */
+inline std::string encode_entry_delta(const Entry &a, const Entry &b) {
+    const auto *pa = reinterpret_cast<const unsigned char *>(&a);
+    const auto *pb = reinterpret_cast<const unsigned char *>(&b);
+    std::string out;
+
+    auto put16 = [&](size_t v) {
+        out += static_cast<char>(v & 0xff);
+        out += static_cast<char>(v >> 8);
+    };
+
+    size_t i = 0;
+    while (i < sizeof(Entry)) {
+        size_t zeros = 0;
+        while (i + zeros < sizeof(Entry) && pa[i + zeros] == pb[i + zeros]) zeros++;
+        i += zeros;
+
+        size_t literal = 0;
+        while (i + literal < sizeof(Entry) && pa[i + literal] != pb[i + literal]) literal++;
+        if (literal == 0) break;
+
+        put16(zeros);
+        put16(literal);
+        for (size_t k = 0; k < literal; k++) out += static_cast<char>(pa[i + k] ^ pb[i + k]);
+        i += literal;
+    }
+    return out;
+}
+
+/**
+ * @brief Apply a delta from encode_entry_delta in place; throws if it is malformed
+ */
+inline void apply_entry_delta(Entry &entry, std::string_view delta) {
+    auto *p = reinterpret_cast<unsigned char *>(&entry);
+    auto get16 = [&](size_t at) {
+        return static_cast<size_t>(static_cast<unsigned char>(delta[at])) |
+               (static_cast<size_t>(static_cast<unsigned char>(delta[at + 1])) << 8);
+    };
+
+    size_t pos = 0;
+    size_t offset = 0;
+    while (pos < delta.size()) {
+        if (delta.size() - pos < 4) throw std::runtime_error("Malformed history delta");
+        size_t zeros = get16(pos);
+        size_t literal = get16(pos + 2);
+        pos += 4;
+        offset += zeros;
+        if (literal > delta.size() - pos || offset + literal > sizeof(Entry)) {
+            throw std::runtime_error("Malformed history delta");
+        }
+        for (size_t k = 0; k < literal; k++) p[offset + k] ^= static_cast<unsigned char>(delta[pos + k]);
+        pos += literal;
+        offset += literal;
+    }
+}
+
+/**
+ * @brief Walk the log backwards to collect the previous versions of one entry
+ * @param index The entry's index now
+ * @param current The entry's contents now
+ * @param limit Most versions to return
+ *
+ * A delete at or before the tracked index means the entry sat one slot
+ * further along before it; the Append that created the entry ends its history.
+ */
+inline void entry_versions(const std::vector<HistoryRecord> &records, uint64_t index, const Entry &current, size_t limit,
+                    std::vector<EntryVersion> &out) {
+    out.clear();
+    Entry version = current;
+
+    for (auto it = records.rbegin(); it != records.rend() && out.size() < limit; ++it) {
+        switch (it->op) {
+        case HistoryOp::Delete:
+            if (index >= it->index) index++;
+            break;
+        case HistoryOp::Append:
+            if (index >= it->index && index < it->index + it->count) return;
+            break;
+        case HistoryOp::Modify:
+            if (index == it->index) {
+                apply_entry_delta(version, it->delta);
+                out.push_back({version, static_cast<time_t>(it->time)});
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Append-only, encrypted log of entry versions kept beside a vault
+ *
+ * Each record is [u32 length][nonce][ciphertext] sealed with
+ * ChaCha20-Poly1305 under a subkey of the vault key, with the vault's salt
+ * as associated data, so a segment left beside a different vault file fails
+ * authentication instead of being read as its history. The log is never read
+ * while a vault is opened or loaded; it is only scanned when a history is
+ * requested, so its length has no effect on unlock time.
+ */
+class HistoryLog {
+private:
+    std::string path;
+    int fd = -1;
+
+    void ensure_open() {
+        if (fd >= 0) return;
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+    }
+
+    static void put64(std::string &out, uint64_t v) {
+        for (int i = 0; i < 8; i++) out += static_cast<char>(v >> (8 * i));
+    }
+
+    static uint64_t get64(const unsigned char *p) {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; i++) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+        return v;
+    }
+
+public:
+    ~HistoryLog() { close(); }
+
+    /**
+     * @brief Use the segment belonging to a vault file; nothing is read yet
+     * @param fresh Discard any existing segment (for a newly created vault)
+     */
+    void attach(const std::string &vault_path, bool fresh = false) {
+        close();
+        path = vault_path + HISTORY_SUFFIX;
+        if (fresh) std::filesystem::remove(path);
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    const std::string &segment_path() const { return path; }
+
+    /**
+     * @brief Current length of the segment, to pass to truncate() if the
+     * change logged after it never reaches the vault file
+     */
+    uint64_t end() {
+        ensure_open();
+        off_t size = ::lseek(fd, 0, SEEK_END);
+        if (size < 0) throw std::system_error(errno, std::generic_category(), "cannot seek " + path);
+        return static_cast<uint64_t>(size);
+    }
+
+    /**
+     * @brief Drop every record appended after end() returned `size`
+     */
+    void truncate(uint64_t size) {
+        ensure_open();
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "cannot truncate " + path);
+        }
+    }
+
+    /**
+     * @brief Seal and append one record; throws if it could not be written in full
+     * @param salt The vault header's salt, bound to the record as associated data
+     */
+    void append(const unsigned char *key, const unsigned char *salt, const HistoryRecord &record) {
+        std::string plain;
+        plain += static_cast<char>(record.op);
+        put64(plain, record.index);
+        put64(plain, record.count);
+        put64(plain, static_cast<uint64_t>(record.time));
+        plain += record.delta;
+
+        size_t sealed_len = HISTORY_NONCE_SIZE + plain.size() + crypto_aead_chacha20poly1305_ietf_ABYTES;
+        std::vector<unsigned char> frame(4 + sealed_len);
+        for (int i = 0; i < 4; i++) frame[i] = static_cast<unsigned char>(sealed_len >> (8 * i));
+        unsigned char *nonce = frame.data() + 4;
+        randombytes_buf(nonce, HISTORY_NONCE_SIZE);
+
+        unsigned long long clen = 0;
+        crypto_aead_chacha20poly1305_ietf_encrypt(nonce + HISTORY_NONCE_SIZE, &clen,
+                                                  reinterpret_cast<const unsigned char *>(plain.data()), plain.size(),
+                                                  salt, SALT_SIZE, nullptr, nonce, key);
+        sodium_memzero(plain.data(), plain.size());
+
+        ensure_open();
+        // O_APPEND: one write() places the whole record at the end
+        ssize_t written = ::write(fd, frame.data(), frame.size());
+        if (written != static_cast<ssize_t>(frame.size())) {
+            throw std::runtime_error("Failed to write history record");
+        }
+    }
+
+    /**
+     * @brief Read and decrypt every record; an incomplete trailing record is ignored
+     * @param salt The salt the records were appended with
+     */
+    void read_all(const unsigned char *key, const unsigned char *salt, std::vector<HistoryRecord> &out) const {
+        out.clear();
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) return;
+
+        std::vector<unsigned char> sealed;
+        std::vector<unsigned char> plain;
+        unsigned char len_bytes[4];
+        while (in.read(reinterpret_cast<char *>(len_bytes), 4)) {
+            size_t len = len_bytes[0] | (len_bytes[1] << 8) | (len_bytes[2] << 16) |
+                         (static_cast<size_t>(len_bytes[3]) << 24);
+            if (len < HISTORY_NONCE_SIZE + crypto_aead_chacha20poly1305_ietf_ABYTES + HISTORY_RECORD_FIXED ||
+                len > HISTORY_MAX_RECORD) {
+                throw std::runtime_error("Corrupted history segment");
+            }
+
+            sealed.resize(len);
+            if (!in.read(reinterpret_cast<char *>(sealed.data()), len)) break;
+
+            plain.resize(len - HISTORY_NONCE_SIZE - crypto_aead_chacha20poly1305_ietf_ABYTES);
+            unsigned long long plain_len = 0;
+            if (crypto_aead_chacha20poly1305_ietf_decrypt(plain.data(), &plain_len, nullptr,
+                                                          sealed.data() + HISTORY_NONCE_SIZE,
+                                                          len - HISTORY_NONCE_SIZE, salt, SALT_SIZE, sealed.data(),
+                                                          key) != 0) {
+                throw std::runtime_error("History record failed authentication");
+            }
+
+            HistoryRecord record;
+            record.op = static_cast<HistoryOp>(plain[0]);
+            record.index = get64(plain.data() + 1);
+            record.count = get64(plain.data() + 9);
+            record.time = static_cast<int64_t>(get64(plain.data() + 17));
+            record.delta.assign(reinterpret_cast<const char *>(plain.data()) + HISTORY_RECORD_FIXED,
+                                plain_len - HISTORY_RECORD_FIXED);
+            sodium_memzero(plain.data(), plain.size());
+            out.push_back(std::move(record));
+        }
+    }
+};
+
+#endif // VAULT_HISTORY_HPP
@@ -0,0 +1,223 @@
+#ifndef VAULT_KEY_CACHE_HPP
+#define VAULT_KEY_CACHE_HPP
+
+#include "../core/types.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+
+constexpr size_t KEY_CACHE_KEY_SIZE = crypto_secretbox_KEYBYTES;
+constexpr size_t KEY_CACHE_TOKEN_SIZE = 32;
+constexpr size_t KEY_CACHE_SALT_SIZE = crypto_pwhash_SALTBYTES;
+// Vaults remembered at once; the entry closest to expiry is evicted first
+constexpr size_t KEY_CACHE_CAPACITY = 16;
+
+/**
+ * @brief Identity of a vault file: the inode plus the salt its key came from
+ */
+struct VaultIdentity {
+    dev_t dev;
+    ino_t ino;
+    unsigned char salt[KEY_CACHE_SALT_SIZE];
+
+    bool operator==(const VaultIdentity &other) const {
+        return dev == other.dev && ino == other.ino && std::memcmp(salt, other.salt, KEY_CACHE_SALT_SIZE) == 0;
+    }
+};
+
+/**
+ * @brief Identify the vault at a path, or return false if it cannot be stat'ed
+ */
+inline bool vault_identity(const std::string &path, const unsigned char *salt, VaultIdentity &out) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    out.dev = st.st_dev;
+    out.ino = st.st_ino;
+    std::memcpy(out.salt, salt, KEY_CACHE_SALT_SIZE);
+    return true;
+}
+
+/**
+ * @brief Short-lived cache of derived vault keys, unlocked by a session token
+ *
+ * After a password unlock the derived key is kept for a fixed TTL, and the
+ * client receives a random token that can unlock the same vault again
+ * without the KDF. Key and token live in sodium_malloc memory (mlocked,
+ * guard-paged) that is left PROT_NONE except while being copied, and are
+ * wiped by sodium_free as soon as the TTL runs out. Disabled (TTL zero)
+ * unless SHPD_KEY_CACHE_TTL is set to a number of seconds.
+ */
+class KeyCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    // [key][token] in one guarded allocation
+    struct Secret {
+        unsigned char key[KEY_CACHE_KEY_SIZE];
+        unsigned char token[KEY_CACHE_TOKEN_SIZE];
+    };
+
+    struct Slot {
+        VaultIdentity identity;
+        Secret *secret;
+        Clock::time_point expires;
+    };
+
+    std::chrono::seconds ttl;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Slot> slots;
+    std::thread sweeper;
+    bool stopping = false;
+
+    static void wipe(Slot &slot) {
+        // sodium_free zeroes the region before unmapping; it must be writable
+        sodium_mprotect_readwrite(slot.secret);
+        sodium_free(slot.secret);
+        slot.secret = nullptr;
+    }
+
+    void remove_expired(Clock::time_point now) {
+        for (auto it = slots.begin(); it != slots.end();) {
+            if (it->expires <= now) {
+                wipe(*it);
+                it = slots.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Wipe each key the moment its TTL ends, not on the next lookup
+    void sweep_loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            remove_expired(Clock::now());
+            if (slots.empty()) {
+                cv.wait(lock);
+            } else {
+                auto next = std::min_element(slots.begin(), slots.end(), [](const Slot &a, const Slot &b) {
+                    return a.expires < b.expires;
+                })->expires;
+                cv.wait_until(lock, next);
+            }
+        }
+    }
+
+public:
+    explicit KeyCache(std::chrono::seconds time_to_live) : ttl(time_to_live) {
+        if (enabled()) {
+            sweeper = std::thread([this] { sweep_loop(); });
+        }
+    }
+
+    KeyCache(const KeyCache &) = delete;
+    KeyCache &operator=(const KeyCache &) = delete;
+
+    ~KeyCache() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            for (auto &slot : slots) wipe(slot);
+            slots.clear();
+        }
+        cv.notify_all();
+        if (sweeper.joinable()) sweeper.join();
+    }
+
+    bool enabled() const { return ttl.count() > 0; }
+    std::chrono::seconds time_to_live() const { return ttl; }
+
+    /**
+     * @brief Remember a freshly derived key and issue a token for it
+     * @param token_hex Output: hex session token, empty if caching is off or failed
+     */
+    void store(const VaultIdentity &identity, const unsigned char *key, std::string &token_hex) {
+        token_hex.clear();
+        if (!enabled()) return;
+
+        auto *secret = static_cast<Secret *>(sodium_malloc(sizeof(Secret)));
+        if (!secret) return;
+        std::memcpy(secret->key, key, KEY_CACHE_KEY_SIZE);
+        randombytes_buf(secret->token, KEY_CACHE_TOKEN_SIZE);
+
+        char hex[KEY_CACHE_TOKEN_SIZE * 2 + 1];
+        sodium_bin2hex(hex, sizeof(hex), secret->token, KEY_CACHE_TOKEN_SIZE);
+        token_hex = hex;
+        sodium_memzero(hex, sizeof(hex));
+        sodium_mprotect_noaccess(secret);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            remove_expired(Clock::now());
+
+            // One key per vault: a new unlock replaces the previous token
+            for (auto it = slots.begin(); it != slots.end(); ++it) {
+                if (it->identity == identity) {
+                    wipe(*it);
+                    slots.erase(it);
+                    break;
+                }
+            }
+            if (slots.size() >= KEY_CACHE_CAPACITY) {
+                auto oldest = std::min_element(slots.begin(), slots.end(), [](const Slot &a, const Slot &b) {
+                    return a.expires < b.expires;
+                });
+                wipe(*oldest);
+                slots.erase(oldest);
+            }
+            slots.push_back({identity, secret, Clock::now() + ttl});
+        }
+        cv.notify_all();
+    }
+
+    /**
+     * @brief Copy out the cached key if the token matches and has not expired
+     * @return false on a miss, a wrong token or an expired entry
+     */
+    bool lookup(const VaultIdentity &identity, const std::string &token_hex, unsigned char *key_out) {
+        unsigned char token[KEY_CACHE_TOKEN_SIZE];
+        size_t token_len = 0;
+        if (sodium_hex2bin(token, sizeof(token), token_hex.c_str(), token_hex.size(), nullptr, &token_len,
+                           nullptr) != 0 ||
+            token_len != KEY_CACHE_TOKEN_SIZE) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        remove_expired(Clock::now());
+
+        for (auto &slot : slots) {
+            if (!(slot.identity == identity)) continue;
+
+            sodium_mprotect_readonly(slot.secret);
+            bool match = sodium_memcmp(slot.secret->token, token, KEY_CACHE_TOKEN_SIZE) == 0;
+            if (match) std::memcpy(key_out, slot.secret->key, KEY_CACHE_KEY_SIZE);
+            sodium_mprotect_noaccess(slot.secret);
+            sodium_memzero(token, sizeof(token));
+            return match;
+        }
+        sodium_memzero(token, sizeof(token));
+        return false;
+    }
+};
+
+/**
+ * @brief Cache TTL from SHPD_KEY_CACHE_TTL (seconds); zero keeps the cache off
+ */
+inline std::chrono::seconds key_cache_ttl() {
+    const char *configured = getenv("SHPD_KEY_CACHE_TTL");
+    if (!configured || !*configured) return std::chrono::seconds{0};
+    try {
+        return std::chrono::seconds{std::max(0L, std::stol(configured))};
+    }
+    catch (const std::exception &) {
+        std::cerr << "Ignoring invalid SHPD_KEY_CACHE_TTL: " << configured << std::endl;
+        return std::chrono::seconds{0};
+    }
+}
+
+#endif // VAULT_KEY_CACHE_HPP
@@ -0,0 +1,193 @@
+#ifndef VAULT_PASSWORD_AUDIT_HPP
+#define VAULT_PASSWORD_AUDIT_HPP
+
+#include "../core/types.hpp"
+#include "../core/entry.hpp"
+#include <thread>
+#include <unordered_map>
+
+// Passwords are hashed under a crypto_kdf subkey of the vault key, so the
+// digests mean nothing outside this vault
+constexpr char AUDIT_KDF_CONTEXT[crypto_kdf_CONTEXTBYTES] = {'S', 'H', 'P', 'D', 'A', 'U', 'D', 'T'};
+constexpr uint64_t AUDIT_SUBKEY_ID = 1;
+constexpr size_t AUDIT_KEY_SIZE = crypto_generichash_KEYBYTES;
+constexpr size_t AUDIT_DIGEST_SIZE = 16;
+
+// Hashing is split across at most AUDIT_MAX_THREADS threads,
+// each taking at least AUDIT_MIN_PER_THREAD entries
+constexpr size_t AUDIT_MAX_THREADS = 8;
+constexpr size_t AUDIT_MIN_PER_THREAD = 512;
+
+// Normalized forms shorter than this are too common to call two passwords similar
+constexpr size_t AUDIT_MIN_STEM = 4;
+
+struct PasswordDigest {
+    unsigned char bytes[AUDIT_DIGEST_SIZE];
+
+    bool operator==(const PasswordDigest &other) const {
+        return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+    }
+};
+
+// Digests are keyed BLAKE2b output, so any eight bytes are already uniform
+struct PasswordDigestHash {
+    size_t operator()(const PasswordDigest &digest) const {
+        size_t h;
+        std::memcpy(&h, digest.bytes, sizeof(h));
+        return h;
+    }
+};
+
+/**
+ * @brief Entry slots sharing a password (or a normalized form of one), ascending
+ */
+using ReuseGroup = std::vector<uint32_t>;
+
+struct ReuseReport {
+    size_t checked = 0;              // entries with a non-empty password
+    std::vector<ReuseGroup> reused;  // identical passwords
+    std::vector<ReuseGroup> similar; // different passwords with the same normalized form
+};
+
+/**
+ * @brief Reduce a password to the stem people vary between sites
+ *
+ * Trailing digits and symbols ("2024!", "1") are dropped, the rest is
+ * lowercased with common substitutions undone (0→o, 1→i, 3→e, 4→a, 5→s,
+ * 7→t, @→a, $→s) and anything non-alphanumeric removed, so "P@ssw0rd1"
+ * and "password!" both become "password".
+ */
+inline std::string normalize_password(std::string_view password) {
+    while (!password.empty() && !std::isalpha(static_cast<unsigned char>(password.back()))) {
+        password.remove_suffix(1);
+    }
+
+    std::string out;
+    out.reserve(password.size());
+    for (char c : password) {
+        switch (c) {
+        case '0': out += 'o'; break;
+        case '1': out += 'i'; break;
+        case '3': out += 'e'; break;
+        case '4': case '@': out += 'a'; break;
+        case '5': case '$': out += 's'; break;
+        case '7': out += 't'; break;
+        default:
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+    }
+    return out;
+}
+
+// Per-entry hashing output, filled in parallel
+struct AuditDigests {
+    PasswordDigest exact;
+    PasswordDigest stem;
+    bool has_password = false;
+    bool has_stem = false;
+};
+
+inline void hash_audit_text(const unsigned char *key, std::string_view text, PasswordDigest &out) {
+    crypto_generichash(out.bytes, sizeof(out.bytes), reinterpret_cast<const unsigned char *>(text.data()),
+                       text.size(), key, AUDIT_KEY_SIZE);
+}
+
+/**
+ * @brief Group slots by one of their digests, keeping groups of two or more
+ * @param field AuditDigests::exact or AuditDigests::stem
+ * @param present The flag saying that digest was computed
+ *
+ * The table maps each distinct digest to a group number, so only groups
+ * that turn out to be shared ever allocate a slot list.
+ */
+inline std::vector<ReuseGroup> group_by_digest(const std::vector<AuditDigests> &digests, PasswordDigest AuditDigests::*field,
+                                        bool AuditDigests::*present) {
+    std::unordered_map<PasswordDigest, uint32_t, PasswordDigestHash> group_of;
+    group_of.reserve(digests.size());
+    std::vector<uint32_t> slot_group(digests.size(), UINT32_MAX);
+    std::vector<uint32_t> sizes;
+
+    for (size_t i = 0; i < digests.size(); i++) {
+        if (!(digests[i].*present)) continue;
+        auto [it, inserted] = group_of.try_emplace(digests[i].*field, static_cast<uint32_t>(sizes.size()));
+        if (inserted) sizes.push_back(0);
+        sizes[it->second]++;
+        slot_group[i] = it->second;
+    }
+
+    // Renumber shared groups densely, in order of their first slot
+    std::vector<uint32_t> shared(sizes.size(), UINT32_MAX);
+    std::vector<ReuseGroup> groups;
+    for (size_t i = 0; i < digests.size(); i++) {
+        uint32_t g = slot_group[i];
+        if (g == UINT32_MAX || sizes[g] < 2) continue;
+        if (shared[g] == UINT32_MAX) {
+            shared[g] = static_cast<uint32_t>(groups.size());
+            groups.emplace_back().reserve(sizes[g]);
+        }
+        groups[shared[g]].push_back(static_cast<uint32_t>(i));
+    }
+
+    // Largest group first; ties keep first-slot order
+    std::stable_sort(groups.begin(), groups.end(),
+                     [](const ReuseGroup &a, const ReuseGroup &b) { return a.size() > b.size(); });
+    return groups;
+}
+
+/**
+ * @brief Find entries that reuse a password or a close variant of one
+ * @param key AUDIT_KEY_SIZE bytes (see Vault::derive_subkey)
+ *
+ * Each password and its normalized form are hashed with keyed BLAKE2b in
+ * parallel over the entries; grouping the digests is then a pass
+ * through a hash table for each. No password text outlives its hashing.
+ */
+inline void audit_password_reuse(const std::vector<Entry> &entries, const unsigned char *key, ReuseReport &report) {
+    report = ReuseReport{};
+    std::vector<AuditDigests> digests(entries.size());
+
+    auto hash_range = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            std::string_view password(entries[i].Password, strnlen(entries[i].Password, ENTRY_PASSWORD_SIZE));
+            if (password.empty()) continue;
+
+            AuditDigests &d = digests[i];
+            hash_audit_text(key, password, d.exact);
+            d.has_password = true;
+
+            std::string stem = normalize_password(password);
+            if (stem.size() >= AUDIT_MIN_STEM) {
+                hash_audit_text(key, stem, d.stem);
+                d.has_stem = true;
+            }
+            sodium_memzero(stem.data(), stem.size());
+        }
+    };
+
+    size_t workers = std::min({static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())),
+                               AUDIT_MAX_THREADS,
+                               std::max<size_t>(1, (entries.size() + AUDIT_MIN_PER_THREAD - 1) / AUDIT_MIN_PER_THREAD)});
+    size_t per_worker = (entries.size() + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    for (size_t w = 1; w < workers; w++) {
+        size_t begin = std::min(entries.size(), w * per_worker);
+        threads.emplace_back(hash_range, begin, std::min(entries.size(), begin + per_worker));
+    }
+    hash_range(0, std::min(entries.size(), per_worker));
+    for (auto &t : threads) t.join();
+
+    for (const AuditDigests &d : digests) report.checked += d.has_password;
+    report.reused = group_by_digest(digests, &AuditDigests::exact, &AuditDigests::has_password);
+
+    // A stem group whose members all share one password is already a reuse group
+    for (auto &group : group_by_digest(digests, &AuditDigests::stem, &AuditDigests::has_stem)) {
+        bool varied = std::any_of(group.begin(), group.end(), [&](uint32_t slot) {
+            return digests[slot].exact != digests[group.front()].exact;
+        });
+        if (varied) report.similar.push_back(std::move(group));
+    }
+}
+
+#endif // VAULT_PASSWORD_AUDIT_HPP
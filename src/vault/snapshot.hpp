@@ -0,0 +1,199 @@
+#ifndef VAULT_SNAPSHOT_HPP
+#define VAULT_SNAPSHOT_HPP
+
+#include "vault_header.hpp"
+#include "changes.hpp"
+#include <system_error>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Largest single copy_file_range / pread request
+constexpr size_t SNAPSHOT_COPY_CHUNK = 1 << 20;
+
+/**
+ * @brief Byte range of a vault file; length SNAPSHOT_TO_END runs to end of file
+ */
+struct ByteRange {
+    off_t offset;
+    off_t length;
+};
+
+constexpr off_t SNAPSHOT_TO_END = -1;
+
+/**
+ * @brief Parts of the file rewritten by a run of logged mutations, coalesced
+ *
+ * Every mutation rewrites the header; adds and edits rewrite one slot,
+ * and a delete shifts every slot from its index to the end of the file.
+ */
+inline std::vector<ByteRange> dirty_ranges(const std::vector<EntryChange> &changes) {
+    std::vector<ByteRange> ranges{{0, static_cast<off_t>(sizeof(VaultHeader))}};
+
+    for (const auto &change : changes) {
+        off_t slot = static_cast<off_t>(sizeof(VaultHeader) + change.index * ENCRYPTED_ENTRY_SIZE);
+        if (change.type == ChangeType::Delete) {
+            ranges.push_back({slot, SNAPSHOT_TO_END});
+        } else {
+            ranges.push_back({slot, static_cast<off_t>(ENCRYPTED_ENTRY_SIZE)});
+        }
+    }
+
+    std::sort(ranges.begin(), ranges.end(), [](const ByteRange &a, const ByteRange &b) { return a.offset < b.offset; });
+
+    std::vector<ByteRange> merged;
+    for (const auto &range : ranges) {
+        if (!merged.empty()) {
+            ByteRange &last = merged.back();
+            if (last.length == SNAPSHOT_TO_END) break;
+            if (range.offset <= last.offset + last.length) {
+                last.length = range.length == SNAPSHOT_TO_END
+                                  ? SNAPSHOT_TO_END
+                                  : std::max(last.length, range.offset + range.length - last.offset);
+                continue;
+            }
+        }
+        merged.push_back(range);
+    }
+    return merged;
+}
+
+/**
+ * @brief Copy [offset, offset + length) between files, in the kernel when possible
+ *
+ * copy_file_range lets the filesystem share extents or copy server-side;
+ * when it is unsupported for this pair of files, falls back to pread/pwrite.
+ * Stops early at end of the source. Throws std::system_error on I/O errors.
+ */
+inline void copy_file_bytes(int src, int dst, off_t offset, off_t length) {
+    bool kernel_copy = true;
+    std::vector<char> buffer;
+
+    while (length > 0) {
+        size_t want = static_cast<size_t>(std::min<off_t>(length, SNAPSHOT_COPY_CHUNK));
+        ssize_t done;
+
+        if (kernel_copy) {
+            off_t in = offset;
+            off_t out = offset;
+            done = copy_file_range(src, &in, dst, &out, want, 0);
+            if (done < 0 && (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)) {
+                kernel_copy = false;
+                continue;
+            }
+        } else {
+            buffer.resize(want);
+            done = pread(src, buffer.data(), want, offset);
+            for (ssize_t written = 0; done > 0 && written < done;) {
+                ssize_t n = pwrite(dst, buffer.data() + written, done - written, offset + written);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), "snapshot write");
+                }
+                written += n;
+            }
+        }
+
+        if (done < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(), "snapshot copy");
+        }
+        if (done == 0) break;
+        offset += done;
+        length -= done;
+    }
+}
+
+/**
+ * @brief Point-in-time copy of a vault file, written to a temp file and renamed into place
+ *
+ * Intended sequence (see ApiHandlers::handle_snapshot):
+ *  1. With the vault locked, try clone(): a reflink (FICLONE) shares the
+ *     file's extents, costs O(1) and is consistent by construction.
+ *  2. Otherwise note the vault revision, unlock, and copy() the whole file
+ *     while writers carry on; the copy may be torn.
+ *  3. Lock again and repair() only the ranges the change log says were
+ *     rewritten since that revision, then truncate to the current size.
+ * The vault is only ever locked for O(changes) work.
+ */
+class SnapshotWriter {
+private:
+    std::string target;
+    std::string temp;
+    int fd = -1;
+    bool committed = false;
+
+    std::string method = "copy";
+    uint64_t copied = 0;
+    uint64_t repaired = 0;
+
+public:
+    explicit SnapshotWriter(const std::string &path) : target(path), temp(path + ".partial") {
+        fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "cannot create " + temp);
+    }
+
+    ~SnapshotWriter() {
+        if (fd >= 0) ::close(fd);
+        if (!committed) ::unlink(temp.c_str());
+    }
+
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    /**
+     * @brief Share the source's extents; false if the filesystem cannot reflink
+     */
+    bool clone(int src) {
+        if (ioctl(fd, FICLONE, src) != 0) return false;
+        method = "reflink";
+        return true;
+    }
+
+    void copy(int src) {
+        struct stat st;
+        if (fstat(src, &st) != 0) throw std::system_error(errno, std::generic_category(), "snapshot stat");
+        copy_file_bytes(src, fd, 0, st.st_size);
+        copied += st.st_size;
+    }
+
+    /**
+     * @brief Recopy the given ranges and cut the copy to the source's current size
+     */
+    void repair(int src, const std::vector<ByteRange> &ranges) {
+        struct stat st;
+        if (fstat(src, &st) != 0) throw std::system_error(errno, std::generic_category(), "snapshot stat");
+
+        for (const auto &range : ranges) {
+            if (range.offset >= st.st_size) continue;
+            off_t length = range.length == SNAPSHOT_TO_END ? st.st_size - range.offset
+                                                           : std::min(range.length, st.st_size - range.offset);
+            copy_file_bytes(src, fd, range.offset, length);
+            repaired += length;
+        }
+        if (ftruncate(fd, st.st_size) != 0) {
+            throw std::system_error(errno, std::generic_category(), "snapshot truncate");
+        }
+    }
+
+    /**
+     * @brief Make the copy durable and move it to the target path
+     */
+    void commit() {
+        if (fsync(fd) != 0) throw std::system_error(errno, std::generic_category(), "snapshot fsync");
+        ::close(fd);
+        fd = -1;
+        if (std::rename(temp.c_str(), target.c_str()) != 0) {
+            throw std::system_error(errno, std::generic_category(), "cannot rename to " + target);
+        }
+        committed = true;
+    }
+
+    const std::string &copy_method() const { return method; }
+    uint64_t bytes_copied() const { return copied; }
+    uint64_t bytes_repaired() const { return repaired; }
+};
+
+#endif // VAULT_SNAPSHOT_HPP
@@ -0,0 +1,161 @@
+#ifndef VAULT_SORT_INDEX_HPP
+#define VAULT_SORT_INDEX_HPP
+
+#include "../core/types.hpp"
+#include "../core/entry.hpp"
+#include <array>
+#include <strings.h>
+
+/**
+ * @brief Orders a listing can be served in, besides file order
+ */
+enum class SortKey : uint8_t { Name = 0, Website = 1, Modified = 2 };
+
+constexpr size_t SORT_KEY_COUNT = 3;
+
+// Appends of up to this many entries are binary-search inserts; larger ones
+// are sorted and merged, which compares every existing entry once
+constexpr size_t APPEND_INSERT_MAX = 16;
+
+/**
+ * @brief Parse a sort name ("name", "url", "modified"); throws on anything else
+ */
+inline SortKey sort_key(std::string_view name) {
+    if (name.empty() || name == "name") return SortKey::Name;
+    if (name == "url" || name == "website") return SortKey::Website;
+    if (name == "modified" || name == "modf_time") return SortKey::Modified;
+    throw std::runtime_error("Unknown sort: " + std::string(name));
+}
+
+// Website without its scheme, so http:// and https:// sites sort together
+inline std::string_view website_sort_text(const Entry &entry) {
+    std::string_view url(entry.Website, strnlen(entry.Website, ENTRY_WEBSITE_SIZE));
+    size_t scheme = url.find("://");
+    if (scheme != std::string_view::npos) url.remove_prefix(scheme + 3);
+    return url;
+}
+
+/**
+ * @brief Three-way comparison of two entries by one key
+ * Text compares case-insensitively (ASCII); ties are broken by slot by the caller.
+ */
+inline int compare_entries(SortKey key, const Entry &a, const Entry &b) {
+    switch (key) {
+    case SortKey::Name:
+        return strncasecmp(a.Name, b.Name, ENTRY_NAME_SIZE);
+    case SortKey::Website: {
+        std::string_view wa = website_sort_text(a);
+        std::string_view wb = website_sort_text(b);
+        int c = strncasecmp(wa.data(), wb.data(), std::min(wa.size(), wb.size()));
+        if (c != 0) return c;
+        return wa.size() < wb.size() ? -1 : wa.size() > wb.size() ? 1 : 0;
+    }
+    case SortKey::Modified:
+        return a.Modf_Time < b.Modf_Time ? -1 : a.Modf_Time > b.Modf_Time ? 1 : 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Precomputed orderings of the loaded entries, one permutation per key
+ *
+ * Each permutation is a sorted array of slots, so the entry at any rank is
+ * one lookup and a page of a sorted listing costs O(page size). Ties keep
+ * file order, which a delete never changes, so the arrays stay valid when
+ * later slots shift down. Mutations binary-search the affected position;
+ * a bulk append sorts the new slots and merges them in.
+ */
+class SortIndex {
+private:
+    std::array<std::vector<uint32_t>, SORT_KEY_COUNT> orders;
+
+    // First position in `order` whose slot sorts at or after (target, slot)
+    static std::vector<uint32_t>::iterator locate(std::vector<uint32_t> &order, SortKey key,
+                                                  const std::vector<Entry> &entries, const Entry &target,
+                                                  uint32_t slot) {
+        return std::lower_bound(order.begin(), order.end(), slot, [&](uint32_t s, uint32_t) {
+            int c = compare_entries(key, entries[s], target);
+            return c < 0 || (c == 0 && s < slot);
+        });
+    }
+
+    // Position of a slot whose current contents are entries[slot]
+    static std::vector<uint32_t>::iterator find(std::vector<uint32_t> &order, SortKey key,
+                                                const std::vector<Entry> &entries, uint32_t slot) {
+        auto it = locate(order, key, entries, entries[slot], slot);
+        if (it != order.end() && *it == slot) return it;
+        return std::find(order.begin(), order.end(), slot);
+    }
+
+public:
+    void clear() {
+        for (auto &order : orders) order.clear();
+    }
+
+    void build(const std::vector<Entry> &entries) {
+        clear();
+        append(entries, 0);
+    }
+
+    // Slots [first, entries.size()) were just appended
+    void append(const std::vector<Entry> &entries, size_t first) {
+        for (size_t k = 0; k < SORT_KEY_COUNT; k++) {
+            SortKey key = static_cast<SortKey>(k);
+            auto less = [&](uint32_t a, uint32_t b) {
+                int c = compare_entries(key, entries[a], entries[b]);
+                return c < 0 || (c == 0 && a < b);
+            };
+
+            std::vector<uint32_t> &order = orders[k];
+            if (entries.size() - first <= APPEND_INSERT_MAX) {
+                for (size_t slot = first; slot < entries.size(); slot++) {
+                    auto s = static_cast<uint32_t>(slot);
+                    order.insert(locate(order, key, entries, entries[s], s), s);
+                }
+                continue;
+            }
+
+            size_t old_size = order.size();
+            for (size_t slot = first; slot < entries.size(); slot++) order.push_back(static_cast<uint32_t>(slot));
+            std::sort(order.begin() + old_size, order.end(), less);
+            std::inplace_merge(order.begin(), order.begin() + old_size, order.end(), less);
+        }
+    }
+
+    // entries[slot] is about to be replaced by `after`
+    void update(const std::vector<Entry> &entries, uint32_t slot, const Entry &after) {
+        for (size_t k = 0; k < SORT_KEY_COUNT; k++) {
+            SortKey key = static_cast<SortKey>(k);
+            std::vector<uint32_t> &order = orders[k];
+            auto it = find(order, key, entries, slot);
+            if (it == order.end()) continue;
+            order.erase(it);
+            order.insert(locate(order, key, entries, after, slot), slot);
+        }
+    }
+
+    // entries[slot] is about to be erased; later slots move down one
+    void erase(const std::vector<Entry> &entries, uint32_t slot) {
+        for (size_t k = 0; k < SORT_KEY_COUNT; k++) {
+            std::vector<uint32_t> &order = orders[k];
+            auto it = find(order, static_cast<SortKey>(k), entries, slot);
+            if (it != order.end()) order.erase(it);
+            for (auto &s : order) {
+                if (s > slot) s--;
+            }
+        }
+    }
+
+    size_t size() const { return orders[0].size(); }
+
+    /**
+     * @brief Slot at a rank of one ordering
+     * @param descending Count from the end instead
+     */
+    uint32_t at(SortKey key, size_t rank, bool descending = false) const {
+        const auto &order = orders[static_cast<size_t>(key)];
+        return descending ? order[order.size() - 1 - rank] : order[rank];
+    }
+};
+
+#endif // VAULT_SORT_INDEX_HPP
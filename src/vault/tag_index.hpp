@@ -0,0 +1,226 @@
+#ifndef VAULT_TAG_INDEX_HPP
+#define VAULT_TAG_INDEX_HPP
+
+#include "../core/types.hpp"
+#include "../core/entry.hpp"
+#include <string_view>
+#include <unordered_map>
+
+// Slots holding one folder or tag, ascending
+using Postings = std::vector<uint32_t>;
+
+inline std::string_view trim_tag_text(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+    return s;
+}
+
+/**
+ * @brief Canonical form of a folder path: trimmed parts joined by '/'
+ * " Work / Infra/" and "Work/Infra" name the same folder.
+ */
+inline std::string normalize_folder(std::string_view path) {
+    std::string out;
+    while (!path.empty()) {
+        size_t slash = path.find('/');
+        std::string_view part = trim_tag_text(path.substr(0, slash));
+        if (!part.empty()) {
+            if (!out.empty()) out += '/';
+            out += part;
+        }
+        if (slash == std::string_view::npos) break;
+        path.remove_prefix(slash + 1);
+    }
+    return out;
+}
+
+/**
+ * @brief Distinct tags of a comma-separated list: trimmed, lowercased, sorted
+ */
+inline std::vector<std::string> parse_tags(std::string_view list) {
+    std::vector<std::string> tags;
+    while (!list.empty()) {
+        size_t comma = list.find(',');
+        std::string_view tag = trim_tag_text(list.substr(0, comma));
+        if (!tag.empty()) {
+            std::string lowered(tag);
+            for (auto &c : lowered) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            tags.push_back(std::move(lowered));
+        }
+        if (comma == std::string_view::npos) break;
+        list.remove_prefix(comma + 1);
+    }
+    std::sort(tags.begin(), tags.end());
+    tags.erase(std::unique(tags.begin(), tags.end()), tags.end());
+    return tags;
+}
+
+/**
+ * @brief Intersect two posting lists
+ * Walks the shorter list and gallops through the longer one, so the cost
+ * is O(short * log(long / short)) rather than O(short + long).
+ */
+inline void intersect_postings(const Postings &a, const Postings &b, Postings &out) {
+    const Postings &small = a.size() <= b.size() ? a : b;
+    const Postings &large = a.size() <= b.size() ? b : a;
+    out.clear();
+
+    auto pos = large.begin();
+    for (uint32_t slot : small) {
+        // Exponential search for the first element >= slot, then binary search
+        size_t step = 1;
+        auto hi = pos;
+        while (hi != large.end() && *hi < slot) {
+            pos = hi;
+            hi = static_cast<size_t>(large.end() - hi) > step ? hi + step : large.end();
+            step *= 2;
+        }
+        pos = std::lower_bound(pos, hi, slot);
+        if (pos == large.end()) break;
+        if (*pos == slot) out.push_back(slot);
+    }
+}
+
+/**
+ * @brief Inverted index from folders and tags to entry slots
+ *
+ * Each folder path posts to itself and every ancestor, so a folder query
+ * includes its subfolders. Posting lists stay sorted by slot: appends land
+ * at the end, edits are a binary-search insert or erase, and a delete
+ * shifts the tail of each list down one, as it does for the file.
+ */
+class TagIndex {
+private:
+    std::unordered_map<std::string, Postings> folders;
+    std::unordered_map<std::string, Postings> tags;
+    uint32_t slots = 0;
+
+    static void folder_terms(const Entry &entry, std::vector<std::string> &out) {
+        out.clear();
+        std::string folder = normalize_folder(std::string_view(entry.Folder, strnlen(entry.Folder, ENTRY_FOLDER_SIZE)));
+        for (size_t slash = folder.find('/'); slash != std::string::npos; slash = folder.find('/', slash + 1)) {
+            out.push_back(folder.substr(0, slash));
+        }
+        if (!folder.empty()) out.push_back(std::move(folder));
+    }
+
+    static std::vector<std::string> tag_terms(const Entry &entry) {
+        return parse_tags(std::string_view(entry.Tags, strnlen(entry.Tags, ENTRY_TAGS_SIZE)));
+    }
+
+    static void insert(std::unordered_map<std::string, Postings> &map, const std::string &term, uint32_t slot) {
+        Postings &list = map[term];
+        if (list.empty() || list.back() < slot) {
+            list.push_back(slot);
+        } else {
+            auto it = std::lower_bound(list.begin(), list.end(), slot);
+            if (it == list.end() || *it != slot) list.insert(it, slot);
+        }
+    }
+
+    static void remove(std::unordered_map<std::string, Postings> &map, const std::string &term, uint32_t slot) {
+        auto found = map.find(term);
+        if (found == map.end()) return;
+        Postings &list = found->second;
+        auto it = std::lower_bound(list.begin(), list.end(), slot);
+        if (it != list.end() && *it == slot) list.erase(it);
+        if (list.empty()) map.erase(found);
+    }
+
+    void index(uint32_t slot, const Entry &entry) {
+        std::vector<std::string> terms;
+        folder_terms(entry, terms);
+        for (const auto &term : terms) insert(folders, term, slot);
+        for (const auto &term : tag_terms(entry)) insert(tags, term, slot);
+    }
+
+    void unindex(uint32_t slot, const Entry &entry) {
+        std::vector<std::string> terms;
+        folder_terms(entry, terms);
+        for (const auto &term : terms) remove(folders, term, slot);
+        for (const auto &term : tag_terms(entry)) remove(tags, term, slot);
+    }
+
+    static std::vector<std::pair<std::string, size_t>> counts(const std::unordered_map<std::string, Postings> &map) {
+        std::vector<std::pair<std::string, size_t>> out;
+        out.reserve(map.size());
+        for (const auto &[term, list] : map) out.emplace_back(term, list.size());
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+public:
+    void clear() {
+        folders.clear();
+        tags.clear();
+        slots = 0;
+    }
+
+    void build(const std::vector<Entry> &entries) {
+        clear();
+        for (const auto &entry : entries) append(entry);
+    }
+
+    // Index an entry added after every indexed slot
+    void append(const Entry &entry) { index(slots++, entry); }
+
+    // An entry's contents changed in place
+    void update(uint32_t slot, const Entry &before, const Entry &after) {
+        unindex(slot, before);
+        index(slot, after);
+    }
+
+    // An entry was removed; every later slot moves down one
+    void erase(uint32_t slot, const Entry &removed) {
+        unindex(slot, removed);
+        for (auto *map : {&folders, &tags}) {
+            for (auto &[term, list] : *map) {
+                for (auto it = std::upper_bound(list.begin(), list.end(), slot); it != list.end(); ++it) --*it;
+            }
+        }
+        slots--;
+    }
+
+    /**
+     * @brief Slots in `folder` (or below it) carrying every one of `wanted`
+     * @param folder Folder path; empty matches every entry
+     * @param wanted Tags as returned by parse_tags; empty matches every entry
+     */
+    void query(std::string_view folder, const std::vector<std::string> &wanted, Postings &out) const {
+        out.clear();
+        std::vector<const Postings *> lists;
+
+        std::string path = normalize_folder(folder);
+        if (!path.empty()) {
+            auto it = folders.find(path);
+            if (it == folders.end()) return;
+            lists.push_back(&it->second);
+        }
+        for (const auto &tag : wanted) {
+            auto it = tags.find(tag);
+            if (it == tags.end()) return;
+            lists.push_back(&it->second);
+        }
+
+        if (lists.empty()) {
+            out.resize(slots);
+            for (uint32_t i = 0; i < slots; i++) out[i] = i;
+            return;
+        }
+
+        // Smallest list first keeps every intermediate result small
+        std::sort(lists.begin(), lists.end(), [](const Postings *a, const Postings *b) { return a->size() < b->size(); });
+        out = *lists[0];
+        Postings next;
+        for (size_t i = 1; i < lists.size() && !out.empty(); i++) {
+            intersect_postings(out, *lists[i], next);
+            out.swap(next);
+        }
+    }
+
+    // Every folder (including ancestors) and tag in use, by name, with entry counts
+    std::vector<std::pair<std::string, size_t>> folder_counts() const { return counts(folders); }
+    std::vector<std::pair<std::string, size_t>> tag_counts() const { return counts(tags); }
+};
+
+#endif // VAULT_TAG_INDEX_HPP
@@ -2,12 +2,26 @@
 #define VAULT_VAULT_HPP
 
 #include "vault_header.hpp"
+#include "changes.hpp"
+#include "history.hpp"
+#include "tag_index.hpp"
+#include "sort_index.hpp"
 #include "../core/entry.hpp"
+#include "../core/entry_id.hpp"
 #include "../crypto/encryption.hpp"
+#include "../metrics/trace.hpp"
 #include "../lib/json.hpp"
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
 
 using json = nlohmann::json;
 
+// Bulk appends split encryption over at most this many threads,
+// each taking at least APPEND_MIN_PER_THREAD entries
+constexpr size_t APPEND_MAX_THREADS = 8;
+constexpr size_t APPEND_MIN_PER_THREAD = 64;
+
 /**
  * @brief Vault handler class for managing encrypted vault files
  */
@@ -16,15 +30,248 @@ private:
     std::fstream file;
     VaultHeader header;
     std::vector<Entry> entries;
+    // Slot of every loaded entry, by id
+    std::unordered_map<EntryId, size_t, EntryIdHash> id_slots;
+    // Folders and tags of the loaded entries
+    TagIndex tag_index;
+    // Name, website and modification time orderings of the loaded entries
+    SortIndex sort_index;
     unsigned char key[crypto_secretbox_KEYBYTES];
     bool authenticated = false;
     std::string file_path;
+    // Opened a file in an earlier format; it is rewritten once unlocked
+    const LegacyFormat *legacy_format = nullptr;
+    // Opened for reading only: never migrated, every mutation refused
+    bool read_only = false;
+
+    // Revision of the in-memory entry list; bumped on every mutation and
+    // whenever the list is replaced wholesale (load/close)
+    uint64_t revision = 0;
+    uint64_t log_base = 0;
+    // Bumped on every open, create and close; tells apart two sessions on
+    // the same path
+    uint64_t session = 0;
+    std::deque<EntryChange> changes;
+    std::function<void(const EntryChange &)> change_listener;
+    HistoryLog history;
+
+    void record_change(ChangeType type, size_t index, const Entry &entry) {
+        changes.push_back({++revision, type, index, entry});
+        if (changes.size() > CHANGE_LOG_CAPACITY) {
+            sodium_memzero(&changes.front().entry, sizeof(Entry));
+            changes.pop_front();
+            log_base = changes.front().revision - 1;
+        }
+        if (change_listener) {
+            change_listener(changes.back());
+        }
+    }
+
+    // Push buffered writes to the file; the vault never fsyncs
+    void flush_file() {
+        TraceSpan span("vault.flush", Timer::VaultFlush);
+        file.flush();
+    }
+
+    void encrypt_timed(const Entry &entry, std::vector<unsigned char> &out) {
+        TraceSpan span("entry.encrypt", Timer::EntryEncrypt);
+        encrypt_entry(key, entry, out);
+    }
+
+    // Seal entries into consecutive ENCRYPTED_ENTRY_SIZE slots of out, in parallel
+    void encrypt_batch(const std::vector<Entry> &batch, unsigned char *out) {
+        size_t workers = std::min({static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())),
+                                   APPEND_MAX_THREADS,
+                                   (batch.size() + APPEND_MIN_PER_THREAD - 1) / APPEND_MIN_PER_THREAD});
+
+        auto seal_range = [&](size_t begin, size_t end) {
+            std::vector<unsigned char> encrypted;
+            for (size_t i = begin; i < end; i++) {
+                encrypt_timed(batch[i], encrypted);
+                std::memcpy(out + i * ENCRYPTED_ENTRY_SIZE, encrypted.data(), ENCRYPTED_ENTRY_SIZE);
+            }
+        };
+
+        size_t per_worker = (batch.size() + workers - 1) / workers;
+        std::vector<std::thread> threads;
+        for (size_t w = 1; w < workers; w++) {
+            size_t begin = w * per_worker;
+            threads.emplace_back(seal_range, begin, std::min(batch.size(), begin + per_worker));
+        }
+        seal_range(0, std::min(batch.size(), per_worker));
+        for (auto &t : threads) t.join();
+    }
+
+    // Append to the history segment ahead of the change it describes; throws
+    // if the record cannot be written. Returns the segment's length before the
+    // record, for abandon_write() to cut it off again.
+    uint64_t log_history(HistoryOp op, size_t index, size_t count, std::string delta = {}) {
+        unsigned char history_key[HISTORY_KEY_SIZE];
+        if (crypto_kdf_derive_from_key(history_key, sizeof(history_key), HISTORY_SUBKEY_ID, HISTORY_KDF_CONTEXT,
+                                       key) != 0) {
+            throw std::runtime_error("Failed to derive history key");
+        }
+        uint64_t mark;
+        try {
+            mark = history.end();
+            history.append(history_key, header.salt, {op, index, count, std::time(nullptr), std::move(delta)});
+        }
+        catch (...) {
+            sodium_memzero(history_key, sizeof(history_key));
+            throw;
+        }
+        sodium_memzero(history_key, sizeof(history_key));
+        return mark;
+    }
+
+    // A logged change did not reach the file: drop its history record and
+    // write back the header the file had before
+    json abandon_write(uint64_t history_mark, const VaultHeader &saved) {
+        file.clear();
+        header = saved;
+        file.seekp(0);
+        header.write(file);
+        flush_file();
+        history.truncate(history_mark);
+
+        json response;
+        response["success"] = false;
+        response["error"] = "Failed to write to vault file";
+        return response;
+    }
+
+    // Current contents of a slot, from memory when loaded, else from the file
+    bool current_entry(size_t index, Entry &out) {
+        if (index < entries.size()) {
+            out = entries[index];
+            return true;
+        }
+        std::vector<Entry> one;
+        if (!read_entries(index, 1, one).value("success", false) || one.empty()) return false;
+        out = one[0];
+        return true;
+    }
+
+    void rebuild_indexes() {
+        id_slots.clear();
+        id_slots.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            id_slots[entry_id(entries[i])] = i;
+        }
+        tag_index.build(entries);
+        sort_index.build(entries);
+    }
+
+    /**
+     * @brief Rewrite a legacy file in the current format, giving entries ids where missing
+     * Entries are re-sealed one at a time into <vault>.migrating, which is
+     * synced and renamed over the original, so a crash leaves either file intact.
+     */
+    json migrate_legacy() {
+        TraceSpan span("vault.migrate");
+        json response;
+        std::string temp = file_path + ".migrating";
+
+        VaultHeader upgraded = header;
+        std::memcpy(upgraded.version, CURR_VERSION, VERSION_SIZE);
+
+        try {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) throw std::runtime_error("cannot create " + temp);
+            upgraded.write(out);
+
+            std::vector<unsigned char> sealed(legacy_format->encrypted_size);
+            std::vector<unsigned char> encrypted;
+            file.clear();
+            for (size_t i = 0; i < header.entries; i++) {
+                file.seekg(sizeof(VaultHeader) + i * sealed.size());
+                file.read(reinterpret_cast<char *>(sealed.data()), sealed.size());
+                if (!file) throw std::runtime_error("short read at entry " + std::to_string(i));
+
+                Entry entry;
+                decrypt_legacy_entry(key, *legacy_format, entry, sealed.data());
+                if (entry_id(entry).is_nil()) set_entry_id(entry, new_entry_id());
+                encrypt_timed(entry, encrypted);
+                sodium_memzero(&entry, sizeof(entry));
+                out.write(reinterpret_cast<const char *>(encrypted.data()), encrypted.size());
+            }
+            metrics().add(Counter::VaultReadBytes, header.entries * sealed.size());
+            metrics().add(Counter::VaultWriteBytes, sizeof(VaultHeader) + header.entries * ENCRYPTED_ENTRY_SIZE);
+
+            out.close();
+            if (!out) throw std::runtime_error("write failed");
+
+            int fd = ::open(temp.c_str(), O_RDONLY | O_CLOEXEC);
+            bool synced = fd >= 0 && fsync(fd) == 0;
+            if (fd >= 0) ::close(fd);
+            if (!synced) throw std::runtime_error("cannot sync " + temp);
+
+            file.close();
+            if (std::rename(temp.c_str(), file_path.c_str()) != 0) {
+                throw std::runtime_error("cannot replace " + file_path);
+            }
+        }
+        catch (const std::exception &e) {
+            std::filesystem::remove(temp);
+            if (!file.is_open()) file.open(file_path, std::ios::in | std::ios::out | std::ios::binary);
+            response["success"] = false;
+            response["error"] = std::string("Failed to upgrade vault: ") + e.what();
+            return response;
+        }
+
+        file.open(file_path, std::ios::in | std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            response["success"] = false;
+            response["error"] = "Failed to reopen upgraded vault";
+            return response;
+        }
+        header = upgraded;
+        legacy_format = nullptr;
+        entries.clear();
+        rebuild_indexes();
+        reset_changes();
+
+        response["success"] = true;
+        return response;
+    }
+
+    // Finish unlocking: upgrade a legacy file now that the key is known
+    json unlock(json response) {
+        authenticated = true;
+        if (legacy_format && !read_only) {
+            json migrated = migrate_legacy();
+            if (!migrated["success"]) {
+                authenticated = false;
+                sodium_memzero(key, sizeof(key));
+                return migrated;
+            }
+            response["migrated"] = true;
+        }
+        response["success"] = true;
+        return response;
+    }
+
+    // The log holds entry contents, passwords included; wipe them before letting go
+    void clear_changes() {
+        for (auto &change : changes) sodium_memzero(&change.entry, sizeof(Entry));
+        changes.clear();
+    }
+
+    void reset_changes() {
+        clear_changes();
+        log_base = ++revision;
+        if (change_listener) {
+            change_listener({revision, ChangeType::Reset, 0, Entry{}});
+        }
+    }
 
 public:
     ~Vault() {
         if (file.is_open()) {
             file.close();
         }
+        clear_changes();
+        sodium_memzero(key, sizeof(key));
     }
 
     json create(const std::string &path, const std::string &password, const std::string &vault_name = "Vault") {
@@ -50,11 +297,16 @@ public:
         }
 
         randombytes_buf(new_header.salt, SALT_SIZE);
-        std::string hashed = hash_password(password);
+        std::string hashed;
+        {
+            TraceSpan span("kdf.hash", Timer::KdfHash);
+            hashed = hash_password(password);
+        }
         std::memcpy(new_header.hash, hashed.c_str(), HASH_SIZE);
 
         new_header.write(out);
         out.close();
+        metrics().add(Counter::VaultWriteBytes, sizeof(VaultHeader));
 
         // Open the file and set up the handler
         file.open(path, std::ios::in | std::ios::out | std::ios::binary);
@@ -66,9 +318,16 @@ public:
 
         header = new_header;
         file_path = path;
+        session++;
+        history.attach(path, true);
 
         // Derive key for encryption
-        if (!derive_key_from_password(password, header.salt, key)) {
+        bool derived;
+        {
+            TraceSpan span("kdf.derive", Timer::KdfDerive);
+            derived = derive_key_from_password(password, header.salt, key);
+        }
+        if (!derived) {
             file.close();
             response["success"] = false;
             response["error"] = "Failed to derive key";
@@ -76,6 +335,13 @@ public:
         }
 
         authenticated = true;
+        legacy_format = nullptr;
+        read_only = false;
+        entries.clear();
+        id_slots.clear();
+        tag_index.clear();
+        sort_index.clear();
+        reset_changes();
 
         response["success"] = true;
         response["message"] = "Vault created successfully";
@@ -84,7 +350,12 @@ public:
         return response;
     }
 
-    json open(const std::string &path) {
+    /**
+     * @brief Open a vault file; nothing is decrypted until authenticate()
+     * @param for_reading Leave the file exactly as it is: a legacy format is
+     * read in place rather than migrated, and every mutation is refused
+     */
+    json open(const std::string &path, bool for_reading = false) {
         json response;
 
         if (!std::filesystem::exists(path)) {
@@ -93,7 +364,8 @@ public:
             return response;
         }
 
-        file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+        read_only = for_reading;
+        file.open(path, read_only ? std::ios::in | std::ios::binary : std::ios::in | std::ios::out | std::ios::binary);
         if (!file.is_open()) {
             response["success"] = false;
             response["error"] = "Failed to open file: " + path;
@@ -101,7 +373,10 @@ public:
         }
 
         header.read(file);
+        metrics().add(Counter::VaultReadBytes, sizeof(VaultHeader));
         file_path = path;
+        session++;
+        history.attach(path);
 
         if (std::strncmp(header.signature, SIGNATURE, SIGNATURE_SIZE) != 0) {
             file.close();
@@ -110,6 +385,17 @@ public:
             return response;
         }
 
+        legacy_format = nullptr;
+        for (const auto &format : LEGACY_FORMATS) {
+            if (std::memcmp(header.version, format.version, VERSION_SIZE) == 0) legacy_format = &format;
+        }
+        if (!legacy_format && std::memcmp(header.version, CURR_VERSION, VERSION_SIZE) != 0) {
+            file.close();
+            response["success"] = false;
+            response["error"] = "Unsupported vault version";
+            return response;
+        }
+
         response["success"] = true;
         response["name"] = std::string(header.name, strnlen(header.name, NAME_SIZE));
         response["entries"] = header.entries;
@@ -117,6 +403,7 @@ public:
     }
 
     json authenticate(const std::string &password) {
+        TraceSpan span("vault.authenticate");
         json response;
 
         if (!file.is_open()) {
@@ -125,22 +412,29 @@ public:
             return response;
         }
 
-        int result = crypto_pwhash_argon2id_str_verify(header.hash, password.c_str(), password.length());
+        int result;
+        {
+            TraceSpan span("kdf.verify", Timer::KdfVerify);
+            result = crypto_pwhash_argon2id_str_verify(header.hash, password.c_str(), password.length());
+        }
         if (result != 0) {
             response["success"] = false;
             response["error"] = "Invalid password";
             return response;
         }
 
-        if (!derive_key_from_password(password, header.salt, key)) {
+        bool derived;
+        {
+            TraceSpan span("kdf.derive", Timer::KdfDerive);
+            derived = derive_key_from_password(password, header.salt, key);
+        }
+        if (!derived) {
             response["success"] = false;
             response["error"] = "Failed to derive key";
             return response;
         }
 
-        authenticated = true;
-        response["success"] = true;
-        return response;
+        return unlock(response);
     }
 
     json close() {
@@ -148,16 +442,52 @@ public:
         if (file.is_open()) {
             file.close();
         }
+        history.close();
+        session++;
         authenticated = false;
+        read_only = false;
+        sodium_memzero(key, sizeof(key));
         entries.clear();
+        id_slots.clear();
+        tag_index.clear();
+        sort_index.clear();
+        reset_changes();
         response["success"] = true;
         return response;
     }
 
     bool is_open() const { return file.is_open(); }
+    const std::string &get_path() const { return file_path; }
+    uint64_t get_session() const { return session; }
+    const unsigned char *get_salt() const { return header.salt; }
+
+    /**
+     * @brief Unlock with a key derived earlier for this file, skipping the KDF
+     * @param cached_key Key for this vault's salt (see KeyCache)
+     */
+    json authenticate_with_key(const unsigned char *cached_key) {
+        json response;
+
+        if (!file.is_open()) {
+            response["success"] = false;
+            response["error"] = "No vault is open";
+            return response;
+        }
+
+        std::memcpy(key, cached_key, sizeof(key));
+        return unlock(response);
+    }
+
+    // Copy the derived key out for caching; false unless authenticated
+    bool copy_key(unsigned char *out) const {
+        if (!authenticated) return false;
+        std::memcpy(out, key, sizeof(key));
+        return true;
+    }
     bool is_authenticated() const { return authenticated; }
 
     json load_entries() {
+        TraceSpan span("vault.load_entries");
         json response;
 
         if (!file.is_open()) {
@@ -172,7 +502,10 @@ public:
             return response;
         }
 
-        entries.clear();
+        // Decrypt into a new list; the loaded entries and their indexes stay
+        // as they were unless every entry decrypts
+        std::vector<Entry> loaded;
+        loaded.reserve(header.entries);
 
         for (size_t i = 0; i < header.entries; i++) {
             size_t offset = sizeof(VaultHeader) + (i * ENCRYPTED_ENTRY_SIZE);
@@ -180,25 +513,40 @@ public:
 
             unsigned char encrypted[ENCRYPTED_ENTRY_SIZE];
             file.read(reinterpret_cast<char *>(encrypted), ENCRYPTED_ENTRY_SIZE);
+            metrics().add(Counter::VaultReadBytes, ENCRYPTED_ENTRY_SIZE);
 
             try {
                 Entry entry;
-                decrypt_entry(key, entry, encrypted, ENCRYPTED_ENTRY_SIZE);
-                entries.push_back(entry);
+                {
+                    ScopedTimer timer(Timer::EntryDecrypt);
+                    decrypt_entry(key, entry, encrypted, ENCRYPTED_ENTRY_SIZE);
+                }
+                loaded.push_back(entry);
+                sodium_memzero(&entry, sizeof(entry));
             }
             catch (const std::exception &e) {
+                sodium_memzero(loaded.data(), loaded.size() * sizeof(Entry));
+                file.clear();
                 response["success"] = false;
                 response["error"] = "Failed to decrypt entry " + std::to_string(i) + ": " + e.what();
                 return response;
             }
         }
 
+        entries.swap(loaded);
+        sodium_memzero(loaded.data(), loaded.size() * sizeof(Entry));
+        rebuild_indexes();
+        reset_changes();
+
         response["success"] = true;
         response["entries"] = header.entries;
         return response;
     }
 
-    json add_entry(const Entry &entry) {
+    /**
+     * @brief Add an entry; it is given a fresh id unless it already has one
+     */
+    json add_entry(const Entry &new_entry) {
         json response;
 
         if (!file.is_open()) {
@@ -213,29 +561,55 @@ public:
             return response;
         }
 
+        if (read_only) {
+            response["success"] = false;
+            response["error"] = "Vault is open read-only";
+            return response;
+        }
+
+        Entry entry = new_entry;
+        if (entry_id(entry).is_nil()) set_entry_id(entry, new_entry_id());
+
+        VaultHeader saved = header;
+        uint64_t history_mark = log_history(HistoryOp::Append, header.entries, 1);
+
         // Encrypt Entry struct directly
         std::vector<unsigned char> encrypted{};
-        encrypt_entry(key, entry, encrypted);
+        encrypt_timed(entry, encrypted);
 
         size_t offset = sizeof(VaultHeader) + (header.entries * ENCRYPTED_ENTRY_SIZE);
         file.seekp(offset);
         file.write(reinterpret_cast<const char *>(encrypted.data()), encrypted.size());
+        metrics().add(Counter::VaultWriteBytes, encrypted.size() + sizeof(VaultHeader));
 
         header.entries++;
         header.updated = std::time(nullptr);
 
         file.seekp(0);
         header.write(file);
-        file.flush();
+        flush_file();
+        if (!file) return abandon_write(history_mark, saved);
 
         entries.push_back(entry);
+        id_slots[entry_id(entry)] = header.entries - 1;
+        tag_index.append(entry);
+        sort_index.append(entries, entries.size() - 1);
+        record_change(ChangeType::Add, header.entries - 1, entry);
 
         response["success"] = true;
         response["entries"] = header.entries;
+        response["id"] = entry_id_hex(entry_id(entry));
         return response;
     }
 
-    json modify_entry(size_t index, const Entry &entry) {
+    /**
+     * @brief Append many entries with one write and one header update
+     * Encrypts in parallel, then writes the sealed entries as one contiguous
+     * block at the end of the file. Clients see a reset rather than one
+     * change per entry. Entries without an id are given one.
+     */
+    json append_entries(const std::vector<Entry> &new_entries) {
+        TraceSpan span("vault.append_entries");
         json response;
 
         if (!file.is_open()) {
@@ -250,29 +624,129 @@ public:
             return response;
         }
 
+        if (read_only) {
+            response["success"] = false;
+            response["error"] = "Vault is open read-only";
+            return response;
+        }
+
+        if (!new_entries.empty()) {
+            std::vector<Entry> batch = new_entries;
+            for (auto &entry : batch) {
+                if (entry_id(entry).is_nil()) set_entry_id(entry, new_entry_id());
+            }
+
+            VaultHeader saved = header;
+            uint64_t history_mark = log_history(HistoryOp::Append, header.entries, batch.size());
+
+            std::vector<unsigned char> sealed(batch.size() * ENCRYPTED_ENTRY_SIZE);
+            encrypt_batch(batch, sealed.data());
+
+            size_t offset = sizeof(VaultHeader) + (header.entries * ENCRYPTED_ENTRY_SIZE);
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char *>(sealed.data()), sealed.size());
+            metrics().add(Counter::VaultWriteBytes, sealed.size() + sizeof(VaultHeader));
+
+            header.entries += batch.size();
+            header.updated = std::time(nullptr);
+
+            file.seekp(0);
+            header.write(file);
+            flush_file();
+            if (!file) {
+                sodium_memzero(batch.data(), batch.size() * sizeof(Entry));
+                return abandon_write(history_mark, saved);
+            }
+
+            size_t first = header.entries - batch.size();
+            for (size_t i = 0; i < batch.size(); i++) {
+                id_slots[entry_id(batch[i])] = first + i;
+                tag_index.append(batch[i]);
+            }
+            entries.insert(entries.end(), batch.begin(), batch.end());
+            sort_index.append(entries, entries.size() - batch.size());
+            sodium_memzero(batch.data(), batch.size() * sizeof(Entry));
+            reset_changes();
+        }
+
+        response["success"] = true;
+        response["entries"] = header.entries;
+        return response;
+    }
+
+    /**
+     * @brief Replace an entry's contents; its id is kept whatever `replacement` carries
+     */
+    json modify_entry(size_t index, const Entry &replacement) {
+        json response;
+
+        if (!file.is_open()) {
+            response["success"] = false;
+            response["error"] = "No vault is open";
+            return response;
+        }
+
+        if (!authenticated) {
+            response["success"] = false;
+            response["error"] = "Not authenticated";
+            return response;
+        }
+
+        if (read_only) {
+            response["success"] = false;
+            response["error"] = "Vault is open read-only";
+            return response;
+        }
+
         if (index >= header.entries) {
             response["success"] = false;
             response["error"] = "Invalid entry index";
             return response;
         }
 
+        // Keep the version being replaced; the slot is overwritten below
+        Entry previous;
+        if (!current_entry(index, previous)) {
+            response["success"] = false;
+            response["error"] = "Failed to read entry " + std::to_string(index);
+            return response;
+        }
+        Entry entry = replacement;
+        std::memcpy(entry.Id, previous.Id, ENTRY_ID_SIZE);
+        VaultHeader saved = header;
+        uint64_t history_mark = log_history(HistoryOp::Modify, index, 0, encode_entry_delta(entry, previous));
+
         // Encrypt Entry struct (same as add_entry)
         std::vector<unsigned char> encrypted{};
-        encrypt_entry(key, entry, encrypted);
+        encrypt_timed(entry, encrypted);
 
         size_t offset = sizeof(VaultHeader) + (index * ENCRYPTED_ENTRY_SIZE);
         file.seekp(offset);
         file.write(reinterpret_cast<const char *>(encrypted.data()), encrypted.size());
+        metrics().add(Counter::VaultWriteBytes, encrypted.size() + sizeof(VaultHeader));
 
         header.updated = std::time(nullptr);
         file.seekp(0);
         header.write(file);
-        file.flush();
+        flush_file();
+        if (!file) {
+            // Put the old contents back; the slot may hold half the new ones
+            encrypt_timed(previous, encrypted);
+            sodium_memzero(&previous, sizeof(previous));
+            file.clear();
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char *>(encrypted.data()), encrypted.size());
+            return abandon_write(history_mark, saved);
+        }
+        sodium_memzero(&previous, sizeof(previous));
 
         // Update in-memory entries if loaded
         if (index < entries.size()) {
+            tag_index.update(static_cast<uint32_t>(index), entries[index], entry);
+            sort_index.update(entries, static_cast<uint32_t>(index), entry);
             entries[index] = entry;
         }
+        record_change(ChangeType::Modify, index, entry);
 
         response["success"] = true;
         response["entries"] = header.entries;
@@ -294,16 +768,31 @@ public:
             return response;
         }
 
+        if (read_only) {
+            response["success"] = false;
+            response["error"] = "Vault is open read-only";
+            return response;
+        }
+
         if (index >= header.entries) {
             response["success"] = false;
             response["error"] = "Invalid entry index";
             return response;
         }
 
-        // Remove from memory vector
-        if (index < entries.size()) {
-            entries.erase(entries.begin() + index);
+        Entry deleted;
+        if (!current_entry(index, deleted)) {
+            response["success"] = false;
+            response["error"] = "Failed to read entry " + std::to_string(index);
+            return response;
         }
+        // Only the id is kept for the change log
+        Entry removed;
+        std::memcpy(removed.Id, deleted.Id, ENTRY_ID_SIZE);
+        sodium_memzero(&deleted, sizeof(deleted));
+
+        VaultHeader saved = header;
+        uint64_t history_mark = log_history(HistoryOp::Delete, index, 0);
 
         // Shift remaining entries in the file
         for (size_t i = index; i < header.entries - 1; i++) {
@@ -319,6 +808,9 @@ public:
             file.seekp(dst_offset);
             file.write(reinterpret_cast<const char *>(buffer), ENCRYPTED_ENTRY_SIZE);
         }
+        size_t shifted = header.entries - 1 - index;
+        metrics().add(Counter::VaultReadBytes, shifted * ENCRYPTED_ENTRY_SIZE);
+        metrics().add(Counter::VaultWriteBytes, shifted * ENCRYPTED_ENTRY_SIZE + sizeof(VaultHeader));
 
         // Update header
         header.entries--;
@@ -326,18 +818,193 @@ public:
 
         file.seekp(0);
         header.write(file);
-        file.flush();
+        flush_file();
+        if (!file) return abandon_write(history_mark, saved);
+
+        // Remove from memory vector; later slots all move down one
+        if (index < entries.size()) {
+            tag_index.erase(static_cast<uint32_t>(index), entries[index]);
+            sort_index.erase(entries, static_cast<uint32_t>(index));
+            entries.erase(entries.begin() + index);
+            id_slots.erase(entry_id(removed));
+            for (auto &slot : id_slots) {
+                if (slot.second > index) slot.second--;
+            }
+        }
 
         // Truncate file to new size (optional but cleaner)
         size_t new_size = sizeof(VaultHeader) + (header.entries * ENCRYPTED_ENTRY_SIZE);
         std::filesystem::resize_file(file_path, new_size);
+        record_change(ChangeType::Delete, index, removed);
+
+        response["success"] = true;
+        response["entries"] = header.entries;
+        return response;
+    }
+
+    /**
+     * @brief Decrypt a range of entries straight from the file
+     * Used by exports, which walk the vault a chunk at a time instead of
+     * relying on (or copying) the in-memory list.
+     */
+    json read_entries(size_t first, size_t count, std::vector<Entry> &out) {
+        json response;
+        out.clear();
+
+        if (!file.is_open()) {
+            response["success"] = false;
+            response["error"] = "No vault is open";
+            return response;
+        }
+
+        if (!authenticated) {
+            response["success"] = false;
+            response["error"] = "Not authenticated";
+            return response;
+        }
+
+        if (first < header.entries) {
+            // A legacy file is only still unmigrated when opened for reading
+            size_t slot_size = legacy_format ? legacy_format->encrypted_size : ENCRYPTED_ENTRY_SIZE;
+            count = std::min(count, header.entries - first);
+            std::vector<unsigned char> sealed(count * slot_size);
+            file.clear();
+            file.seekg(sizeof(VaultHeader) + first * slot_size);
+            file.read(reinterpret_cast<char *>(sealed.data()), sealed.size());
+            metrics().add(Counter::VaultReadBytes, sealed.size());
+
+            out.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                try {
+                    ScopedTimer timer(Timer::EntryDecrypt);
+                    if (legacy_format) {
+                        decrypt_legacy_entry(key, *legacy_format, out[i], sealed.data() + i * slot_size);
+                    } else {
+                        decrypt_entry(key, out[i], sealed.data() + i * slot_size, slot_size);
+                    }
+                }
+                catch (const std::exception &e) {
+                    out.clear();
+                    response["success"] = false;
+                    response["error"] = "Failed to decrypt entry " + std::to_string(first + i) + ": " + e.what();
+                    return response;
+                }
+            }
+        }
 
         response["success"] = true;
         response["entries"] = header.entries;
         return response;
     }
 
+    /**
+     * @brief Derive an independent key from the vault key (crypto_kdf)
+     * @param context Eight bytes naming the purpose, e.g. backups
+     */
+    bool derive_subkey(uint64_t id, const char (&context)[crypto_kdf_CONTEXTBYTES], unsigned char *out,
+                       size_t out_len) const {
+        if (!authenticated) return false;
+        return crypto_kdf_derive_from_key(out, out_len, id, context, key) == 0;
+    }
+
+    /**
+     * @brief Previous versions of an entry, newest first
+     * Scans the history segment on demand; nothing is cached.
+     */
+    json entry_history(size_t index, size_t limit, std::vector<EntryVersion> &out) {
+        TraceSpan span("vault.history");
+        json response;
+        out.clear();
+
+        if (!file.is_open()) {
+            response["success"] = false;
+            response["error"] = "No vault is open";
+            return response;
+        }
+
+        if (!authenticated) {
+            response["success"] = false;
+            response["error"] = "Not authenticated";
+            return response;
+        }
+
+        Entry current;
+        if (index >= header.entries || !current_entry(index, current)) {
+            response["success"] = false;
+            response["error"] = "Invalid entry index";
+            return response;
+        }
+
+        unsigned char history_key[HISTORY_KEY_SIZE];
+        if (crypto_kdf_derive_from_key(history_key, sizeof(history_key), HISTORY_SUBKEY_ID, HISTORY_KDF_CONTEXT,
+                                       key) != 0) {
+            response["success"] = false;
+            response["error"] = "Failed to derive history key";
+            return response;
+        }
+
+        try {
+            std::vector<HistoryRecord> records;
+            history.read_all(history_key, header.salt, records);
+            entry_versions(records, index, current, limit, out);
+            for (auto &record : records) sodium_memzero(record.delta.data(), record.delta.size());
+        }
+        catch (const std::exception &e) {
+            sodium_memzero(history_key, sizeof(history_key));
+            response["success"] = false;
+            response["error"] = std::string("Failed to read history: ") + e.what();
+            return response;
+        }
+        sodium_memzero(history_key, sizeof(history_key));
+
+        response["success"] = true;
+        response["versions"] = out.size();
+        return response;
+    }
+
+    /**
+     * @brief Current slot of the entry with this id
+     * @return false if no loaded entry has it; ids are indexed by load_entries
+     */
+    bool index_of(const EntryId &id, size_t &index) const {
+        auto it = id_slots.find(id);
+        if (it == id_slots.end()) return false;
+        index = it->second;
+        return true;
+    }
+
+    size_t entry_count() const { return header.entries; }
+    std::string get_name() const { return std::string(header.name, strnlen(header.name, NAME_SIZE)); }
+
     const std::vector<Entry> &get_entries() const { return entries; }
+    const TagIndex &get_tag_index() const { return tag_index; }
+    const SortIndex &get_sort_index() const { return sort_index; }
+
+    uint64_t get_revision() const { return revision; }
+
+    // Called after every recorded mutation and reset, with the vault still locked
+    void set_change_listener(std::function<void(const EntryChange &)> listener) {
+        change_listener = std::move(listener);
+    }
+
+    /**
+     * @brief Collect mutations made after a given revision
+     * @param since Revision the caller already has
+     * @param out Changes in the order they were applied
+     * @return false if the log no longer covers `since` and a full listing is needed
+     */
+    bool changes_since(uint64_t since, std::vector<EntryChange> &out) const {
+        if (since < log_base || since > revision) {
+            return false;
+        }
+        out.clear();
+        for (const auto &change : changes) {
+            if (change.revision > since) {
+                out.push_back(change);
+            }
+        }
+        return true;
+    }
 };
 
 #endif // VAULT_VAULT_HPP
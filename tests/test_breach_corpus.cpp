@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unistd.h>
+
+#include "vault/breach_corpus.hpp"
+
+namespace {
+
+std::string hex(const Sha1Digest &hash) {
+    char out[BREACH_HEX_SIZE + 1];
+    sodium_bin2hex(out, sizeof(out), hash.data(), hash.size());
+    std::string upper(out);
+    for (auto &c : upper) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    return upper;
+}
+
+Entry make_entry(const std::string &password) {
+    Entry entry;
+    entry.setName("n");
+    entry.setPassword(password);
+    return entry;
+}
+
+// Sorted HIBP-style corpus of `random_lines` random hashes plus the given passwords
+std::string write_corpus(const std::string &name, size_t random_lines,
+                         const std::vector<std::pair<std::string, uint32_t>> &listed, const char *eol) {
+    std::mt19937_64 rng(42);
+    std::vector<std::pair<Sha1Digest, uint32_t>> rows;
+    for (size_t i = 0; i < random_lines; i++) {
+        Sha1Digest hash;
+        for (auto &b : hash) b = static_cast<unsigned char>(rng());
+        rows.push_back({hash, static_cast<uint32_t>(rng() % 100000 + 1)});
+    }
+    for (const auto &[password, count] : listed) rows.push_back({sha1(password), count});
+    std::sort(rows.begin(), rows.end());
+
+    std::string path = (std::filesystem::temp_directory_path() / (name + "_" + std::to_string(getpid()) + ".txt")).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (const auto &[hash, count] : rows) out << hex(hash) << ':' << count << eol;
+    return path;
+}
+
+} // namespace
+
+// Test SHA-1 against the FIPS 180 examples and the padding boundaries
+TEST(BreachCorpusTest, Sha1Vectors) {
+    EXPECT_EQ(hex(sha1("")), "DA39A3EE5E6B4B0D3255BFEF95601890AFD80709");
+    EXPECT_EQ(hex(sha1("abc")), "A9993E364706816ABA3E25717850C26C9CD0D89D");
+    EXPECT_EQ(hex(sha1("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+              "84983E441C3BD26EBAAE4AA1F95129E5E54670F1");
+    EXPECT_EQ(hex(sha1("password")), "5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8");
+    EXPECT_EQ(hex(sha1(std::string(1000000, 'a'))), "34AA973CD4C4DAA4F61EEB2BDBAD27316534016F");
+}
+
+// Test lookups through the prefix index and the interpolated search
+TEST(BreachCorpusTest, Lookup) {
+    std::vector<std::pair<std::string, uint32_t>> listed = {{"password", 9545824}, {"123456", 37359195},
+                                                            {"hunter2", 17043}};
+    for (const char *eol : {"\n", "\r\n"}) {
+        std::string path = write_corpus("shpd_breach", 300000, listed, eol);
+        BreachCorpus corpus;
+        corpus.open(path);
+
+        for (const auto &[password, count] : listed) EXPECT_EQ(corpus.lookup(sha1(password)), count) << password;
+        EXPECT_EQ(corpus.lookup(sha1("not in the corpus")), 0u);
+
+        // A hash one bit away from a listed one is not a match
+        Sha1Digest near = sha1("hunter2");
+        near[SHA1_SIZE - 1] ^= 1;
+        EXPECT_EQ(corpus.lookup(near), 0u);
+
+        std::vector<Entry> entries = {make_entry("hunter2"), make_entry("unlisted"), make_entry(""),
+                                      make_entry("password")};
+        std::vector<BreachHit> hits;
+        check_breached_passwords(entries, corpus, hits);
+        ASSERT_EQ(hits.size(), 2u);
+        EXPECT_EQ(hits[0].slot, 0u);
+        EXPECT_EQ(hits[0].count, 17043u);
+        EXPECT_EQ(hits[1].slot, 3u);
+
+        corpus.close();
+        std::filesystem::remove(path);
+    }
+}
+
+// Test that the first and last hashes of the file are reachable
+TEST(BreachCorpusTest, Ends) {
+    std::string path = (std::filesystem::temp_directory_path() / ("shpd_breach_ends_" + std::to_string(getpid()))).string();
+    std::ofstream(path) << std::string(40, '0') << ":3\n" << "7" << std::string(39, 'A') << ":1\n"
+                        << std::string(40, 'F') << ":5";
+
+    BreachCorpus corpus;
+    corpus.open(path);
+    Sha1Digest zero{};
+    Sha1Digest ones;
+    ones.fill(0xFF);
+    EXPECT_EQ(corpus.lookup(zero), 3u);
+    EXPECT_EQ(corpus.lookup(ones), 5u);
+    corpus.close();
+
+    std::ofstream(path, std::ios::trunc) << "not a corpus\n";
+    EXPECT_THROW(corpus.open(path), std::runtime_error);
+    EXPECT_FALSE(corpus.is_open());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "api/directory_cache.hpp"
+#include "vault/header_cache.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+class BrowseCacheTest : public ::testing::Test {
+protected:
+    std::filesystem::path root;
+
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() / ("shpd_browse_" + std::to_string(getpid()));
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(root); }
+
+    static void touch(const std::filesystem::path &path) { std::ofstream(path) << "x"; }
+
+    static struct timespec mtime_of(const std::filesystem::path &path) {
+        struct stat st;
+        EXPECT_EQ(stat(path.c_str(), &st), 0);
+        return st.st_mtim;
+    }
+
+    // Set a file's mtime; timestamps are too coarse to rely on two writes differing
+    static void set_mtime(const std::filesystem::path &path, struct timespec mtime) {
+        struct timespec times[2] = {{0, UTIME_OMIT}, mtime};
+        ASSERT_EQ(utimensat(AT_FDCWD, path.c_str(), times, 0), 0);
+    }
+
+    static void write_header(const std::filesystem::path &path, const char *name, const char *version = CURR_VERSION) {
+        VaultHeader header(name);
+        std::memcpy(header.version, version, VERSION_SIZE);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        header.write(out);
+    }
+
+    static std::vector<std::string> names(DirectoryCache &cache, const std::filesystem::path &dir) {
+        std::vector<BrowseItem> items;
+        EXPECT_TRUE(cache.list(dir.string(), items));
+        std::vector<std::string> out;
+        for (const auto &item : items) out.push_back(item.name + (item.is_dir ? "/" : ""));
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+};
+
+} // namespace
+
+// Test which entries are listed, with symlinks resolved through fstatat
+TEST_F(BrowseCacheTest, ListsDirectoriesAndVaults) {
+    std::filesystem::create_directory(root / "sub");
+    touch(root / "a.shpd");
+    touch(root / "notes.txt");
+    touch(root / ".hidden.shpd");
+    std::filesystem::create_directory_symlink(root / "sub", root / "link_dir");
+    std::filesystem::create_symlink(root / "a.shpd", root / "link.shpd");
+    std::filesystem::create_symlink(root / "missing.shpd", root / "dangling.shpd");
+
+    DirectoryCache cache;
+    EXPECT_EQ(names(cache, root), (std::vector<std::string>{"../", "a.shpd", "link.shpd", "link_dir/", "sub/"}));
+
+    std::vector<BrowseItem> items;
+    EXPECT_FALSE(cache.list((root / "absent").string(), items));
+    EXPECT_FALSE(cache.list((root / "a.shpd").string(), items));
+}
+
+// Test the fstatat fallback for filesystems that report DT_UNKNOWN
+TEST_F(BrowseCacheTest, UnknownTypeFallsBackToStat) {
+    std::filesystem::create_directory(root / "dir");
+    touch(root / "file.shpd");
+    ASSERT_EQ(mkfifo((root / "pipe.shpd").c_str(), 0600), 0);
+
+    int dirfd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    ASSERT_GE(dirfd, 0);
+    bool is_dir = false;
+    EXPECT_TRUE(browse_item_type(dirfd, "dir", DT_UNKNOWN, is_dir));
+    EXPECT_TRUE(is_dir);
+    EXPECT_TRUE(browse_item_type(dirfd, "file.shpd", DT_UNKNOWN, is_dir));
+    EXPECT_FALSE(is_dir);
+    EXPECT_FALSE(browse_item_type(dirfd, "pipe.shpd", DT_UNKNOWN, is_dir));
+    EXPECT_FALSE(browse_item_type(dirfd, "gone", DT_UNKNOWN, is_dir));
+    EXPECT_FALSE(browse_item_type(dirfd, "pipe.shpd", DT_FIFO, is_dir));
+    close(dirfd);
+}
+
+// Test that a listing is reused only while the directory mtime holds and
+// the TTL has not run out
+TEST_F(BrowseCacheTest, DirectoryMtimeAndTtl) {
+    touch(root / "a.shpd");
+    DirectoryCache cache(300ms);
+    EXPECT_EQ(names(cache, root), (std::vector<std::string>{"../", "a.shpd"}));
+
+    // Added behind the cache's back: same mtime, so the old listing is served
+    struct timespec before = mtime_of(root);
+    touch(root / "b.shpd");
+    set_mtime(root, before);
+    EXPECT_EQ(names(cache, root), (std::vector<std::string>{"../", "a.shpd"}));
+
+    // The TTL bounds how long that can last
+    std::this_thread::sleep_for(350ms);
+    EXPECT_EQ(names(cache, root), (std::vector<std::string>{"../", "a.shpd", "b.shpd"}));
+
+    // A changed mtime rereads at once
+    touch(root / "c.shpd");
+    set_mtime(root, {before.tv_sec + 1, before.tv_nsec});
+    EXPECT_EQ(names(cache, root), (std::vector<std::string>{"../", "a.shpd", "b.shpd", "c.shpd"}));
+}
+
+// Test that a different directory at the same path and mtime is not served
+// from the cache: listings are keyed on the inode too
+TEST_F(BrowseCacheTest, DirectoryReplacedAtSamePath) {
+    std::filesystem::path dir = root / "vaults";
+    std::filesystem::create_directory(dir);
+    touch(dir / "old.shpd");
+
+    DirectoryCache cache;
+    EXPECT_EQ(names(cache, dir), (std::vector<std::string>{"../", "old.shpd"}));
+
+    struct timespec mtime = mtime_of(dir);
+    std::filesystem::rename(dir, root / "moved");
+    std::filesystem::create_directory(dir);
+    touch(dir / "new.shpd");
+    set_mtime(dir, mtime);
+    EXPECT_EQ(names(cache, dir), (std::vector<std::string>{"../", "new.shpd"}));
+}
+
+// Test peek_header on valid, legacy, truncated and foreign files
+TEST_F(BrowseCacheTest, PeekHeaderRejectsShortAndForeignFiles) {
+    VaultHeader header;
+    write_header(root / "current.shpd", "Current");
+    ASSERT_TRUE(peek_header((root / "current.shpd").string(), header));
+    EXPECT_STREQ(header.name, "Current");
+
+    // Older formats share the header layout; the browser shows them too
+    write_header(root / "legacy.shpd", "Legacy", LEGACY_FORMATS[0].version);
+    ASSERT_TRUE(peek_header((root / "legacy.shpd").string(), header));
+    EXPECT_STREQ(header.name, "Legacy");
+    EXPECT_STREQ(header.version, LEGACY_FORMATS[0].version);
+
+    write_header(root / "short.shpd", "Short");
+    std::filesystem::resize_file(root / "short.shpd", sizeof(VaultHeader) - 1);
+    EXPECT_FALSE(peek_header((root / "short.shpd").string(), header));
+
+    std::ofstream(root / "empty.shpd");
+    EXPECT_FALSE(peek_header((root / "empty.shpd").string(), header));
+
+    std::ofstream(root / "foreign.shpd") << std::string(sizeof(VaultHeader), 'z');
+    EXPECT_FALSE(peek_header((root / "foreign.shpd").string(), header));
+
+    EXPECT_FALSE(peek_header((root / "missing.shpd").string(), header));
+    EXPECT_FALSE(peek_header(root.string(), header));
+}
+
+// Test that cached headers are keyed on (device, inode) and dropped when
+// the mtime or size changes
+TEST_F(BrowseCacheTest, HeaderCacheInvalidation) {
+    std::filesystem::path path = root / "v.shpd";
+    VaultHeader header;
+    write_header(path, "First");
+    ASSERT_TRUE(peek_header(path.string(), header));
+    EXPECT_STREQ(header.name, "First");
+
+    // Rewritten in place with size and mtime unchanged: the cached header stands
+    struct timespec mtime = mtime_of(path);
+    write_header(path, "Second");
+    set_mtime(path, mtime);
+    ASSERT_TRUE(peek_header(path.string(), header));
+    EXPECT_STREQ(header.name, "First");
+
+    // A new mtime is a new version
+    set_mtime(path, {mtime.tv_sec + 1, mtime.tv_nsec});
+    ASSERT_TRUE(peek_header(path.string(), header));
+    EXPECT_STREQ(header.name, "Second");
+
+    // So is a new size, even with the mtime put back
+    mtime = mtime_of(path);
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        VaultHeader("Third").write(out);
+    }
+    std::ofstream(path, std::ios::binary | std::ios::app) << "entry";
+    set_mtime(path, mtime);
+    ASSERT_TRUE(peek_header(path.string(), header));
+    EXPECT_STREQ(header.name, "Third");
+
+    // Replaced by rename with the same size and mtime: a different inode
+    write_header(root / "replacement", "Replaced");
+    std::filesystem::resize_file(root / "replacement", sizeof(VaultHeader) + 5);
+    set_mtime(root / "replacement", mtime);
+    std::filesystem::rename(root / "replacement", path);
+    ASSERT_TRUE(peek_header(path.string(), header));
+    EXPECT_STREQ(header.name, "Replaced");
+
+    // Truncated below a header after being cached
+    std::filesystem::resize_file(path, sizeof(VaultHeader) / 2);
+    set_mtime(path, mtime);
+    EXPECT_FALSE(peek_header(path.string(), header));
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+
+#include "api/change_feed.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Resident set size in bytes, from /proc/self/statm
+size_t resident_bytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+} // namespace
+
+// Test that events after the cursor are delivered in order
+TEST(ChangeFeedTest, DeliversEventsAfterCursor) {
+    ChangeFeed feed;
+    feed.publish({1, ChangeType::Add, 0, {}});
+    feed.publish({2, ChangeType::Modify, 0, {}});
+    feed.publish({3, ChangeType::Delete, 0, {}});
+
+    std::vector<ChangeEvent> events;
+    ASSERT_TRUE(feed.wait(1, 0ms, events));
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].revision, 2u);
+    EXPECT_EQ(events[0].type, ChangeType::Modify);
+    EXPECT_EQ(events[1].revision, 3u);
+    EXPECT_EQ(events[1].type, ChangeType::Delete);
+}
+
+// Test that an up-to-date subscriber times out with no events
+TEST(ChangeFeedTest, TimesOutWhenNothingNew) {
+    ChangeFeed feed;
+    feed.publish({1, ChangeType::Add, 0, {}});
+
+    std::vector<ChangeEvent> events;
+    EXPECT_TRUE(feed.wait(1, 10ms, events));
+    EXPECT_TRUE(events.empty());
+}
+
+// Test that a cursor older than the ring yields a single reset
+TEST(ChangeFeedTest, StaleCursorGetsReset) {
+    ChangeFeed feed;
+    for (uint64_t rev = 1; rev <= CHANGE_LOG_CAPACITY + 10; rev++) {
+        feed.publish({rev, ChangeType::Add, 0, {}});
+    }
+
+    std::vector<ChangeEvent> events;
+    ASSERT_TRUE(feed.wait(2, 0ms, events));
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, ChangeType::Reset);
+    EXPECT_EQ(events[0].revision, CHANGE_LOG_CAPACITY + 10);
+}
+
+// Test that a cursor ahead of the feed, as a client reconnecting after a
+// server restart sends, gets a reset at once instead of waiting
+TEST(ChangeFeedTest, CursorAheadOfFeedGetsReset) {
+    ChangeFeed feed;
+    std::vector<ChangeEvent> events;
+    ASSERT_TRUE(feed.wait(40, 10s, events));
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, ChangeType::Reset);
+    EXPECT_EQ(events[0].revision, 0u);
+
+    feed.publish({1, ChangeType::Add, 0, {}});
+    feed.publish({2, ChangeType::Modify, 0, {}});
+    auto started = std::chrono::steady_clock::now();
+    ASSERT_TRUE(feed.wait(40, 10s, events));
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 5s);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, ChangeType::Reset);
+    EXPECT_EQ(events[0].revision, 2u);
+
+    // From the reset's revision on, events flow as usual
+    feed.publish({3, ChangeType::Delete, 0, {}});
+    ASSERT_TRUE(feed.wait(events[0].revision, 0ms, events));
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].revision, 3u);
+}
+
+// Test that closing the feed releases blocked subscribers
+TEST(ChangeFeedTest, CloseWakesSubscribers) {
+    ChangeFeed feed;
+    std::atomic<bool> result{true};
+
+    std::thread subscriber([&] {
+        std::vector<ChangeEvent> events;
+        result = feed.wait(0, 10s, events);
+    });
+
+    while (feed.subscriber_count() == 0) std::this_thread::sleep_for(1ms);
+    feed.close();
+    subscriber.join();
+
+    EXPECT_FALSE(result);
+}
+
+// Fan-out to hundreds of blocked subscribers: every one must see the
+// broadcast; reports memory per subscriber and broadcast latency
+TEST(ChangeFeedTest, FanOutToManySubscribers) {
+    constexpr size_t SUBSCRIBERS = 500;
+    ChangeFeed feed;
+    feed.publish({1, ChangeType::Add, 0, {}});
+
+    std::vector<std::chrono::steady_clock::time_point> received(SUBSCRIBERS);
+    std::vector<size_t> counts(SUBSCRIBERS);
+    std::vector<std::thread> threads;
+    threads.reserve(SUBSCRIBERS);
+
+    size_t rss_before = resident_bytes();
+    for (size_t i = 0; i < SUBSCRIBERS; i++) {
+        threads.emplace_back([&, i] {
+            std::vector<ChangeEvent> events;
+            feed.wait(1, 30s, events);
+            received[i] = std::chrono::steady_clock::now();
+            counts[i] = events.size();
+        });
+    }
+    while (feed.subscriber_count() < SUBSCRIBERS) std::this_thread::sleep_for(1ms);
+    size_t rss_after = resident_bytes();
+
+    auto published = std::chrono::steady_clock::now();
+    feed.publish({2, ChangeType::Modify, 0, {}});
+    for (auto &t : threads) t.join();
+
+    double max_us = 0, total_us = 0;
+    for (size_t i = 0; i < SUBSCRIBERS; i++) {
+        EXPECT_EQ(counts[i], 1u);
+        double us = std::chrono::duration<double, std::micro>(received[i] - published).count();
+        max_us = std::max(max_us, us);
+        total_us += us;
+    }
+
+    std::cout << "subscribers = " << SUBSCRIBERS << std::endl;
+    std::cout << "RSS per subscriber (incl. thread stack) = "
+              << (rss_after > rss_before ? (rss_after - rss_before) / SUBSCRIBERS : 0) << " bytes" << std::endl;
+    std::cout << "feed state per subscriber = " << sizeof(uint64_t) << " bytes (cursor)" << std::endl;
+    std::cout << "broadcast latency mean = " << total_us / SUBSCRIBERS << " us, max = " << max_us << " us" << std::endl;
+
+    EXPECT_LT(max_us, 1e6);
+}
@@ -5,6 +5,7 @@
 #include "core/constants.hpp"
 #include "core/types.hpp"
 #include "core/entry.hpp"
+#include "core/entry_id.hpp"
 #include "crypto/encryption.hpp"
 
 class EncryptDecryptTest : public ::testing::Test {
@@ -196,6 +197,68 @@ TEST_F(EncryptDecryptTest, EntrySizeCheck) {
     std::cout << "Expected encrypted size = " << expected_encrypted_size << std::endl;
 
     EXPECT_EQ(ENCRYPTED_ENTRY_SIZE, expected_encrypted_size);
+    for (const auto &format : LEGACY_FORMATS) {
+        EXPECT_EQ(format.encrypted_size, NONCE_SIZE + format.entry_size + TAG_SIZE) << format.version;
+    }
+    EXPECT_EQ(offsetof(Entry, Id), LEGACY_FORMATS[0].entry_size) << "the id must follow the 0.1 layout";
+    EXPECT_EQ(offsetof(Entry, Folder), LEGACY_FORMATS[1].entry_size) << "folder and tags must follow the 0.2 layout";
+}
+
+// Test that entries from earlier formats still decrypt, with the missing fields zeroed
+TEST_F(EncryptDecryptTest, LegacyEntryDecrypt) {
+    Entry original;
+    original.setName("Legacy");
+    original.setPassword("old-format");
+    original.Modf_Time = 1600000000;
+    set_entry_id(original, new_entry_id());
+    original.setFolder("Work");
+
+    for (const auto &format : LEGACY_FORMATS) {
+        std::vector<unsigned char> sealed(format.encrypted_size);
+        unsigned long long clen;
+        randombytes_buf(sealed.data(), NONCE_SIZE);
+        crypto_aead_chacha20poly1305_ietf_encrypt(sealed.data() + NONCE_SIZE, &clen,
+                                                  reinterpret_cast<const unsigned char *>(&original),
+                                                  format.entry_size, nullptr, 0, nullptr, sealed.data(), key);
+
+        Entry decrypted;
+        decrypted.setTags("stale");
+        decrypt_legacy_entry(key, format, decrypted, sealed.data());
+        EXPECT_STREQ(decrypted.Name, "Legacy");
+        EXPECT_STREQ(decrypted.Password, "old-format");
+        EXPECT_EQ(decrypted.Modf_Time, 1600000000);
+        EXPECT_EQ(entry_id(decrypted).is_nil(), format.entry_size <= offsetof(Entry, Id)) << format.version;
+        EXPECT_STREQ(decrypted.Folder, "") << format.version;
+        EXPECT_STREQ(decrypted.Tags, "") << format.version;
+
+        sealed[NONCE_SIZE] ^= 1;
+        EXPECT_THROW(decrypt_legacy_entry(key, format, decrypted, sealed.data()), std::runtime_error);
+    }
+}
+
+// Test that ids survive encryption and their hex form round-trips
+TEST_F(EncryptDecryptTest, EntryIdRoundtrip) {
+    Entry original;
+    original.setName("WithId");
+    EntryId id = new_entry_id();
+    EXPECT_FALSE(id.is_nil());
+    set_entry_id(original, id);
+
+    std::vector<unsigned char> encrypted;
+    encrypt_entry(key, original, encrypted);
+    Entry decrypted;
+    decrypt_entry(key, decrypted, encrypted.data(), encrypted.size());
+    EXPECT_EQ(entry_id(decrypted), id);
+
+    std::string hex = entry_id_hex(id);
+    EXPECT_EQ(hex.size(), 2 * ENTRY_ID_SIZE);
+    EntryId parsed;
+    ASSERT_TRUE(parse_entry_id(hex, parsed));
+    EXPECT_EQ(parsed, id);
+
+    EXPECT_FALSE(parse_entry_id(hex.substr(1), parsed));
+    EXPECT_FALSE(parse_entry_id(hex.substr(2) + "zz", parsed));
+    EXPECT_FALSE(parse_entry_id(hex + "00", parsed));
 }
 
 int main(int argc, char **argv) {
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "api/entry_parser.hpp"
+
+namespace {
+
+EntryRequest parse(const std::string &body, const std::string &content_type = "application/json") {
+    httplib::Request req;
+    req.body = body;
+    req.set_header("Content-Type", content_type);
+    EntryRequest request;
+    parse_entry_request(req, request);
+    return request;
+}
+
+// Message of the exception parse() throws, or "" if it does not
+std::string parse_error(const std::string &body) {
+    try {
+        parse(body);
+    }
+    catch (const std::runtime_error &e) {
+        return e.what();
+    }
+    return "";
+}
+
+} // namespace
+
+// Test that every field lands at its offset in the Entry
+TEST(EntryParserTest, AddBody) {
+    EntryRequest request = parse(R"({"name": "Mail", "username": "alice", "url": "https://mail.example",
+                                     "password": "hunter2", "notes": "n", "folder": "Work", "tags": "a,b"})");
+
+    EXPECT_STREQ(request.entry.Name, "Mail");
+    EXPECT_STREQ(request.entry.Username, "alice");
+    EXPECT_STREQ(request.entry.Website, "https://mail.example");
+    EXPECT_STREQ(request.entry.Password, "hunter2");
+    EXPECT_STREQ(request.entry.Notes, "n");
+    EXPECT_STREQ(request.entry.Folder, "Work");
+    EXPECT_STREQ(request.entry.Tags, "a,b");
+    EXPECT_FALSE(request.has_id);
+    EXPECT_EQ(request.index, SIZE_MAX);
+}
+
+// Test edit and delete bodies addressing an entry by id or by index
+TEST(EntryParserTest, EditAndDeleteBodies) {
+    EntryId id = new_entry_id();
+    std::string hex = entry_id_hex(id);
+
+    EntryRequest edit = parse(R"({"id": ")" + hex + R"(", "name": "Renamed", "password": "pw"})");
+    EXPECT_TRUE(edit.has_id);
+    EXPECT_EQ(edit.id, id);
+    EXPECT_STREQ(edit.entry.Name, "Renamed");
+
+    EntryRequest by_index = parse(R"({"index": 7})");
+    EXPECT_FALSE(by_index.has_id);
+    EXPECT_EQ(by_index.index, 7u);
+    EXPECT_STREQ(by_index.entry.Name, "");
+
+    EntryRequest both = parse(R"({"index": 3, "id": ")" + hex + R"("})");
+    EXPECT_TRUE(both.has_id);
+    EXPECT_EQ(both.index, 3u);
+}
+
+// Test that mistyped fields are rejected with the field named
+TEST(EntryParserTest, WrongTypes) {
+    EXPECT_EQ(parse_error(R"({"name": 5})"), "Field 'name' must be a string");
+    EXPECT_EQ(parse_error(R"({"password": null})"), "Field 'password' must be a string");
+    EXPECT_EQ(parse_error(R"({"url": true})"), "Field 'url' must be a string");
+    EXPECT_EQ(parse_error(R"({"notes": 1.5})"), "Field 'notes' must be a string");
+    EXPECT_EQ(parse_error(R"({"index": -1})"), "Field 'index' must be a non-negative integer");
+    EXPECT_EQ(parse_error(R"({"index": "4"})"), "Field 'index' must be a non-negative integer");
+    EXPECT_EQ(parse_error(R"({"index": 2.0})"), "Field 'index' must be a non-negative integer");
+    EXPECT_EQ(parse_error(R"({"id": 12})"), "Field 'id' must be a string");
+    EXPECT_EQ(parse_error(R"({"id": "not-hex"})"), "Field 'id' must be a 32-digit hex id");
+    EXPECT_EQ(parse_error(R"(["name", "x"])"), "Request body must be an object");
+    EXPECT_NE(parse_error(R"({"name": "x")"), "");
+}
+
+// Test that unknown keys are skipped whatever their value
+TEST(EntryParserTest, UnknownKeys) {
+    EntryRequest request = parse(R"({"favorite": true, "name": "Site", "score": -3, "extra": null,
+                                     "Password": "wrong case", "password": "pw"})");
+    EXPECT_STREQ(request.entry.Name, "Site");
+    EXPECT_STREQ(request.entry.Password, "pw");
+}
+
+// Test that values nested under unknown keys never reach the entry, and that
+// known keys cannot hold containers
+TEST(EntryParserTest, NestedValues) {
+    EntryRequest request = parse(R"({"meta": {"name": "inner", "index": 9, "list": [{"password": "x"}]},
+                                     "name": "outer", "history": [{"name": "old"}, 1, "two"]})");
+    EXPECT_STREQ(request.entry.Name, "outer");
+    EXPECT_STREQ(request.entry.Password, "");
+    EXPECT_EQ(request.index, SIZE_MAX);
+
+    EXPECT_EQ(parse_error(R"({"name": {"first": "a"}})"), "Field 'name' must be a string");
+    EXPECT_EQ(parse_error(R"({"tags": ["a", "b"]})"), "Field 'tags' must be a string");
+    EXPECT_EQ(parse_error(R"({"index": [1]})"), "Field 'index' must be a non-negative integer");
+}
+
+// Test that over-length strings are cut to the field size with the terminator kept
+TEST(EntryParserTest, OversizeStrings) {
+    std::string long_name(ENTRY_NAME_SIZE * 2, 'n');
+    std::string long_password(ENTRY_PASSWORD_SIZE + 1, 'p');
+    EntryRequest request = parse(R"({"name": ")" + long_name + R"(", "password": ")" + long_password +
+                                 R"(", "username": "u"})");
+
+    EXPECT_EQ(strnlen(request.entry.Name, ENTRY_NAME_SIZE), ENTRY_NAME_SIZE - 1);
+    EXPECT_EQ(std::string(request.entry.Name), long_name.substr(0, ENTRY_NAME_SIZE - 1));
+    EXPECT_EQ(strnlen(request.entry.Password, ENTRY_PASSWORD_SIZE), ENTRY_PASSWORD_SIZE - 1);
+    // The neighbouring field is untouched
+    EXPECT_STREQ(request.entry.Username, "u");
+
+    // A shorter value for the same key leaves no tail of the longer one
+    request = parse(R"({"name": ")" + long_name + R"(", "name": "short"})");
+    EXPECT_STREQ(request.entry.Name, "short");
+}
+
+// Test that CBOR and MessagePack bodies go through the same handler
+TEST(EntryParserTest, BinaryBodies) {
+    json body = {{"name", "Bin"}, {"password", "pw"}, {"index", 2}};
+
+    std::vector<uint8_t> cbor = json::to_cbor(body);
+    EntryRequest from_cbor = parse(std::string(cbor.begin(), cbor.end()), "application/cbor");
+    EXPECT_STREQ(from_cbor.entry.Name, "Bin");
+    EXPECT_EQ(from_cbor.index, 2u);
+
+    std::vector<uint8_t> msgpack = json::to_msgpack(body);
+    EntryRequest from_msgpack = parse(std::string(msgpack.begin(), msgpack.end()), "application/msgpack");
+    EXPECT_STREQ(from_msgpack.entry.Password, "pw");
+    EXPECT_EQ(from_msgpack.index, 2u);
+}
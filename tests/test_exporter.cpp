@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "api/exporter.hpp"
+
+namespace {
+
+Entry make_entry(const std::string &name, const std::string &notes) {
+    Entry entry;
+    entry.setName(name);
+    entry.setUsername("user");
+    entry.setWebsite("https://example.com");
+    entry.setPassword("p\"w,1");
+    entry.setNotes(notes);
+    entry.Modf_Time = 1700000000;
+    return entry;
+}
+
+struct BackupKey {
+    unsigned char key[crypto_secretstream_xchacha20poly1305_KEYBYTES];
+    unsigned char salt[BACKUP_SALT_SIZE];
+    BackupKey() {
+        randombytes_buf(key, sizeof(key));
+        randombytes_buf(salt, sizeof(salt));
+    }
+};
+
+std::string export_all(EntryExporter &exporter, const std::vector<Entry> &entries, size_t chunk_size) {
+    std::string out = exporter.begin("Test", entries.size());
+    for (size_t i = 0; i < entries.size(); i += chunk_size) {
+        std::vector<Entry> chunk(entries.begin() + i, entries.begin() + std::min(entries.size(), i + chunk_size));
+        exporter.write_chunk(chunk, out);
+    }
+    out += exporter.finish();
+    return out;
+}
+
+// Decrypt a bundle fed in pieces of the given size; returns the plaintext
+std::string read_backup(const std::string &bundle, const BackupKey &k, size_t piece) {
+    BackupReader reader([&](const unsigned char *salt, unsigned char *key_out) {
+        EXPECT_EQ(std::memcmp(salt, k.salt, sizeof(k.salt)), 0);
+        std::memcpy(key_out, k.key, sizeof(k.key));
+    });
+    std::string plain;
+    for (size_t pos = 0; pos < bundle.size(); pos += piece) {
+        reader.feed(bundle.data() + pos, std::min(piece, bundle.size() - pos),
+                    [&](const char *data, size_t len) { plain.append(data, len); });
+    }
+    reader.finish();
+    return plain;
+}
+
+} // namespace
+
+// Test that CSV fields are quoted only when needed
+TEST(ExporterTest, CsvQuoting) {
+    EntryExporter exporter(ExportFormat::Csv);
+    std::string csv = export_all(exporter, {make_entry("Mail", "two\nlines")}, 1);
+
+    EXPECT_EQ(csv, "name,username,url,password,notes,folder,tags\r\n"
+                   "Mail,user,https://example.com,\"p\"\"w,1\",\"two\nlines\",,\r\n");
+}
+
+// Test one JSON object per line, whatever the chunking
+TEST(ExporterTest, JsonLines) {
+    std::vector<Entry> entries;
+    for (int i = 0; i < 10; i++) entries.push_back(make_entry("e" + std::to_string(i), "n"));
+
+    EntryExporter whole(ExportFormat::JsonLines);
+    EntryExporter chunked(ExportFormat::JsonLines);
+    std::string a = export_all(whole, entries, 10);
+    std::string b = export_all(chunked, entries, 3);
+    EXPECT_EQ(a, b);
+
+    std::istringstream lines(a);
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line)) {
+        json j = json::parse(line);
+        EXPECT_EQ(j["name"], "e" + std::to_string(count));
+        EXPECT_EQ(j["password"], "p\"w,1");
+        count++;
+    }
+    EXPECT_EQ(count, 10);
+}
+
+// Test that a backup decrypts to the JSON lines export, fed in any piece size
+TEST(ExporterTest, BackupRoundTrip) {
+    BackupKey k;
+    std::vector<Entry> entries;
+    for (int i = 0; i < 700; i++) entries.push_back(make_entry("e" + std::to_string(i), "notes"));
+
+    EntryExporter backup(ExportFormat::Backup, k.key, k.salt);
+    std::string bundle = export_all(backup, entries, EXPORT_CHUNK_ENTRIES);
+    ASSERT_EQ(bundle.compare(0, sizeof(BACKUP_MAGIC), BACKUP_MAGIC, sizeof(BACKUP_MAGIC)), 0);
+
+    EntryExporter plain(ExportFormat::JsonLines);
+    std::string expected = export_all(plain, entries, EXPORT_CHUNK_ENTRIES);
+
+    for (size_t piece : {1, 100, 1 << 20}) {
+        std::string decrypted = read_backup(bundle, k, piece);
+        size_t first_line = decrypted.find('\n') + 1;
+        EXPECT_EQ(json::parse(decrypted.substr(0, first_line))["entries"], 700);
+        EXPECT_EQ(decrypted.substr(first_line), expected) << "piece " << piece;
+    }
+    EXPECT_EQ(bundle.find("e699"), std::string::npos) << "entries must not appear in the clear";
+}
+
+// Test that tampering, truncation and a wrong key are all detected
+TEST(ExporterTest, BackupRejectsDamage) {
+    BackupKey k;
+    std::vector<Entry> entries(3, make_entry("x", "y"));
+    EntryExporter backup(ExportFormat::Backup, k.key, k.salt);
+    std::string bundle = export_all(backup, entries, 1);
+
+    std::string tampered = bundle;
+    tampered[BACKUP_PREFIX_SIZE + 10] ^= 1;
+    EXPECT_THROW(read_backup(tampered, k, 4096), std::runtime_error);
+
+    // Cut after the last entry message: every byte left is valid, only FINAL is missing
+    size_t final_frame = 4 + crypto_secretstream_xchacha20poly1305_ABYTES;
+    EXPECT_THROW(read_backup(bundle.substr(0, bundle.size() - final_frame), k, 4096), std::runtime_error);
+
+    BackupKey other;
+    std::memcpy(other.salt, k.salt, sizeof(k.salt));
+    EXPECT_THROW(read_backup(bundle, other, 4096), std::runtime_error);
+
+    EXPECT_THROW(read_backup(std::string(BACKUP_PREFIX_SIZE, 'x'), k, 4096), std::runtime_error);
+}
+
+// Test format names
+TEST(ExporterTest, Formats) {
+    EXPECT_EQ(export_format(""), ExportFormat::Csv);
+    EXPECT_EQ(export_format("jsonl"), ExportFormat::JsonLines);
+    EXPECT_EQ(export_format("backup"), ExportFormat::Backup);
+    EXPECT_THROW(export_format("xml"), std::runtime_error);
+    EXPECT_THROW(EntryExporter(ExportFormat::Backup), std::invalid_argument);
+}
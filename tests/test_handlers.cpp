@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "api/handlers.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// ApiHandlers behind a loopback server with the production worker pool
+class TestServer {
+public:
+    ApiHandlers handlers;
+    httplib::Server svr;
+    int port = 0;
+
+    TestServer() {
+        svr.new_task_queue = [] { return new httplib::ThreadPool(SERVER_THREAD_COUNT); };
+        svr.Get("/api/events", [this](const httplib::Request &req, httplib::Response &res) {
+            handlers.handle_events(req, res);
+        });
+        svr.Get("/api/vault/status", [this](const httplib::Request &req, httplib::Response &res) {
+            handlers.handle_vault_status(req, res);
+        });
+        port = svr.bind_to_any_port("127.0.0.1");
+        thread = std::thread([this] { svr.listen_after_bind(); });
+        svr.wait_until_ready();
+    }
+
+    ~TestServer() {
+        handlers.close_event_streams();
+        svr.stop();
+        thread.join();
+    }
+
+private:
+    std::thread thread;
+};
+
+json call(void (ApiHandlers::*handler)(const httplib::Request &, httplib::Response &), ApiHandlers &handlers,
+          const json &body = json::object()) {
+    httplib::Request req;
+    req.body = body.dump();
+    httplib::Response res;
+    (handlers.*handler)(req, res);
+    return json::parse(res.body);
+}
+
+// JSON lines for `count` importable entries
+std::string import_lines(size_t count) {
+    std::string lines;
+    for (size_t i = 0; i < count; i++) {
+        lines += json({{"name", "Entry " + std::to_string(i)}, {"password", "pw"}}).dump() + "\n";
+    }
+    return lines;
+}
+
+} // namespace
+
+// Test that open event streams stop at EVENT_MAX_STREAMS and never starve
+// the worker pool: other routes still answer, and the next stream gets a 503
+TEST(HandlersTest, EventStreamsLeaveWorkersForOtherRoutes) {
+    auto server = std::make_unique<TestServer>();
+    int port = server->port;
+
+    // Open the streams one at a time: a burst of connects overflows the
+    // listen backlog, and the retried SYNs would stall the test for seconds
+    std::atomic<size_t> opened{0};
+    std::vector<std::thread> streams;
+    for (size_t i = 0; i < EVENT_MAX_STREAMS; i++) {
+        streams.emplace_back([&opened, port] {
+            httplib::Client cli("127.0.0.1", port);
+            cli.set_read_timeout(60s);
+            cli.Get("/api/events",
+                    [&](const httplib::Response &res) {
+                        if (res.status == 200) opened++;
+                        return true;
+                    },
+                    [](const char *, size_t) { return true; });
+        });
+        auto deadline = std::chrono::steady_clock::now() + 10s;
+        while (opened <= i && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        if (opened <= i) break;
+    }
+    EXPECT_EQ(opened, EVENT_MAX_STREAMS);
+    if (opened < EVENT_MAX_STREAMS) {
+        server.reset();
+        for (auto &t : streams) t.join();
+        return;
+    }
+
+    httplib::Client cli("127.0.0.1", port);
+    cli.set_read_timeout(5s);
+    for (int i = 0; i < 20; i++) {
+        auto status = cli.Get("/api/vault/status");
+        ASSERT_TRUE(status) << httplib::to_string(status.error());
+        EXPECT_EQ(status->status, 200);
+        EXPECT_TRUE(json::parse(status->body)["success"].get<bool>());
+    }
+
+    auto refused = cli.Get("/api/events");
+    ASSERT_TRUE(refused);
+    EXPECT_EQ(refused->status, 503);
+    EXPECT_TRUE(refused->has_header("Retry-After"));
+
+    // Closing the feed ends every stream, so the clients return
+    server.reset();
+    for (auto &t : streams) t.join();
+}
+
+// Test that /metrics and /api/admin/trace answer local clients only
+TEST(HandlersTest, OperationalRoutesOnlyFromLoopback) {
+    ApiHandlers handlers;
+    for (const char *addr : {"127.0.0.1", "::1", "::ffff:127.0.0.1"}) {
+        httplib::Request req;
+        req.remote_addr = addr;
+        httplib::Response metrics_res;
+        handlers.handle_metrics(req, metrics_res);
+        EXPECT_EQ(metrics_res.status, -1) << addr;
+        EXPECT_NE(metrics_res.body.find("shpd_vault_revision"), std::string::npos) << addr;
+
+        httplib::Response trace_res;
+        handlers.handle_trace(req, trace_res);
+        EXPECT_EQ(trace_res.status, -1) << addr;
+        EXPECT_TRUE(trace_res.has_header("Content-Disposition")) << addr;
+    }
+
+    for (const char *addr : {"192.168.1.20", "10.0.0.1", "::ffff:10.0.0.1", "fe80::1", "128.0.0.1"}) {
+        httplib::Request req;
+        req.remote_addr = addr;
+        httplib::Response metrics_res;
+        handlers.handle_metrics(req, metrics_res);
+        EXPECT_EQ(metrics_res.status, 403) << addr;
+        EXPECT_EQ(metrics_res.body.find("shpd_"), std::string::npos) << addr;
+
+        httplib::Response trace_res;
+        handlers.handle_trace(req, trace_res);
+        EXPECT_EQ(trace_res.status, 403) << addr;
+        EXPECT_FALSE(trace_res.has_header("Content-Disposition")) << addr;
+    }
+}
+
+// Test that an import stops when another vault is unlocked between two
+// batches, instead of writing the rest of the file into the new vault
+TEST(HandlersTest, ImportStopsWhenVaultChanges) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / ("shpd_import_" + std::to_string(getpid()));
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::string first = (dir / "first.shpd").string();
+    std::string second = (dir / "second.shpd").string();
+
+    ApiHandlers handlers;
+    ASSERT_TRUE(call(&ApiHandlers::handle_create_vault, handlers, {{"path", first}, {"password", "pw"}})["success"]);
+
+    std::vector<std::string> chunks = {import_lines(IMPORT_BATCH_SIZE), import_lines(10)};
+    httplib::ContentReader reader(
+        [&](httplib::ContentReceiver receiver) {
+            if (!receiver(chunks[0].data(), chunks[0].size())) return false;
+            // The first batch is in; switch vaults under the import
+            call(&ApiHandlers::handle_close_vault, handlers);
+            call(&ApiHandlers::handle_create_vault, handlers, {{"path", second}, {"password", "pw"}});
+            return receiver(chunks[1].data(), chunks[1].size());
+        },
+        nullptr);
+
+    httplib::Request req;
+    req.params.emplace("format", "jsonl");
+    httplib::Response res;
+    handlers.handle_import_entries(req, res, reader);
+    json response = json::parse(res.body);
+    EXPECT_FALSE(response["success"]);
+    EXPECT_NE(response["error"].get<std::string>().find("vault changed during import"), std::string::npos);
+    EXPECT_EQ(response["imported"], IMPORT_BATCH_SIZE);
+
+    json loaded = call(&ApiHandlers::handle_load_data, handlers);
+    ASSERT_TRUE(loaded["success"]);
+    EXPECT_EQ(loaded["entries"], 0);
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "vault/history.hpp"
+
+namespace {
+
+Entry make_entry(const std::string &name, const std::string &password) {
+    Entry entry;
+    entry.setName(name);
+    entry.setUsername("user@example.com");
+    entry.setPassword(password);
+    entry.setNotes("notes");
+    entry.Modf_Time = 1700000000;
+    return entry;
+}
+
+HistoryRecord modify(uint64_t index, const Entry &after, const Entry &before) {
+    return {HistoryOp::Modify, index, 0, 0, encode_entry_delta(after, before)};
+}
+
+HistoryRecord marker(HistoryOp op, uint64_t index, uint64_t count = 0) {
+    return {op, index, count, 0, {}};
+}
+
+} // namespace
+
+// Test that a delta turns either version into the other and stays small
+TEST(HistoryTest, DeltaRoundTrip) {
+    Entry before = make_entry("GitHub", "old-password");
+    Entry after = before;
+    after.setPassword("a-much-longer-new-password");
+
+    std::string delta = encode_entry_delta(after, before);
+    EXPECT_LT(delta.size(), 40u) << "only the password bytes differ";
+
+    Entry restored = after;
+    apply_entry_delta(restored, delta);
+    EXPECT_EQ(std::memcmp(&restored, &before, sizeof(Entry)), 0);
+    apply_entry_delta(restored, delta);
+    EXPECT_EQ(std::memcmp(&restored, &after, sizeof(Entry)), 0);
+
+    EXPECT_TRUE(encode_entry_delta(after, after).empty());
+    EXPECT_THROW(apply_entry_delta(restored, std::string("\xff\xff\x01\x00x", 5)), std::runtime_error);
+}
+
+// Test that versions are followed back through index shifts from deletes
+TEST(HistoryTest, FollowsIndexThroughDeletes) {
+    Entry v1 = make_entry("b", "p1");
+    Entry v2 = make_entry("b", "p2");
+    Entry v3 = make_entry("b", "p3");
+    Entry other = make_entry("c", "x");
+
+    std::vector<HistoryRecord> records = {
+        marker(HistoryOp::Append, 0, 3), // a, b, c imported
+        modify(1, v2, v1),
+        modify(2, other, make_entry("c", "w")),
+        marker(HistoryOp::Delete, 0), // a deleted: b moves to 0, c to 1
+        modify(0, v3, v2),
+    };
+
+    std::vector<EntryVersion> versions;
+    entry_versions(records, 0, v3, SIZE_MAX, versions);
+    ASSERT_EQ(versions.size(), 2u);
+    EXPECT_STREQ(versions[0].entry.Password, "p2");
+    EXPECT_STREQ(versions[1].entry.Password, "p1");
+
+    entry_versions(records, 0, v3, 1, versions);
+    EXPECT_EQ(versions.size(), 1u);
+
+    entry_versions(records, 1, other, SIZE_MAX, versions);
+    ASSERT_EQ(versions.size(), 1u);
+    EXPECT_STREQ(versions[0].entry.Password, "w");
+}
+
+// Test that history stops at the append that created the entry
+TEST(HistoryTest, StopsAtCreation) {
+    Entry first = make_entry("a", "1");
+    Entry second = make_entry("a", "2");
+    Entry reused = make_entry("z", "9");
+
+    // Slot 0 held "a", which was deleted; "z" was appended later and then
+    // shifted down into slot 0. Edits of "a" must not show up as "z"'s history.
+    std::vector<HistoryRecord> records = {
+        marker(HistoryOp::Append, 0, 1),
+        modify(0, second, first),
+        marker(HistoryOp::Append, 1, 1),
+        marker(HistoryOp::Delete, 0),
+    };
+
+    std::vector<EntryVersion> versions;
+    entry_versions(records, 0, reused, SIZE_MAX, versions);
+    EXPECT_TRUE(versions.empty());
+}
+
+// Test that records survive the encrypted segment and tampering is caught
+TEST(HistoryTest, SegmentRoundTrip) {
+    std::string vault_path = (std::filesystem::temp_directory_path() /
+                              ("shpd_history_" + std::to_string(getpid()) + ".shpd")).string();
+    unsigned char key[HISTORY_KEY_SIZE];
+    randombytes_buf(key, sizeof(key));
+    unsigned char salt[SALT_SIZE];
+    randombytes_buf(salt, sizeof(salt));
+
+    Entry before = make_entry("n", "secret-one");
+    Entry after = make_entry("n", "secret-two");
+
+    HistoryLog log;
+    log.attach(vault_path, true);
+    log.append(key, salt, {HistoryOp::Append, 0, 1, 1700000000, {}});
+    log.append(key, salt, {HistoryOp::Modify, 0, 0, 1700000100, encode_entry_delta(after, before)});
+    log.close();
+
+    std::vector<HistoryRecord> records;
+    log.read_all(key, salt, records);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].op, HistoryOp::Modify);
+    EXPECT_EQ(records[1].time, 1700000100);
+
+    std::vector<EntryVersion> versions;
+    entry_versions(records, 0, after, SIZE_MAX, versions);
+    ASSERT_EQ(versions.size(), 1u);
+    EXPECT_STREQ(versions[0].entry.Password, "secret-one");
+
+    std::string raw;
+    {
+        std::ifstream in(log.segment_path(), std::ios::binary);
+        raw.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    EXPECT_EQ(raw.find("secret"), std::string::npos);
+
+    raw[raw.size() - 1] ^= 1;
+    std::ofstream(log.segment_path(), std::ios::binary | std::ios::trunc) << raw;
+    EXPECT_THROW(log.read_all(key, salt, records), std::runtime_error);
+
+    // A record cut short by a crash is ignored rather than fatal
+    std::ofstream(log.segment_path(), std::ios::binary | std::ios::trunc) << raw.substr(0, raw.size() - 5);
+    log.read_all(key, salt, records);
+    EXPECT_EQ(records.size(), 1u);
+
+    std::filesystem::remove(log.segment_path());
+}
+
+// Test that records are bound to the vault's salt, and that a record can be
+// cut off again when its change never reaches the vault file
+TEST(HistoryTest, BoundToVaultAndUndoable) {
+    std::string vault_path = (std::filesystem::temp_directory_path() /
+                              ("shpd_history_bound_" + std::to_string(getpid()) + ".shpd")).string();
+    unsigned char key[HISTORY_KEY_SIZE];
+    randombytes_buf(key, sizeof(key));
+    unsigned char salt[SALT_SIZE];
+    randombytes_buf(salt, sizeof(salt));
+
+    HistoryLog log;
+    log.attach(vault_path, true);
+    EXPECT_EQ(log.end(), 0u);
+    log.append(key, salt, marker(HistoryOp::Append, 0, 2));
+    uint64_t mark = log.end();
+    log.append(key, salt, marker(HistoryOp::Delete, 1));
+    log.truncate(mark);
+    EXPECT_EQ(log.end(), mark);
+    log.append(key, salt, marker(HistoryOp::Delete, 0));
+    log.close();
+
+    std::vector<HistoryRecord> records;
+    log.read_all(key, salt, records);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].op, HistoryOp::Delete);
+    EXPECT_EQ(records[1].index, 0u);
+
+    // The same segment beside a vault with another salt
+    unsigned char other_salt[SALT_SIZE];
+    std::memcpy(other_salt, salt, sizeof(salt));
+    other_salt[0] ^= 1;
+    EXPECT_THROW(log.read_all(key, other_salt, records), std::runtime_error);
+
+    std::filesystem::remove(log.segment_path());
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "api/importer.hpp"
+
+namespace {
+
+// Feed the input in chunks of the given size, as a streamed body would arrive
+json import_chunked(ImportFormat format, const std::string &input, size_t chunk, std::vector<Entry> &out,
+                    size_t *batches = nullptr) {
+    EntryImporter importer(format, [&](const std::vector<Entry> &batch) {
+        out.insert(out.end(), batch.begin(), batch.end());
+        if (batches) (*batches)++;
+    });
+    for (size_t pos = 0; pos < input.size(); pos += chunk) {
+        importer.feed(input.data() + pos, std::min(chunk, input.size() - pos));
+    }
+    importer.finish();
+    return importer.report();
+}
+
+} // namespace
+
+// Test quoted fields with commas, doubled quotes and newlines, split at every byte
+TEST(ImporterTest, CsvQuotedFieldsAcrossChunks) {
+    std::string csv = "\xEF\xBB\xBFname,url,username,password,note\r\n"
+                      "Mail,https://mail.example,alice,\"p,w\"\"1\",\"line one\r\nline two\"\r\n"
+                      "\r\n"
+                      "Bank,,bob,hunter2,";
+
+    for (size_t chunk : {1, 3, 7, 4096}) {
+        std::vector<Entry> entries;
+        json report = import_chunked(ImportFormat::Csv, csv, chunk, entries);
+
+        ASSERT_EQ(entries.size(), 2u) << "chunk " << chunk;
+        EXPECT_EQ(report["layout"], "chrome");
+        EXPECT_STREQ(entries[0].Name, "Mail");
+        EXPECT_STREQ(entries[0].Password, "p,w\"1");
+        EXPECT_STREQ(entries[0].Notes, "line one\r\nline two");
+        EXPECT_STREQ(entries[1].Name, "Bank");
+        EXPECT_STREQ(entries[1].Username, "bob");
+        EXPECT_STREQ(entries[1].Website, "");
+    }
+}
+
+// Test that the common exporter layouts map onto entry fields
+TEST(ImporterTest, DetectsLayouts) {
+    struct Case {
+        std::string csv;
+        const char *layout;
+    };
+    std::vector<Case> cases = {
+        {"folder,favorite,type,name,notes,fields,reprompt,login_uri,login_username,login_password,login_totp\n"
+         ",,login,Site,n,,,https://s,u,p,\n",
+         "bitwarden"},
+        {"\"Group\",\"Title\",\"Username\",\"Password\",\"URL\",\"Notes\"\n\"Root\",\"Site\",\"u\",\"p\",\"https://s\",\"n\"\n",
+         "keepassxc"},
+        {"\"Account\",\"Login Name\",\"Password\",\"Web Site\",\"Comments\"\n\"Site\",\"u\",\"p\",\"https://s\",\"n\"\n",
+         "keepass"},
+    };
+
+    for (const auto &c : cases) {
+        std::vector<Entry> entries;
+        json report = import_chunked(ImportFormat::Csv, c.csv, 4096, entries);
+
+        EXPECT_EQ(report["layout"], c.layout);
+        ASSERT_EQ(entries.size(), 1u) << c.layout;
+        EXPECT_STREQ(entries[0].Name, "Site");
+        EXPECT_STREQ(entries[0].Username, "u");
+        EXPECT_STREQ(entries[0].Password, "p");
+        EXPECT_STREQ(entries[0].Website, "https://s");
+        EXPECT_STREQ(entries[0].Notes, "n");
+        EXPECT_STREQ(entries[0].Folder, std::string(c.layout) == "keepassxc" ? "Root" : "");
+    }
+}
+
+// Test that invalid records are rejected with the line they start on
+TEST(ImporterTest, RejectsInvalidRecords) {
+    std::string csv = "name,password,notes\n"
+                      "ok,pw,\"two\nlines\"\n"
+                      ",missing-name,\n"
+                      "long," + std::string(ENTRY_PASSWORD_SIZE, 'x') + ",\n"
+                      "fine,pw,\n";
+
+    std::vector<Entry> entries;
+    json report = import_chunked(ImportFormat::Csv, csv, 5, entries);
+
+    EXPECT_EQ(report["imported"], 2);
+    EXPECT_EQ(report["rejected"], 2);
+    ASSERT_EQ(report["errors"].size(), 2u);
+    EXPECT_EQ(report["errors"][0]["line"], 4);
+    EXPECT_EQ(report["errors"][0]["error"], "Missing required field: name");
+    EXPECT_EQ(report["errors"][1]["line"], 5);
+}
+
+// Test JSON lines, including blank lines, bad JSON and a missing final newline
+TEST(ImporterTest, JsonLines) {
+    std::string input = "{\"title\":\"A\",\"password\":\"x\",\"url\":\"https://a\"}\n"
+                        "\n"
+                        "not json\n"
+                        "{\"name\":\"B\",\"password\":5}\n"
+                        "{\"name\":\"C\",\"login_password\":\"y\",\"extra\":[1]}";
+
+    std::vector<Entry> entries;
+    json report = import_chunked(ImportFormat::JsonLines, input, 2, entries);
+
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_STREQ(entries[0].Website, "https://a");
+    EXPECT_STREQ(entries[1].Password, "y");
+    EXPECT_EQ(report["rejected"], 2);
+    EXPECT_EQ(report["errors"][0]["line"], 3);
+    EXPECT_EQ(report["errors"][1]["line"], 4);
+}
+
+// Test that entries reach the sink in bounded batches
+TEST(ImporterTest, BatchesAreBounded) {
+    std::string csv = "name,password\n";
+    size_t rows = IMPORT_BATCH_SIZE * 2 + 10;
+    for (size_t i = 0; i < rows; i++) {
+        csv += "entry" + std::to_string(i) + ",pw\n";
+    }
+
+    std::vector<Entry> entries;
+    size_t batches = 0;
+    json report = import_chunked(ImportFormat::Csv, csv, 1000, entries, &batches);
+
+    EXPECT_EQ(report["imported"], rows);
+    EXPECT_EQ(batches, 3u);
+    EXPECT_STREQ(entries.back().Name, ("entry" + std::to_string(rows - 1)).c_str());
+}
+
+// Test that malformed input fails instead of buffering without bound
+TEST(ImporterTest, MalformedInput) {
+    std::vector<Entry> entries;
+    EXPECT_THROW(import_chunked(ImportFormat::Csv, "name,password\n\"open,pw\n", 4096, entries), std::runtime_error);
+    EXPECT_THROW(import_chunked(ImportFormat::Csv, "a,b,c\n1,2,3\n", 4096, entries), std::runtime_error);
+
+    std::string huge = "name,password\n\"" + std::string(IMPORT_MAX_RECORD_SIZE + 1, 'x');
+    EXPECT_THROW(import_chunked(ImportFormat::Csv, huge, 4096, entries), std::runtime_error);
+
+    EXPECT_EQ(import_format("", "application/x-ndjson"), ImportFormat::JsonLines);
+    EXPECT_EQ(import_format("csv", "application/x-ndjson"), ImportFormat::Csv);
+    EXPECT_THROW(import_format("xml", ""), std::runtime_error);
+}
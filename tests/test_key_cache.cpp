@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "vault/key_cache.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+VaultIdentity make_identity(ino_t ino, unsigned char salt_byte) {
+    VaultIdentity identity{};
+    identity.dev = 1;
+    identity.ino = ino;
+    std::memset(identity.salt, salt_byte, sizeof(identity.salt));
+    return identity;
+}
+
+} // namespace
+
+// Test that the right token unlocks the key and a wrong one does not
+TEST(KeyCacheTest, TokenUnlocksCachedKey) {
+    KeyCache cache(60s);
+    VaultIdentity identity = make_identity(42, 0xAA);
+    unsigned char key[KEY_CACHE_KEY_SIZE];
+    randombytes_buf(key, sizeof(key));
+
+    std::string token;
+    cache.store(identity, key, token);
+    ASSERT_EQ(token.size(), KEY_CACHE_TOKEN_SIZE * 2);
+
+    unsigned char out[KEY_CACHE_KEY_SIZE] = {};
+    ASSERT_TRUE(cache.lookup(identity, token, out));
+    EXPECT_EQ(std::memcmp(out, key, sizeof(key)), 0);
+
+    std::string wrong = token;
+    wrong[0] = wrong[0] == '0' ? '1' : '0';
+    EXPECT_FALSE(cache.lookup(identity, wrong, out));
+    EXPECT_FALSE(cache.lookup(identity, "not-hex", out));
+}
+
+// Test that a token is bound to the file and salt it was issued for
+TEST(KeyCacheTest, TokenIsBoundToVaultIdentity) {
+    KeyCache cache(60s);
+    unsigned char key[KEY_CACHE_KEY_SIZE] = {1};
+    std::string token;
+    cache.store(make_identity(42, 0xAA), key, token);
+
+    unsigned char out[KEY_CACHE_KEY_SIZE];
+    EXPECT_FALSE(cache.lookup(make_identity(43, 0xAA), token, out)) << "other inode";
+    EXPECT_FALSE(cache.lookup(make_identity(42, 0xBB), token, out)) << "vault recreated with a new salt";
+}
+
+// Test that a new unlock of the same vault revokes the previous token
+TEST(KeyCacheTest, NewUnlockReplacesToken) {
+    KeyCache cache(60s);
+    VaultIdentity identity = make_identity(7, 0x11);
+    unsigned char key[KEY_CACHE_KEY_SIZE] = {2};
+
+    std::string first, second;
+    cache.store(identity, key, first);
+    cache.store(identity, key, second);
+
+    unsigned char out[KEY_CACHE_KEY_SIZE];
+    EXPECT_FALSE(cache.lookup(identity, first, out));
+    EXPECT_TRUE(cache.lookup(identity, second, out));
+}
+
+// Test that keys are gone once the TTL has passed
+TEST(KeyCacheTest, ExpiresAfterTtl) {
+    KeyCache cache(1s);
+    VaultIdentity identity = make_identity(9, 0x22);
+    unsigned char key[KEY_CACHE_KEY_SIZE] = {3};
+    std::string token;
+    cache.store(identity, key, token);
+
+    std::this_thread::sleep_for(1100ms);
+    unsigned char out[KEY_CACHE_KEY_SIZE];
+    EXPECT_FALSE(cache.lookup(identity, token, out));
+}
+
+// Test that a zero TTL disables caching entirely
+TEST(KeyCacheTest, DisabledByDefault) {
+    KeyCache cache(0s);
+    unsigned char key[KEY_CACHE_KEY_SIZE] = {4};
+    std::string token;
+    cache.store(make_identity(1, 0x33), key, token);
+
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_TRUE(token.empty());
+}
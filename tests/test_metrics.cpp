@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "metrics/trace.hpp"
+
+namespace {
+
+// Value of one exposition line, e.g. `name{labels} 42`
+double sample_value(const std::string &text, const std::string &series) {
+    size_t pos = text.find(series + " ");
+    if (pos == std::string::npos) return -1;
+    return std::stod(text.substr(pos + series.size() + 1));
+}
+
+} // namespace
+
+// Test that every duration lands in a bucket whose bounds contain it
+TEST(MetricsTest, BucketBoundsContainValue) {
+    for (uint64_t ns : {0ull, 1ull, 1023ull, 1024ull, 1279ull, 1280ull, 5000ull, 999999ull, 123456789ull}) {
+        size_t bucket = histogram_bucket(ns);
+        ASSERT_LT(bucket, HISTOGRAM_BUCKETS - 1);
+        EXPECT_LT(ns, histogram_bucket_limit(bucket)) << ns;
+        if (bucket > 0) {
+            EXPECT_GE(ns, histogram_bucket_limit(bucket - 1)) << ns;
+        }
+    }
+    EXPECT_EQ(histogram_bucket(uint64_t{1} << HISTOGRAM_MAX_EXP), HISTOGRAM_BUCKETS - 1);
+}
+
+// Test that bucket limits increase strictly
+TEST(MetricsTest, BucketLimitsAreMonotonic) {
+    for (size_t i = 1; i + 1 < HISTOGRAM_BUCKETS; i++) {
+        EXPECT_GT(histogram_bucket_limit(i), histogram_bucket_limit(i - 1));
+    }
+}
+
+// Test that samples recorded on many threads are all counted in a scrape
+TEST(MetricsTest, AggregatesAcrossThreads) {
+    const std::string route = "/api/entries/delete";
+    const std::string series = "shpd_http_request_duration_seconds_count{route=\"" + route + "\"}";
+    double before = sample_value(metrics().render(), series);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; i++) {
+                metrics().record_request(metric_route_index(route), 200, std::chrono::microseconds{100});
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    EXPECT_EQ(sample_value(metrics().render(), series), before + 8000);
+}
+
+// Test that unknown paths share one label value
+TEST(MetricsTest, UnknownRoutesAreGrouped) {
+    EXPECT_EQ(metric_route_index("/no/such/route"), METRIC_ROUTES.size() - 1);
+    EXPECT_EQ(metric_route_index(""), METRIC_ROUTES.size() - 1);
+    EXPECT_EQ(METRIC_ROUTES[metric_route_index("/api/entries")], "/api/entries");
+}
+
+// Test that spans from several threads come back as Chrome trace events
+TEST(TraceTest, RendersSpansFromAllThreads) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([] {
+            TraceSpan outer("test.outer");
+            TraceSpan inner("test.inner");
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    json trace = json::parse(tracer().render_chrome_trace());
+    size_t outer = 0;
+    size_t inner = 0;
+    for (const auto &event : trace["traceEvents"]) {
+        EXPECT_EQ(event["ph"], "X");
+        if (event["name"] == "test.outer") outer++;
+        if (event["name"] == "test.inner") inner++;
+    }
+    EXPECT_EQ(outer, 4u);
+    EXPECT_EQ(inner, 4u);
+}
+
+// Test that a full ring keeps only the most recent spans
+TEST(TraceTest, RingKeepsNewestSpans) {
+    std::thread([] {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < TRACE_RING_CAPACITY + 10; i++) {
+            tracer().record(i < 10 ? "test.evicted" : "test.kept", start, start);
+        }
+    }).join();
+
+    json trace = json::parse(tracer().render_chrome_trace());
+    size_t evicted = 0;
+    size_t kept = 0;
+    for (const auto &event : trace["traceEvents"]) {
+        if (event["name"] == "test.evicted") evicted++;
+        if (event["name"] == "test.kept") kept++;
+    }
+    EXPECT_EQ(evicted, 0u);
+    EXPECT_EQ(kept, TRACE_RING_CAPACITY);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "vault/password_audit.hpp"
+
+namespace {
+
+Entry make_entry(const std::string &name, const std::string &password) {
+    Entry entry;
+    entry.setName(name);
+    entry.setPassword(password);
+    return entry;
+}
+
+} // namespace
+
+// Test that common variations reduce to one stem
+TEST(PasswordAuditTest, Normalize) {
+    EXPECT_EQ(normalize_password("P@ssw0rd1"), "password");
+    EXPECT_EQ(normalize_password("password!"), "password");
+    EXPECT_EQ(normalize_password("Summer2024!"), "summer");
+    EXPECT_EQ(normalize_password("$ummer-2023"), "summer");
+    EXPECT_EQ(normalize_password("123456"), "");
+    EXPECT_EQ(normalize_password(""), "");
+}
+
+// Test that identical passwords group as reuse and variants as similar
+TEST(PasswordAuditTest, Groups) {
+    unsigned char key[AUDIT_KEY_SIZE];
+    randombytes_buf(key, sizeof(key));
+
+    std::vector<Entry> entries = {
+        make_entry("a", "Summer2024!"),  // 0
+        make_entry("b", "hunter2-unique"),
+        make_entry("c", "Summer2024!"),  // 2: same as 0
+        make_entry("d", "summer2023"),   // 3: similar to 0 and 2
+        make_entry("e", ""),             // not checked
+        make_entry("f", "Summer2024!"),  // 5: same as 0
+        make_entry("g", "123456"),       // stem too short to be similar
+        make_entry("h", "654321"),
+        make_entry("i", "correct horse"), // 8
+        make_entry("j", "correct horse"), // 9: reused but no different variant
+    };
+
+    ReuseReport report;
+    audit_password_reuse(entries, key, report);
+    EXPECT_EQ(report.checked, 9u);
+
+    ASSERT_EQ(report.reused.size(), 2u);
+    EXPECT_EQ(report.reused[0], (ReuseGroup{0, 2, 5})) << "largest group first";
+    EXPECT_EQ(report.reused[1], (ReuseGroup{8, 9}));
+
+    ASSERT_EQ(report.similar.size(), 1u);
+    EXPECT_EQ(report.similar[0], (ReuseGroup{0, 2, 3, 5}));
+}
+
+// Test that the parallel pass finds the same groups across thread boundaries
+TEST(PasswordAuditTest, ParallelMatchesSerial) {
+    unsigned char key[AUDIT_KEY_SIZE];
+    randombytes_buf(key, sizeof(key));
+
+    std::vector<Entry> entries;
+    for (int i = 0; i < 10000; i++) {
+        entries.push_back(make_entry(std::to_string(i), "pw-" + std::to_string(i % 1000)));
+    }
+
+    ReuseReport report;
+    audit_password_reuse(entries, key, report);
+    EXPECT_EQ(report.checked, entries.size());
+    ASSERT_EQ(report.reused.size(), 1000u);
+    for (const auto &group : report.reused) {
+        ASSERT_EQ(group.size(), 10u);
+        for (uint32_t slot : group) EXPECT_EQ(slot % 1000, group.front());
+    }
+    EXPECT_TRUE(report.similar.empty()) << "\"pw\" is below the stem minimum";
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+
+#include "crypto/password_generator.hpp"
+
+// Test that passwords have the requested length and every selected class
+TEST(PasswordGeneratorTest, Password) {
+    RandomSampler random;
+    Alphabet alphabet(CHARS_DEFAULT);
+    EXPECT_EQ(alphabet.symbols.size(), 88u);
+
+    std::set<std::string> seen;
+    for (int i = 0; i < 1000; i++) {
+        std::string password = generate_password(alphabet, 8, random);
+        ASSERT_EQ(password.size(), 8u);
+        EXPECT_TRUE(std::any_of(password.begin(), password.end(), ::isupper));
+        EXPECT_TRUE(std::any_of(password.begin(), password.end(), ::islower));
+        EXPECT_TRUE(std::any_of(password.begin(), password.end(), ::isdigit));
+        EXPECT_TRUE(std::any_of(password.begin(), password.end(), ::ispunct));
+        seen.insert(password);
+    }
+    EXPECT_EQ(seen.size(), 1000u);
+
+    Alphabet digits(char_class("digits"));
+    std::string pin = generate_password(digits, 6, random);
+    EXPECT_TRUE(std::all_of(pin.begin(), pin.end(), ::isdigit));
+
+    EXPECT_THROW(generate_password(alphabet, 3, random), std::runtime_error) << "four classes need four characters";
+    EXPECT_THROW(generate_password(alphabet, GENERATED_MAX_BYTES + 1, random), std::runtime_error);
+    EXPECT_THROW(Alphabet{0}, std::runtime_error);
+    EXPECT_THROW(char_class("emoji"), std::runtime_error);
+}
+
+// Test that multi-byte characters count as one and stay within an entry
+TEST(PasswordGeneratorTest, Extended) {
+    RandomSampler random;
+    Alphabet alphabet(CHARS_EXTENDED);
+    EXPECT_EQ(alphabet.symbols.size(), 29u);
+    EXPECT_EQ(alphabet.max_symbol_bytes, 2u);
+
+    std::string password = generate_password(alphabet, alphabet.max_length(), random);
+    EXPECT_EQ(password.size(), alphabet.max_length() * 2);
+    EXPECT_LE(password.size(), GENERATED_MAX_BYTES);
+    EXPECT_THROW(generate_password(alphabet, alphabet.max_length() + 1, random), std::runtime_error);
+}
+
+// Test that small and word-list bounds are sampled without bias
+TEST(PasswordGeneratorTest, Uniform) {
+    RandomSampler random;
+    constexpr int DRAWS = 300000;
+
+    // 256 % 3 != 0: a plain modulo would favour 0 by about 0.4%
+    std::map<uint32_t, int> counts;
+    for (int i = 0; i < DRAWS; i++) counts[random.uniform(3)]++;
+    ASSERT_EQ(counts.size(), 3u);
+    double chi2 = 0;
+    for (const auto &[value, count] : counts) {
+        double expected = DRAWS / 3.0;
+        chi2 += (count - expected) * (count - expected) / expected;
+    }
+    EXPECT_LT(chi2, 13.8) << "p < 0.001 for 2 degrees of freedom";
+
+    std::vector<int> words(PASSPHRASE_WORD_COUNT);
+    for (int i = 0; i < DRAWS; i++) words[random.uniform(PASSPHRASE_WORD_COUNT)]++;
+    EXPECT_GT(*std::min_element(words.begin(), words.end()), 0);
+    EXPECT_LT(random.uniform(100000), 100000u);
+}
+
+// Test passphrase shape and limits
+TEST(PasswordGeneratorTest, Passphrase) {
+    RandomSampler random;
+    std::set<std::string_view> words(PASSPHRASE_WORDS.begin(), PASSPHRASE_WORDS.end());
+    EXPECT_EQ(words.size(), PASSPHRASE_WORD_COUNT) << "words must be distinct";
+
+    std::string phrase = generate_passphrase(6, "-", false, random);
+    size_t parts = 0;
+    for (size_t start = 0; start <= phrase.size(); parts++) {
+        size_t dash = std::min(phrase.find('-', start), phrase.size());
+        EXPECT_TRUE(words.count(std::string_view(phrase).substr(start, dash - start)));
+        start = dash + 1;
+    }
+    EXPECT_EQ(parts, 6u);
+
+    std::string capital = generate_passphrase(3, " ", true, random);
+    EXPECT_TRUE(std::isupper(static_cast<unsigned char>(capital[0])));
+
+    EXPECT_LE(generate_passphrase(passphrase_max_words("--"), "--", true, random).size(), GENERATED_MAX_BYTES);
+    EXPECT_THROW(generate_passphrase(passphrase_max_words("-") + 1, "-", false, random), std::runtime_error);
+    EXPECT_THROW(generate_passphrase(0, "-", false, random), std::runtime_error);
+    EXPECT_THROW(generate_passphrase(3, "----", false, random), std::runtime_error);
+}
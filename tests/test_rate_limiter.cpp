@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <ctime>
+
+#include "api/rate_limiter.hpp"
+
+namespace {
+
+using Clock = RateLimiter::Clock;
+
+constexpr RateLimitPolicy TEST_POLICY{3, 10s, 1s, 60s};
+
+bool admitted(RateLimiter &limiter, const std::string &key, Clock::time_point now) {
+    if (limiter.retry_after(key, now) > Clock::duration::zero()) return false;
+    limiter.take(key, now);
+    return true;
+}
+
+} // namespace
+
+// Test that a key gets its burst, then one attempt per refill interval
+TEST(RateLimiterTest, BurstThenRefill) {
+    auto t0 = Clock::now();
+    RateLimiter limiter(TEST_POLICY, t0);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(admitted(limiter, "a", t0));
+    }
+    EXPECT_FALSE(admitted(limiter, "a", t0));
+    EXPECT_TRUE(admitted(limiter, "b", t0)) << "keys are independent";
+
+    EXPECT_FALSE(admitted(limiter, "a", t0 + 9s));
+    EXPECT_TRUE(admitted(limiter, "a", t0 + 10s));
+    EXPECT_FALSE(admitted(limiter, "a", t0 + 10s));
+}
+
+// Test that each failure doubles the lockout up to the cap, and success clears it
+TEST(RateLimiterTest, ExponentialBackoff) {
+    auto t0 = Clock::now();
+    RateLimiter limiter({100, 1s, 1s, 8s}, t0);
+
+    auto now = t0;
+    for (auto expected : {1s, 2s, 4s, 8s, 8s}) {
+        limiter.take("a", now);
+        limiter.record_result("a", false, now);
+        EXPECT_EQ(std::chrono::ceil<std::chrono::seconds>(limiter.retry_after("a", now)), expected);
+        now += expected;
+    }
+
+    limiter.take("a", now);
+    limiter.record_result("a", true, now);
+    EXPECT_EQ(limiter.retry_after("a", now), Clock::duration::zero());
+}
+
+// Test that the timing wheel forgets keys once they hold no state
+TEST(RateLimiterTest, IdleKeysExpire) {
+    auto t0 = Clock::now();
+    RateLimiter limiter(TEST_POLICY, t0);
+
+    for (int i = 0; i < 1000; i++) {
+        std::string key = "client-" + std::to_string(i);
+        limiter.take(key, t0);
+        if (i % 2) limiter.record_result(key, false, t0);
+    }
+    EXPECT_EQ(limiter.tracked_keys(), 1000u);
+
+    // Buckets refill after 10s but failures are remembered for 60s
+    limiter.advance(t0 + 15s);
+    EXPECT_EQ(limiter.tracked_keys(), 500u);
+    limiter.advance(t0 + 65s);
+    EXPECT_EQ(limiter.tracked_keys(), 0u);
+}
+
+// Test that a state older than the wheel's span still expires
+TEST(RateLimiterTest, LongIdleGapExpiresEverything) {
+    auto t0 = Clock::now();
+    RateLimiter limiter(TEST_POLICY, t0);
+    limiter.take("a", t0);
+    limiter.record_result("a", false, t0);
+
+    limiter.advance(t0 + RATE_LIMIT_WHEEL_TICK * (RATE_LIMIT_WHEEL_SLOTS * 3));
+    EXPECT_EQ(limiter.tracked_keys(), 0u);
+}
+
+// Test that KDF work stays bounded under a password-guessing attack
+// Ten simulated minutes: one client guessing as fast as it can, plus a
+// botnet of 5000 addresses each trying a few passwords on the same vault
+TEST(RateLimiterTest, BoundedKdfCallsUnderAttack) {
+    auto t0 = Clock::now();
+    AuthRateLimiter limiter(t0);
+    const std::string vault = "/vaults/target.shpd";
+    const auto attack = 600s;
+
+    size_t attempts = 0;
+    size_t kdf_calls = 0;
+    std::clock_t cpu_start = std::clock();
+
+    for (auto elapsed = 0ms; elapsed < attack; elapsed += 10ms) {
+        auto now = t0 + elapsed;
+
+        // 100 guesses/s from a single address
+        attempts++;
+        if (limiter.admit("10.0.0.1", vault, now) == Clock::duration::zero()) {
+            kdf_calls++;
+            limiter.report("10.0.0.1", vault, false, now);
+        }
+
+        // 500 guesses/s spread over the botnet
+        for (int b = 0; b < 5; b++) {
+            std::string bot = "172.16." + std::to_string((attempts * 5 + b) % 5000 / 256) + "." +
+                              std::to_string((attempts * 5 + b) % 256);
+            attempts++;
+            if (limiter.admit(bot, vault, now) == Clock::duration::zero()) {
+                kdf_calls++;
+                limiter.report(bot, vault, false, now);
+            }
+        }
+    }
+
+    double limiter_cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    // The vault bucket alone caps admissions at burst + duration / refill
+    size_t bound = static_cast<size_t>(AUTH_VAULT_POLICY.burst) +
+                   static_cast<size_t>(attack / AUTH_VAULT_POLICY.refill_interval);
+
+    std::cout << "[          ] " << attempts << " attempts, " << kdf_calls << " KDF runs (bound " << bound
+              << "), limiter CPU " << limiter_cpu << "s" << std::endl;
+
+    EXPECT_LE(kdf_calls, bound);
+    EXPECT_LT(kdf_calls * 100, attempts) << "fewer than 1% of attempts may reach the KDF";
+    EXPECT_LT(limiter_cpu, 5.0);
+
+    // The owner still gets in once the vault lockout has passed
+    auto after = t0 + attack + AUTH_VAULT_POLICY.backoff_cap;
+    EXPECT_EQ(limiter.admit("192.168.1.10", vault, after), Clock::duration::zero());
+}
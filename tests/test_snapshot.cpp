@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "vault/snapshot.hpp"
+
+namespace {
+
+constexpr off_t HEADER = sizeof(VaultHeader);
+constexpr off_t SLOT = ENCRYPTED_ENTRY_SIZE;
+
+EntryChange change(ChangeType type, size_t index) {
+    return {0, type, index, Entry{}};
+}
+
+std::string temp_path(const char *name) {
+    return (std::filesystem::temp_directory_path() / (std::string(name) + "_" + std::to_string(getpid()))).string();
+}
+
+void write_file(const std::string &path, const std::string &data) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << data;
+}
+
+std::string read_file(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+// A vault-shaped file: header plus `slots` entries, each filled with one byte
+std::string vault_bytes(size_t slots, char first) {
+    std::string data(HEADER, 'H');
+    for (size_t i = 0; i < slots; i++) data += std::string(SLOT, static_cast<char>(first + i));
+    return data;
+}
+
+} // namespace
+
+// Test that mutations map to the slots they rewrite, merged
+TEST(SnapshotTest, DirtyRanges) {
+    auto ranges = dirty_ranges({change(ChangeType::Modify, 3), change(ChangeType::Add, 4), change(ChangeType::Modify, 0)});
+
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[0].offset, 0);
+    EXPECT_EQ(ranges[0].length, HEADER + SLOT) << "header and slot 0 are adjacent";
+    EXPECT_EQ(ranges[1].offset, HEADER + 3 * SLOT);
+    EXPECT_EQ(ranges[1].length, 2 * SLOT);
+
+    ranges = dirty_ranges({change(ChangeType::Modify, 9), change(ChangeType::Delete, 5), change(ChangeType::Add, 7)});
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[1].offset, HEADER + 5 * SLOT);
+    EXPECT_EQ(ranges[1].length, SNAPSHOT_TO_END) << "a delete shifts everything after it";
+
+    ranges = dirty_ranges({});
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0].length, HEADER);
+}
+
+// Test that a copy torn by later writes is repaired from the ranges alone
+TEST(SnapshotTest, RepairTornCopy) {
+    std::string source = temp_path("shpd_snapshot_src");
+    std::string target = temp_path("shpd_snapshot_dst");
+    std::filesystem::remove(target);
+
+    write_file(source, vault_bytes(20, 'a'));
+    int src = ::open(source.c_str(), O_RDONLY);
+    ASSERT_GE(src, 0);
+
+    {
+        SnapshotWriter writer(target);
+        writer.copy(src);
+
+        // Writers carry on after the copy: edit slot 2, delete slot 10 (shift), append one
+        std::string now = vault_bytes(20, 'a');
+        now.replace(0, HEADER, std::string(HEADER, 'h'));
+        now.replace(HEADER + 2 * SLOT, SLOT, std::string(SLOT, 'X'));
+        now.erase(HEADER + 10 * SLOT, SLOT);
+        now += std::string(SLOT, 'Z');
+        write_file(source, now);
+
+        auto ranges = dirty_ranges({change(ChangeType::Modify, 2), change(ChangeType::Delete, 10),
+                                    change(ChangeType::Add, 19)});
+        writer.repair(src, ranges);
+        writer.commit();
+
+        EXPECT_EQ(read_file(target), now);
+        EXPECT_LT(writer.bytes_repaired(), static_cast<uint64_t>(now.size()));
+    }
+
+    // Shrinking is handled by the truncate
+    {
+        std::filesystem::remove(target);
+        write_file(source, vault_bytes(5, 'a'));
+        SnapshotWriter writer(target);
+        writer.copy(src);
+        write_file(source, vault_bytes(4, 'a'));
+        writer.repair(src, dirty_ranges({change(ChangeType::Delete, 4)}));
+        writer.commit();
+        EXPECT_EQ(read_file(target), vault_bytes(4, 'a'));
+    }
+
+    ::close(src);
+    std::filesystem::remove(source);
+    std::filesystem::remove(target);
+}
+
+// Test that an abandoned snapshot leaves nothing behind and never clobbers a file
+TEST(SnapshotTest, UncommittedIsRemoved) {
+    std::string target = temp_path("shpd_snapshot_abandoned");
+    std::filesystem::remove(target);
+    {
+        SnapshotWriter writer(target);
+        EXPECT_TRUE(std::filesystem::exists(target + ".partial"));
+    }
+    EXPECT_FALSE(std::filesystem::exists(target + ".partial"));
+    EXPECT_FALSE(std::filesystem::exists(target));
+
+    write_file(target + ".partial", "busy");
+    EXPECT_THROW(SnapshotWriter writer(target), std::system_error);
+    std::filesystem::remove(target + ".partial");
+}
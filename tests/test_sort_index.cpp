@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "vault/sort_index.hpp"
+
+namespace {
+
+Entry make_entry(const std::string &name, const std::string &url, time_t modified) {
+    Entry entry;
+    entry.setName(name);
+    entry.setWebsite(url);
+    entry.Modf_Time = modified;
+    return entry;
+}
+
+std::vector<std::string> names(const SortIndex &index, const std::vector<Entry> &entries, SortKey key,
+                               bool descending = false) {
+    std::vector<std::string> out;
+    for (size_t rank = 0; rank < index.size(); rank++) out.push_back(entries[index.at(key, rank, descending)].Name);
+    return out;
+}
+
+// The order a full sort would give: by key, ties in slot order
+std::vector<uint32_t> expected_order(const std::vector<Entry> &entries, SortKey key) {
+    std::vector<uint32_t> order(entries.size());
+    for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return compare_entries(key, entries[a], entries[b]) < 0; });
+    return order;
+}
+
+} // namespace
+
+// Test each ordering, both directions
+TEST(SortIndexTest, Orders) {
+    std::vector<Entry> entries = {
+        make_entry("github", "https://github.com", 300),
+        make_entry("Bank", "http://bank.example", 100),
+        make_entry("apple", "https://apple.com", 200),
+    };
+    SortIndex index;
+    index.build(entries);
+
+    EXPECT_EQ(names(index, entries, SortKey::Name), (std::vector<std::string>{"apple", "Bank", "github"}));
+    EXPECT_EQ(names(index, entries, SortKey::Name, true), (std::vector<std::string>{"github", "Bank", "apple"}));
+    EXPECT_EQ(names(index, entries, SortKey::Website), (std::vector<std::string>{"apple", "Bank", "github"}))
+        << "the scheme is ignored";
+    EXPECT_EQ(names(index, entries, SortKey::Modified), (std::vector<std::string>{"Bank", "apple", "github"}));
+
+    EXPECT_EQ(sort_key("url"), SortKey::Website);
+    EXPECT_THROW(sort_key("password"), std::runtime_error);
+}
+
+// Test that incremental updates match a rebuild after random mutations
+TEST(SortIndexTest, IncrementalMatchesRebuild) {
+    std::mt19937 rng(7);
+    auto random_entry = [&] {
+        std::string name(1 + rng() % 3, 'a');
+        for (auto &c : name) c = static_cast<char>('a' + rng() % 4);
+        return make_entry(name, "https://" + name + ".example", rng() % 50);
+    };
+
+    std::vector<Entry> entries;
+    SortIndex index;
+    for (int step = 0; step < 2000; step++) {
+        uint32_t op = rng() % 10;
+        if (op < 4 || entries.size() < 2) {
+            size_t count = op == 0 ? 1 + rng() % 20 : 1;
+            for (size_t i = 0; i < count; i++) entries.push_back(random_entry());
+            index.append(entries, entries.size() - count);
+        } else if (op < 7) {
+            uint32_t slot = rng() % entries.size();
+            Entry after = random_entry();
+            index.update(entries, slot, after);
+            entries[slot] = after;
+        } else {
+            uint32_t slot = rng() % entries.size();
+            index.erase(entries, slot);
+            entries.erase(entries.begin() + slot);
+        }
+    }
+
+    ASSERT_EQ(index.size(), entries.size());
+    for (SortKey key : {SortKey::Name, SortKey::Website, SortKey::Modified}) {
+        std::vector<uint32_t> expected = expected_order(entries, key);
+        for (size_t rank = 0; rank < entries.size(); rank++) {
+            ASSERT_EQ(index.at(key, rank), expected[rank]) << "key " << static_cast<int>(key) << " rank " << rank;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "vault/tag_index.hpp"
+
+namespace {
+
+Entry make_entry(const std::string &folder, const std::string &tags) {
+    Entry entry;
+    entry.setName("e");
+    entry.setFolder(folder);
+    entry.setTags(tags);
+    return entry;
+}
+
+Postings query(const TagIndex &index, const std::string &folder, const std::string &tags) {
+    Postings out;
+    index.query(folder, parse_tags(tags), out);
+    return out;
+}
+
+} // namespace
+
+// Test folder and tag normalization
+TEST(TagIndexTest, Normalization) {
+    EXPECT_EQ(normalize_folder(" Work / Infra/"), "Work/Infra");
+    EXPECT_EQ(normalize_folder("//"), "");
+    EXPECT_EQ(parse_tags(" Prod, db ,prod,,DB"), (std::vector<std::string>{"db", "prod"}));
+    EXPECT_TRUE(parse_tags(" , ").empty());
+}
+
+// Test galloping intersection against a plain merge
+TEST(TagIndexTest, Intersection) {
+    Postings evens, threes, few = {3, 4, 999, 1200, 5000};
+    for (uint32_t i = 0; i < 3000; i += 2) evens.push_back(i);
+    for (uint32_t i = 0; i < 3000; i += 3) threes.push_back(i);
+
+    Postings out, expected;
+    intersect_postings(evens, threes, out);
+    std::set_intersection(evens.begin(), evens.end(), threes.begin(), threes.end(), std::back_inserter(expected));
+    EXPECT_EQ(out, expected);
+
+    intersect_postings(few, evens, out);
+    EXPECT_EQ(out, (Postings{4, 1200}));
+    intersect_postings(Postings{}, evens, out);
+    EXPECT_TRUE(out.empty());
+}
+
+// Test folder-with-tags queries, including subfolders
+TEST(TagIndexTest, Query) {
+    TagIndex index;
+    index.build({
+        make_entry("Work/Infra", "prod,db"), // 0
+        make_entry("Work", "prod"),          // 1
+        make_entry("Home", "db"),            // 2
+        make_entry("Work/Infra/Old", "DB"),  // 3
+        make_entry("", ""),                  // 4
+    });
+
+    EXPECT_EQ(query(index, "Work", ""), (Postings{0, 1, 3}));
+    EXPECT_EQ(query(index, "Work/Infra", "db"), (Postings{0, 3}));
+    EXPECT_EQ(query(index, "Work", "db,prod"), (Postings{0}));
+    EXPECT_EQ(query(index, "", "db"), (Postings{0, 2, 3}));
+    EXPECT_EQ(query(index, "", ""), (Postings{0, 1, 2, 3, 4}));
+    EXPECT_TRUE(query(index, "Nowhere", "").empty());
+    EXPECT_TRUE(query(index, "Home", "prod").empty());
+
+    auto folders = index.folder_counts();
+    ASSERT_EQ(folders.size(), 4u);
+    EXPECT_EQ(folders[1], (std::pair<std::string, size_t>{"Work", 3}));
+    EXPECT_EQ(folders[3], (std::pair<std::string, size_t>{"Work/Infra/Old", 1}));
+}
+
+// Test that edits and deletes keep the postings in step with the slots
+TEST(TagIndexTest, Mutations) {
+    std::vector<Entry> entries = {make_entry("A", "x"), make_entry("B", "x"), make_entry("A", "y")};
+    TagIndex index;
+    index.build(entries);
+
+    index.append(make_entry("A", "x,y")); // 3
+    EXPECT_EQ(query(index, "A", "x"), (Postings{0, 3}));
+
+    index.update(1, entries[1], make_entry("A", "y"));
+    EXPECT_EQ(query(index, "A", "y"), (Postings{1, 2, 3}));
+    EXPECT_TRUE(query(index, "B", "").empty());
+
+    index.erase(0, entries[0]);
+    EXPECT_EQ(query(index, "A", "y"), (Postings{0, 1, 2}));
+    EXPECT_EQ(query(index, "", "x"), (Postings{2}));
+    EXPECT_EQ(query(index, "", "").size(), 3u);
+
+    auto tags = index.tag_counts();
+    ASSERT_EQ(tags.size(), 2u);
+    EXPECT_EQ(tags[0].second, 1u);
+    EXPECT_EQ(tags[1].second, 3u);
+}
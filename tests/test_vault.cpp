@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "vault/vault.hpp"
+
+namespace {
+
+class VaultTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() / ("shpd_vault_" + std::to_string(getpid()));
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir); }
+
+    static std::string contents(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    }
+
+    // Rewrite a new vault's file in a legacy format holding the given names
+    static void write_legacy(const std::string &path, const char *password, const LegacyFormat &format,
+                             const std::vector<std::string> &names) {
+        VaultHeader header;
+        {
+            std::ifstream in(path, std::ios::binary);
+            header.read(in);
+        }
+        unsigned char key[crypto_secretbox_KEYBYTES];
+        ASSERT_TRUE(derive_key_from_password(password, header.salt, key));
+
+        std::memcpy(header.version, format.version, VERSION_SIZE);
+        header.entries = names.size();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        header.write(out);
+        for (const auto &name : names) {
+            Entry entry;
+            entry.setName(name);
+            entry.setPassword("pw-" + name);
+            std::vector<unsigned char> sealed(format.encrypted_size);
+            unsigned long long clen;
+            randombytes_buf(sealed.data(), NONCE_SIZE);
+            crypto_aead_chacha20poly1305_ietf_encrypt(sealed.data() + NONCE_SIZE, &clen,
+                                                      reinterpret_cast<const unsigned char *>(&entry),
+                                                      format.entry_size, nullptr, 0, nullptr, sealed.data(), key);
+            out.write(reinterpret_cast<const char *>(sealed.data()), sealed.size());
+        }
+    }
+};
+
+} // namespace
+
+// Test that a vault opened for reading leaves a legacy file untouched: its
+// slots are read in place, and nothing can be written
+TEST_F(VaultTest, ReadOnlyLeavesLegacyFileAlone) {
+    std::string path = (dir / "legacy.shpd").string();
+    {
+        Vault vault;
+        ASSERT_TRUE(vault.create(path, "pw", "Old")["success"]);
+    }
+
+    for (const auto &format : LEGACY_FORMATS) {
+        write_legacy(path, "pw", format, {"a", "b", "c"});
+        std::string before = contents(path);
+
+        Vault vault;
+        ASSERT_TRUE(vault.open(path, true)["success"]) << format.version;
+        json unlocked = vault.authenticate("pw");
+        ASSERT_TRUE(unlocked["success"]) << format.version;
+        EXPECT_FALSE(unlocked.contains("migrated"));
+
+        std::vector<Entry> entries;
+        ASSERT_TRUE(vault.read_entries(1, 5, entries)["success"]) << format.version;
+        ASSERT_EQ(entries.size(), 2u);
+        EXPECT_STREQ(entries[0].Name, "b");
+        EXPECT_STREQ(entries[1].Password, "pw-c");
+
+        Entry entry;
+        entry.setName("new");
+        EXPECT_FALSE(vault.add_entry(entry)["success"]);
+        EXPECT_FALSE(vault.append_entries({entry})["success"]);
+        EXPECT_FALSE(vault.modify_entry(0, entry)["success"]);
+        EXPECT_FALSE(vault.delete_entry(0)["success"]);
+        vault.close();
+
+        EXPECT_EQ(contents(path), before) << format.version;
+        EXPECT_FALSE(std::filesystem::exists(path + ".migrating"));
+        EXPECT_FALSE(std::filesystem::exists(path + HISTORY_SUFFIX));
+    }
+
+    // Opened normally, the same file is upgraded on unlock
+    Vault vault;
+    ASSERT_TRUE(vault.open(path)["success"]);
+    EXPECT_TRUE(vault.authenticate("pw")["migrated"]);
+    std::vector<Entry> entries;
+    ASSERT_TRUE(vault.read_entries(0, 5, entries)["success"]);
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_STREQ(entries[2].Name, "c");
+}
+
+// Test that a load that fails part-way leaves the entry list and its indexes
+// as they were, rather than a partial list behind stale indexes
+TEST_F(VaultTest, FailedLoadKeepsEntriesAndIndexes) {
+    std::string path = (dir / "corrupt.shpd").string();
+    Vault vault;
+    ASSERT_TRUE(vault.create(path, "pw")["success"]);
+    for (const char *name : {"c", "a", "b"}) {
+        Entry entry;
+        entry.setName(name);
+        entry.setPassword("pw");
+        ASSERT_TRUE(vault.add_entry(entry)["success"]);
+    }
+    ASSERT_TRUE(vault.load_entries()["success"]);
+    uint64_t revision = vault.get_revision();
+
+    // Damage the second slot behind the vault's back
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(VaultHeader) + ENCRYPTED_ENTRY_SIZE + NONCE_SIZE);
+        file.put('\xff');
+    }
+
+    json loaded = vault.load_entries();
+    EXPECT_FALSE(loaded["success"]);
+    EXPECT_NE(loaded["error"].get<std::string>().find("entry 1"), std::string::npos);
+
+    const auto &entries = vault.get_entries();
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(vault.get_revision(), revision);
+    ASSERT_EQ(vault.get_sort_index().size(), entries.size());
+    EXPECT_STREQ(entries[vault.get_sort_index().at(SortKey::Name, 0)].Name, "a");
+    EXPECT_STREQ(entries[vault.get_sort_index().at(SortKey::Name, 2)].Name, "c");
+    for (size_t i = 0; i < entries.size(); i++) {
+        size_t index = SIZE_MAX;
+        EXPECT_TRUE(vault.index_of(entry_id(entries[i]), index));
+        EXPECT_EQ(index, i);
+    }
+
+    // A first load that fails leaves nothing loaded
+    Vault other;
+    ASSERT_TRUE(other.open(path)["success"]);
+    ASSERT_TRUE(other.authenticate("pw")["success"]);
+    EXPECT_FALSE(other.load_entries()["success"]);
+    EXPECT_TRUE(other.get_entries().empty());
+    EXPECT_EQ(other.get_sort_index().size(), 0u);
+}
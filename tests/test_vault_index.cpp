@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+#include "discovery/vault_index.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+void write_vault(const std::filesystem::path &path, const char *name) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    VaultHeader(name).write(out);
+}
+
+std::vector<std::string> catalog_paths(const VaultIndex &index) {
+    std::vector<std::string> paths;
+    for (const auto &info : index.list()) paths.push_back(info.path);
+    return paths;
+}
+
+// Poll until the catalog holds exactly `expected`; the watcher runs on its own thread
+bool wait_for_catalog(const VaultIndex &index, const std::vector<std::string> &expected) {
+    auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (!index.is_crawling() && catalog_paths(index) == expected) return true;
+        std::this_thread::sleep_for(10ms);
+    }
+    return false;
+}
+
+} // namespace
+
+// Test that discovery is opt-in: no SHPD_VAULT_ROOTS means no roots and no crawl
+TEST(VaultIndexTest, RootsAreOptIn) {
+    const char *saved = getenv("SHPD_VAULT_ROOTS");
+    std::string restore = saved ? saved : "";
+
+    unsetenv("SHPD_VAULT_ROOTS");
+    EXPECT_TRUE(discovery_roots().empty());
+    setenv("SHPD_VAULT_ROOTS", "", 1);
+    EXPECT_TRUE(discovery_roots().empty());
+    setenv("SHPD_VAULT_ROOTS", "/a::/b/c:", 1);
+    EXPECT_EQ(discovery_roots(), (std::vector<std::string>{"/a", "/b/c"}));
+
+    if (saved) {
+        setenv("SHPD_VAULT_ROOTS", restore.c_str(), 1);
+    } else {
+        unsetenv("SHPD_VAULT_ROOTS");
+    }
+
+    VaultIndex index({});
+    index.start();
+    EXPECT_FALSE(index.is_enabled());
+    EXPECT_FALSE(index.is_crawling());
+    EXPECT_TRUE(index.list().empty());
+}
+
+// Test that the watcher follows new, moved and deleted directories; a
+// directory moved within the tree must be crawled again at its new path
+TEST(VaultIndexTest, FollowsDirectoryChanges) {
+    std::filesystem::path root = std::filesystem::temp_directory_path() / ("shpd_index_" + std::to_string(getpid()));
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "a");
+    write_vault(root / "a" / "one.shpd", "One");
+    std::string one = (root / "a" / "one.shpd").string();
+
+    VaultIndex index({root.string()});
+    index.start();
+    ASSERT_TRUE(wait_for_catalog(index, {one}));
+
+    std::filesystem::create_directory(root / "b");
+    write_vault(root / "b" / "two.shpd", "Two");
+    std::string two = (root / "b" / "two.shpd").string();
+    ASSERT_TRUE(wait_for_catalog(index, {one, two}));
+
+    std::filesystem::rename(root / "b", root / "c");
+    std::string moved = (root / "c" / "two.shpd").string();
+    ASSERT_TRUE(wait_for_catalog(index, {one, moved}));
+
+    // Still watched at the new path
+    write_vault(root / "c" / "three.shpd", "Three");
+    std::string three = (root / "c" / "three.shpd").string();
+    ASSERT_TRUE(wait_for_catalog(index, {one, three, moved}));
+
+    std::filesystem::remove_all(root / "c");
+    ASSERT_TRUE(wait_for_catalog(index, {one}));
+
+    index.stop();
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include "api/wire_format.hpp"
+
+namespace {
+
+httplib::Request make_request(const std::string &content_type, const std::string &accept, const std::string &body = "") {
+    httplib::Request req;
+    if (!content_type.empty()) req.set_header("Content-Type", content_type);
+    if (!accept.empty()) req.set_header("Accept", accept);
+    req.body = body;
+    return req;
+}
+
+std::string gunzip(const std::string &in) {
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream, 16 + MAX_WBITS), Z_OK);
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+    stream.avail_in = static_cast<uInt>(in.size());
+
+    std::string out;
+    char buffer[4096];
+    int status;
+    do {
+        stream.next_out = reinterpret_cast<Bytef *>(buffer);
+        stream.avail_out = sizeof(buffer);
+        status = inflate(&stream, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - stream.avail_out);
+    } while (status == Z_OK);
+    inflateEnd(&stream);
+    EXPECT_EQ(status, Z_STREAM_END);
+    return out;
+}
+
+json sample_response() {
+    json entries = json::array();
+    for (int i = 0; i < 50; i++) {
+        entries.push_back({{"name", "Entry " + std::to_string(i)}, {"password", "pw"}, {"modf_time", 1700000000 + i}});
+    }
+    return {{"success", true}, {"revision", 42}, {"entries", entries}};
+}
+
+} // namespace
+
+// Test media type matching, including parameters, case and whitespace
+TEST(WireFormatTest, MediaTypes) {
+    WireFormat format = WireFormat::Json;
+    EXPECT_TRUE(media_type_format(" Application/CBOR ; charset=binary", format));
+    EXPECT_EQ(format, WireFormat::Cbor);
+    for (const char *type : {"application/msgpack", "application/x-msgpack", "application/vnd.msgpack"}) {
+        EXPECT_TRUE(media_type_format(type, format)) << type;
+        EXPECT_EQ(format, WireFormat::MsgPack) << type;
+    }
+    for (const char *type : {"application/json; charset=utf-8", "*/*", "application/*"}) {
+        EXPECT_TRUE(media_type_format(type, format)) << type;
+        EXPECT_EQ(format, WireFormat::Json) << type;
+    }
+    EXPECT_FALSE(media_type_format("text/html", format));
+    EXPECT_FALSE(media_type_format("", format));
+}
+
+// Test that Content-Type picks the decoder, and unknown types are read as JSON
+TEST(WireFormatTest, RequestBodies) {
+    json body = {{"path", "/tmp/v.shpd"}, {"count", 3}, {"flags", {true, false}}};
+
+    std::vector<uint8_t> cbor = json::to_cbor(body);
+    EXPECT_EQ(parse_request(make_request("application/cbor", "", std::string(cbor.begin(), cbor.end()))), body);
+
+    std::vector<uint8_t> msgpack = json::to_msgpack(body);
+    EXPECT_EQ(parse_request(make_request("application/msgpack", "", std::string(msgpack.begin(), msgpack.end()))),
+              body);
+
+    EXPECT_EQ(parse_request(make_request("", "", body.dump())), body);
+    EXPECT_EQ(parse_request(make_request("text/plain", "", body.dump())), body);
+
+    // A body that does not match its Content-Type is an error, not a guess
+    EXPECT_THROW(parse_request(make_request("application/cbor", "", body.dump())), json::exception);
+}
+
+// Test Accept negotiation: q-values, ties and fallback to JSON
+TEST(WireFormatTest, AcceptNegotiation) {
+    EXPECT_EQ(response_format(make_request("", "")), WireFormat::Json);
+    EXPECT_EQ(response_format(make_request("", "application/cbor")), WireFormat::Cbor);
+    EXPECT_EQ(response_format(make_request("", "application/json;q=0.5, application/msgpack")), WireFormat::MsgPack);
+    EXPECT_EQ(response_format(make_request("", "application/cbor;q=0.9, application/json")), WireFormat::Json);
+    EXPECT_EQ(response_format(make_request("", "application/msgpack, application/cbor")), WireFormat::MsgPack);
+    EXPECT_EQ(response_format(make_request("", "text/html, application/xml")), WireFormat::Json);
+    EXPECT_EQ(response_format(make_request("", "application/cbor;q=0")), WireFormat::Json);
+}
+
+// Test that each negotiated encoder round-trips the response, with matching headers
+TEST(WireFormatTest, ResponseRoundTrip) {
+    json response = sample_response();
+
+    httplib::Response json_res;
+    send_response(make_request("", "text/html"), json_res, response);
+    EXPECT_EQ(json_res.get_header_value("Content-Type"), "application/json");
+    EXPECT_EQ(json::parse(json_res.body), response);
+
+    httplib::Response cbor_res;
+    send_response(make_request("", "application/cbor"), cbor_res, response);
+    EXPECT_EQ(cbor_res.get_header_value("Content-Type"), "application/cbor");
+    EXPECT_EQ(json::from_cbor(cbor_res.body), response);
+
+    httplib::Response msgpack_res;
+    send_response(make_request("", "application/msgpack"), msgpack_res, response);
+    EXPECT_EQ(msgpack_res.get_header_value("Content-Type"), "application/msgpack");
+    EXPECT_EQ(json::from_msgpack(msgpack_res.body), response);
+
+    for (const auto *res : {&json_res, &cbor_res, &msgpack_res}) {
+        EXPECT_EQ(res->get_header_value("Vary"), "Accept, Accept-Encoding");
+        EXPECT_FALSE(res->has_header("Content-Encoding"));
+    }
+}
+
+// Test that binary formats are compressed like JSON when the client allows it
+TEST(WireFormatTest, CompressedBinaryResponse) {
+    json response = sample_response();
+    httplib::Request req = make_request("", "application/cbor");
+    req.set_header("Accept-Encoding", "gzip");
+
+    httplib::Response res;
+    send_response(req, res, response);
+    ASSERT_EQ(res.get_header_value("Content-Encoding"), "gzip");
+    EXPECT_EQ(res.get_header_value("Content-Type"), "application/cbor");
+    EXPECT_EQ(json::from_cbor(gunzip(res.body)), response);
+}
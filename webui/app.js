@@ -1,9 +1,15 @@
 const API_BASE = '';
 let currentEntries = [];
+let currentRevision = null;
+let groupFilterIds = null; // ids matching the folder/tag filter, or null for all
+let sortRanks = null; // id -> position in the server's sorted order, or null for file order
+let refreshQueue = Promise.resolve();
+let changeFeed = null;
 let currentViewEntry = null;
-let currentViewIndex = null;
+let currentViewId = null;
 let browseMode = 'open'; // 'open' or 'create'
 let currentBrowsePath = '';
+let currentVaultPath = '';
 
 // Toast notifications
 function showToast(message, type = 'success') {
@@ -82,6 +88,7 @@ async function browsePath(path) {
             div.innerHTML = `
                     <span class="browser-icon">${item.is_dir ? '📁' : '🔐'}</span>
                     <span class="browser-name">${item.name}</span>
+                    ${item.vault_name !== undefined ? `<span class="browser-meta">${escapeHtml(item.vault_name)} · ${item.entries} entries</span>` : ''}
                 `;
 
             if (item.is_dir) {
@@ -161,7 +168,12 @@ async function createVault() {
       if (data.success) {
          showToast('Vault created successfully');
          updateUI(true, true, data.name, data.entries);
+         currentEntries = [];
+         currentRevision = null;
+         groupFilterIds = null;
+         sortRanks = null;
          renderEntries([]);
+         subscribeChanges();
       } else {
          showToast(data.error, 'error');
       }
@@ -187,8 +199,10 @@ async function openVault() {
       const data = await res.json();
 
       if (data.success) {
+         currentVaultPath = path;
          showToast('Vault opened');
          updateUI(true, false, data.name, data.entries);
+         await resumeSession(data.name, data.entries);
       } else {
          showToast(data.error, 'error');
       }
@@ -197,6 +211,36 @@ async function openVault() {
    }
 }
 
+function sessionKey(path) {
+   return `shpd-session:${path}`;
+}
+
+// Unlock with a session token from an earlier password unlock, if the
+// server still has the key cached (SHPD_KEY_CACHE_TTL)
+async function resumeSession(name, entries) {
+   const token = sessionStorage.getItem(sessionKey(currentVaultPath));
+   if (!token) return;
+
+   try {
+      const res = await fetch(`${API_BASE}/api/vault/authenticate`, {
+         method: 'POST',
+         headers: { 'Content-Type': 'application/json' },
+         body: JSON.stringify({ session_token: token })
+      });
+      const data = await res.json();
+
+      if (data.success) {
+         showToast('Vault unlocked');
+         updateUI(true, true, name, entries);
+         loadEntries();
+      } else {
+         sessionStorage.removeItem(sessionKey(currentVaultPath));
+      }
+   } catch (e) {
+      sessionStorage.removeItem(sessionKey(currentVaultPath));
+   }
+}
+
 async function authenticate() {
    const password = document.getElementById('authPassword').value;
 
@@ -214,6 +258,9 @@ async function authenticate() {
       const data = await res.json();
 
       if (data.success) {
+         if (data.session_token) {
+            sessionStorage.setItem(sessionKey(currentVaultPath), data.session_token);
+         }
          showToast('Vault unlocked');
          const name = document.getElementById('vaultNameDisplay').textContent;
          const entries = document.getElementById('vaultEntriesDisplay').textContent;
@@ -228,6 +275,7 @@ async function authenticate() {
 }
 
 async function closeVault() {
+   unsubscribeChanges();
    try {
       const res = await fetch(`${API_BASE}/api/vault/close`, { method: 'POST' });
       const data = await res.json();
@@ -236,7 +284,11 @@ async function closeVault() {
          showToast('Vault closed');
          updateUI(false, false);
          currentEntries = [];
+         currentRevision = null;
+         groupFilterIds = null;
+         sortRanks = null;
          renderEntries([]);
+         subscribeChanges();
       }
    } catch (e) {
       showToast('Failed to close vault', 'error');
@@ -249,14 +301,9 @@ async function loadEntries() {
       const data = await res.json();
 
       if (data.success) {
-         const entriesRes = await fetch(`${API_BASE}/api/entries`);
-         const entriesData = await entriesRes.json();
-
-         if (entriesData.success) {
-            currentEntries = entriesData.entries;
-            renderEntries(currentEntries);
-            document.getElementById('vaultEntriesActive').textContent = `${currentEntries.length} entries`;
-         }
+         currentRevision = null;
+         await refreshEntries();
+         subscribeChanges();
       } else {
          showToast(data.error, 'error');
       }
@@ -265,13 +312,99 @@ async function loadEntries() {
    }
 }
 
+// Fetch only what changed since the last known revision; the server falls
+// back to a full listing when its change log no longer covers it.
+// Refreshes are chained so a delta is never applied twice.
+// Entries are addressed by their stable id; the slot is only a hint
+function slotOf(change) {
+   const slot = currentEntries[change.index];
+   if (slot && slot.id === change.id) return change.index;
+   return currentEntries.findIndex(e => e.id === change.id);
+}
+
+function entryById(id) {
+   return currentEntries.find(e => e.id === id);
+}
+
+function refreshEntries() {
+   refreshQueue = refreshQueue.then(applyEntryChanges);
+   return refreshQueue;
+}
+
+async function applyEntryChanges() {
+   try {
+      const url = currentRevision === null
+         ? `${API_BASE}/api/entries`
+         : `${API_BASE}/api/entries?since=${currentRevision}`;
+      const res = await fetch(url);
+      const data = await res.json();
+
+      if (!data.success) {
+         showToast(data.error, 'error');
+         return;
+      }
+
+      if (data.full) {
+         currentEntries = data.entries;
+      } else {
+         for (const change of data.changes) {
+            if (change.op === 'add') {
+               currentEntries.splice(change.index, 0, change.entry);
+            } else if (change.op === 'modify') {
+               currentEntries[slotOf(change)] = change.entry;
+            } else if (change.op === 'delete') {
+               currentEntries.splice(slotOf(change), 1);
+            }
+         }
+      }
+
+      currentRevision = data.revision;
+      await refreshGroups();
+      if (sortRanks) await fetchSortOrder();
+      filterEntries();
+      document.getElementById('vaultEntriesActive').textContent = `${currentEntries.length} entries`;
+   } catch (e) {
+      showToast('Failed to load entries', 'error');
+   }
+}
+
+// Keep in sync with edits made from other tabs via the server change feed
+function subscribeChanges() {
+   unsubscribeChanges();
+   const feed = new EventSource(`${API_BASE}/api/events`);
+   changeFeed = feed;
+   feed.addEventListener('change', (e) => {
+      const change = JSON.parse(e.data);
+      if (currentRevision === null || change.revision > currentRevision) {
+         refreshEntries();
+      }
+   });
+   // The browser retries dropped streams itself, but not refused ones (503 when
+   // the server is at its stream limit); try again unless unsubscribed meanwhile
+   feed.onerror = () => {
+      if (feed.readyState !== EventSource.CLOSED) return;
+      setTimeout(() => {
+         if (changeFeed === feed) subscribeChanges();
+      }, 5000);
+   };
+}
+
+function unsubscribeChanges() {
+   if (changeFeed) {
+      changeFeed.close();
+      changeFeed = null;
+   }
+}
+
 async function addEntry() {
    const entry = {
       name: document.getElementById('entryName').value,
       username: document.getElementById('entryUsername').value,
       password: document.getElementById('entryPassword').value,
       url: document.getElementById('entryUrl').value,
-      notes: document.getElementById('entryNotes').value
+      notes: document.getElementById('entryNotes').value,
+      folder: document.getElementById('entryFolder').value,
+      tags: document.getElementById('entryTags').value
    };
 
    if (!entry.name || !entry.password) {
@@ -290,7 +423,7 @@ async function addEntry() {
       if (data.success) {
          showToast('Entry added');
          closeModal('addModal');
-         loadEntries();
+         refreshEntries();
          clearAddForm();
       } else {
          showToast(data.error, 'error');
@@ -300,12 +433,54 @@ async function addEntry() {
    }
 }
 
+// Upload an export from another password manager; the server parses it as it
+// streams in, so the file is sent as-is rather than read into memory here
+async function importEntries(input) {
+   const file = input.files[0];
+   input.value = '';
+   if (!file) return;
+
+   const format = /\.(jsonl|ndjson)$/i.test(file.name) ? 'jsonl' : 'csv';
+   try {
+      showToast(`Importing ${file.name}...`);
+      const res = await fetch(`${API_BASE}/api/entries/import?format=${format}`, {
+         method: 'POST',
+         headers: { 'Content-Type': format === 'csv' ? 'text/csv' : 'application/x-ndjson' },
+         body: file
+      });
+      const data = await res.json();
+
+      if (data.imported > 0) refreshEntries();
+      if (data.success) {
+         const skipped = data.rejected ? `, ${data.rejected} skipped` : '';
+         showToast(`Imported ${data.imported} entries${skipped}`);
+         if (data.rejected) console.warn('Import rejected rows:', data.errors);
+      } else {
+         showToast(data.error, 'error');
+      }
+   } catch (e) {
+      showToast('Failed to import entries', 'error');
+   }
+}
+
+// Let the browser stream the download straight to disk
+function exportVault(format) {
+   const link = document.createElement('a');
+   link.href = `${API_BASE}/api/vault/export?format=${format}`;
+   link.download = '';
+   document.body.appendChild(link);
+   link.click();
+   link.remove();
+}
+
 function clearAddForm() {
    document.getElementById('entryName').value = '';
    document.getElementById('entryUsername').value = '';
    document.getElementById('entryPassword').value = '';
    document.getElementById('entryUrl').value = '';
    document.getElementById('entryNotes').value = '';
+   document.getElementById('entryFolder').value = '';
+   document.getElementById('entryTags').value = '';
 }
 
 function renderEntries(entries) {
@@ -331,10 +506,10 @@ function renderEntries(entries) {
                 <div class="entry-username">${escapeHtml(entry.username || '-')}</div>
             </div>
             <div class="entry-actions">
-                <button class="icon-btn" onclick="viewEntry(${index})" title="View">👁</button>
-                <button class="icon-btn" onclick="openEditModal(${index})" title="Edit">✏️</button>
-                <button class="icon-btn" onclick="copyEntryPassword(${index})" title="Copy password">📋</button>
-                <button class="icon-btn" onclick="deleteEntry(${index})" title="Delete">🗑️</button>
+                <button class="icon-btn" onclick="viewEntry('${entry.id}')" title="View">👁</button>
+                <button class="icon-btn" onclick="openEditModal('${entry.id}')" title="Edit">✏️</button>
+                <button class="icon-btn" onclick="copyEntryPassword('${entry.id}')" title="Copy password">📋</button>
+                <button class="icon-btn" onclick="deleteEntry('${entry.id}')" title="Delete">🗑️</button>
             </div>
         </div>
     `).join('');
@@ -342,13 +517,85 @@ function renderEntries(entries) {
 
 function filterEntries() {
    const search = document.getElementById('searchInput').value.toLowerCase();
-   const filtered = currentEntries.filter(e =>
+   const grouped = groupFilterIds ? currentEntries.filter(e => groupFilterIds.has(e.id)) : currentEntries;
+   const filtered = grouped.filter(e =>
       e.name.toLowerCase().includes(search) ||
       (e.username && e.username.toLowerCase().includes(search))
    );
+   if (sortRanks) filtered.sort((a, b) => sortRanks.get(a.id) - sortRanks.get(b.id));
    renderEntries(filtered);
 }
 
+// Folder and tag filters are answered by the server's index; the matching
+// ids then narrow the entries already held here
+async function refreshGroups() {
+   const res = await fetch(`${API_BASE}/api/entries/groups`);
+   const data = await res.json();
+   if (!data.success) return;
+
+   const select = document.getElementById('folderFilter');
+   const selected = select.value;
+   select.innerHTML = '<option value="">All folders</option>' + data.folders.map(f =>
+      `<option value="${escapeHtml(f.path)}">${escapeHtml(f.path)} (${f.count})</option>`).join('');
+   select.value = data.folders.some(f => f.path === selected) ? selected : '';
+
+   if (groupFilterIds) await fetchGroupFilter();
+}
+
+async function fetchGroupFilter() {
+   const folder = document.getElementById('folderFilter').value;
+   const tags = document.getElementById('tagFilter').value.trim();
+   if (!folder && !tags) {
+      groupFilterIds = null;
+      return;
+   }
+
+   const params = new URLSearchParams({ folder, tags });
+   const res = await fetch(`${API_BASE}/api/entries/filter?${params}`);
+   const data = await res.json();
+   if (data.success) {
+      groupFilterIds = new Set(data.entries.map(e => e.id));
+   } else {
+      showToast(data.error, 'error');
+   }
+}
+
+async function applyGroupFilter() {
+   try {
+      await fetchGroupFilter();
+      filterEntries();
+   } catch (e) {
+      showToast('Failed to filter entries', 'error');
+   }
+}
+
+// Orderings are kept by the server; only the ids are fetched, in order
+async function fetchSortOrder() {
+   const [sort, order] = document.getElementById('sortSelect').value.split(':');
+   if (!sort) {
+      sortRanks = null;
+      return;
+   }
+
+   const params = new URLSearchParams({ sort, order, ids: 1, limit: currentEntries.length });
+   const res = await fetch(`${API_BASE}/api/entries/page?${params}`);
+   const data = await res.json();
+   if (data.success) {
+      sortRanks = new Map(data.ids.map((id, rank) => [id, rank]));
+   } else {
+      showToast(data.error, 'error');
+   }
+}
+
+async function applySort() {
+   try {
+      await fetchSortOrder();
+      filterEntries();
+   } catch (e) {
+      showToast('Failed to sort entries', 'error');
+   }
+}
+
 function openAddModal() {
    document.getElementById('addModal').classList.add('active');
    document.getElementById('entryName').focus();
@@ -358,10 +605,10 @@ function closeModal(id) {
    document.getElementById(id).classList.remove('active');
 }
 
-function viewEntry(index) {
-   const entry = currentEntries[index];
+function viewEntry(id) {
+   const entry = entryById(id);
    currentViewEntry = entry;
-   currentViewIndex = index;
+   currentViewId = id;
 
    document.getElementById('viewEntryTitle').textContent = entry.name;
    document.getElementById('viewUsername').textContent = entry.username || '-';
@@ -369,6 +616,8 @@ function viewEntry(index) {
    document.getElementById('viewPassword').style.filter = 'blur(8px)';
    document.getElementById('viewUrl').textContent = entry.url || '-';
    document.getElementById('viewNotes').textContent = entry.notes || '-';
+   document.getElementById('viewGroups').textContent =
+      [entry.folder, entry.tags].filter(Boolean).join(' · ') || '-';
 
    document.getElementById('viewModal').classList.add('active');
 }
@@ -391,13 +640,13 @@ function copyPassword() {
    }
 }
 
-function copyEntryPassword(index) {
-   navigator.clipboard.writeText(currentEntries[index].password);
+function copyEntryPassword(id) {
+   navigator.clipboard.writeText(entryById(id).password);
    showToast('Password copied');
 }
 
-async function deleteEntry(index) {
-   const entry = currentEntries[index];
+async function deleteEntry(id) {
+   const entry = entryById(id);
    if (!confirm(`Are you sure you want to delete "${entry.name}"?`)) {
       return;
    }
@@ -406,13 +655,13 @@ async function deleteEntry(index) {
       const res = await fetch(`${API_BASE}/api/entries/delete`, {
          method: 'POST',
          headers: { 'Content-Type': 'application/json' },
-         body: JSON.stringify({ index })
+         body: JSON.stringify({ id })
       });
       const data = await res.json();
 
       if (data.success) {
          showToast('Entry deleted');
-         loadEntries();
+         refreshEntries();
       } else {
          showToast(data.error, 'error');
       }
@@ -434,63 +683,99 @@ function togglePassword(inputId) {
 
 // Password Generator
 let targetPasswordField = null;
-
-const charSets = {
-   uppercase: 'ABCDEFGHIJKLMNOPQRSTUVWXYZ',
-   lowercase: 'abcdefghijklmnopqrstuvwxyz',
-   numbers: '0123456789',
-   special: '!@#$%^&*()_+-=[]{}|;:,.<>?',
-   extended: '±§µ¶·¸¹º»¼½¾¿ÀÁÂÃÄÅÆÇÈÉÊËÌÍÎÏ'
+let generatorMode = 'password';
+let generateSequence = 0;
+
+// Generator buttons and the server's character class names
+const genClassOptions = {
+   genUppercase: 'upper',
+   genLowercase: 'lower',
+   genNumbers: 'digits',
+   genSpecial: 'symbols',
+   genExtended: 'extended'
 };
 
+// Longest password that fits an entry, in characters (extended ones take two bytes)
+const GENERATED_MAX_BYTES = 63;
+
 function openGeneratorModal(fieldId) {
    targetPasswordField = fieldId;
    document.getElementById('generatorModal').classList.add('active');
    regeneratePassword();
 }
 
+function setGeneratorMode(mode) {
+   generatorMode = mode;
+   document.getElementById('genModePassword').classList.toggle('active', mode === 'password');
+   document.getElementById('genModePassphrase').classList.toggle('active', mode === 'passphrase');
+   document.getElementById('passwordOptions').style.display = mode === 'password' ? '' : 'none';
+   document.getElementById('passphraseOptions').style.display = mode === 'passphrase' ? '' : 'none';
+   regeneratePassword();
+}
+
 function updateLengthDisplay() {
    const length = document.getElementById('passwordLength').value;
    document.getElementById('lengthValue').textContent = length;
    regeneratePassword();
 }
 
+function updateWordsDisplay() {
+   document.getElementById('wordsValue').textContent = document.getElementById('passphraseWords').value;
+   regeneratePassword();
+}
+
 function toggleGenOption(optionId) {
    const btn = document.getElementById(optionId);
    btn.classList.toggle('active');
    regeneratePassword();
 }
 
-function regeneratePassword() {
-   let chars = '';
+// Ask the server's CSPRNG for a password; only the newest request updates the preview
+async function regeneratePassword() {
+   const preview = document.getElementById('generatedPreview');
+   const entropy = document.getElementById('generatedEntropy');
+   const request = { mode: generatorMode };
 
-   if (document.getElementById('genUppercase').classList.contains('active')) {
-      chars += charSets.uppercase;
-   }
-   if (document.getElementById('genLowercase').classList.contains('active')) {
-      chars += charSets.lowercase;
-   }
-   if (document.getElementById('genNumbers').classList.contains('active')) {
-      chars += charSets.numbers;
-   }
-   if (document.getElementById('genSpecial').classList.contains('active')) {
-      chars += charSets.special;
-   }
-   if (document.getElementById('genExtended').classList.contains('active')) {
-      chars += charSets.extended;
-   }
+   if (generatorMode === 'passphrase') {
+      request.words = parseInt(document.getElementById('passphraseWords').value);
+   } else {
+      request.classes = Object.entries(genClassOptions)
+         .filter(([id]) => document.getElementById(id).classList.contains('active'))
+         .map(([, name]) => name);
+      if (request.classes.length === 0) {
+         generateSequence++;
+         preview.value = '';
+         entropy.textContent = '';
+         return;
+      }
 
-   if (chars.length === 0) {
-      document.getElementById('generatedPreview').value = '';
-      return;
+      const slider = document.getElementById('passwordLength');
+      slider.max = request.classes.includes('extended') ? GENERATED_MAX_BYTES >> 1 : GENERATED_MAX_BYTES;
+      document.getElementById('lengthValue').textContent = slider.value;
+      request.length = parseInt(slider.value);
    }
 
-   const length = parseInt(document.getElementById('passwordLength').value);
-   let password = '';
-   for (let i = 0; i < length; i++) {
-      password += chars.charAt(Math.floor(Math.random() * chars.length));
+   const sequence = ++generateSequence;
+   try {
+      const res = await fetch(`${API_BASE}/api/generate`, {
+         method: 'POST',
+         headers: { 'Content-Type': 'application/json' },
+         body: JSON.stringify(request)
+      });
+      const data = await res.json();
+      if (sequence !== generateSequence) return;
+
+      if (data.success) {
+         preview.value = data.passwords[0];
+         entropy.textContent = `(${data.entropy_bits} bits)`;
+      } else {
+         preview.value = '';
+         entropy.textContent = '';
+         showToast(data.error, 'error');
+      }
+   } catch (e) {
+      if (sequence === generateSequence) showToast('Failed to generate password', 'error');
    }
-   document.getElementById('generatedPreview').value = password;
 }
 
 function applyGeneratedPassword() {
@@ -511,15 +796,17 @@ function openEditModalFromView() {
    document.getElementById('editEntryPassword').value = currentViewEntry.password || '';
    document.getElementById('editEntryUrl').value = currentViewEntry.url || '';
    document.getElementById('editEntryNotes').value = currentViewEntry.notes || '';
+   document.getElementById('editEntryFolder').value = currentViewEntry.folder || '';
+   document.getElementById('editEntryTags').value = currentViewEntry.tags || '';
 
    document.getElementById('editModal').classList.add('active');
    document.getElementById('editEntryName').focus();
 }
 
-function openEditModal(index) {
-   const entry = currentEntries[index];
+function openEditModal(id) {
+   const entry = entryById(id);
    currentViewEntry = entry;
-   currentViewIndex = index;
+   currentViewId = id;
 
    // Populate the edit form with entry data
    document.getElementById('editEntryName').value = entry.name || '';
@@ -527,6 +814,8 @@ function openEditModal(index) {
    document.getElementById('editEntryPassword').value = entry.password || '';
    document.getElementById('editEntryUrl').value = entry.url || '';
    document.getElementById('editEntryNotes').value = entry.notes || '';
+   document.getElementById('editEntryFolder').value = entry.folder || '';
+   document.getElementById('editEntryTags').value = entry.tags || '';
 
    document.getElementById('editModal').classList.add('active');
    document.getElementById('editEntryName').focus();
@@ -534,12 +823,14 @@ function openEditModal(index) {
 
 async function saveEditEntry() {
    const entry = {
-      index: currentViewIndex,
+      id: currentViewId,
       name: document.getElementById('editEntryName').value,
       username: document.getElementById('editEntryUsername').value,
       password: document.getElementById('editEntryPassword').value,
       url: document.getElementById('editEntryUrl').value,
-      notes: document.getElementById('editEntryNotes').value
+      notes: document.getElementById('editEntryNotes').value,
+      folder: document.getElementById('editEntryFolder').value,
+      tags: document.getElementById('editEntryTags').value
    };
 
    if (!entry.name || !entry.password) {
@@ -558,7 +849,7 @@ async function saveEditEntry() {
       if (data.success) {
          showToast('Entry updated');
          closeModal('editModal');
-         loadEntries();
+         refreshEntries();
       } else {
          showToast(data.error, 'error');
       }
@@ -567,6 +858,162 @@ async function saveEditEntry() {
    }
 }
 
+// Previous versions are fetched only when asked for; unlocking never reads them
+async function openHistoryModal() {
+   const id = currentViewId;
+   const list = document.getElementById('historyList');
+   document.getElementById('historyTitle').textContent = `History: ${currentViewEntry.name}`;
+   list.innerHTML = '<div class="browser-item">Loading...</div>';
+   document.getElementById('historyModal').classList.add('active');
+
+   try {
+      const res = await fetch(`${API_BASE}/api/entries/history?id=${id}`);
+      const data = await res.json();
+
+      if (!data.success) {
+         list.innerHTML = '';
+         showToast(data.error, 'error');
+         return;
+      }
+      if (data.versions.length === 0) {
+         list.innerHTML = '<div class="browser-item">No earlier versions</div>';
+         return;
+      }
+
+      list.innerHTML = '';
+      for (const v of data.versions) {
+         const when = new Date(v.replaced_at * 1000).toLocaleString();
+         const div = document.createElement('div');
+         div.className = 'browser-item';
+         div.innerHTML = `
+            <span class="browser-name">${escapeHtml(v.name)} &middot; ${escapeHtml(v.username || '-')}</span>
+            <span class="browser-meta">replaced ${escapeHtml(when)}</span>
+            <button class="icon-btn" title="Copy password">📋</button>
+            <button class="icon-btn" title="Restore this version">↩</button>`;
+         const [copyBtn, restoreBtn] = div.querySelectorAll('button');
+         copyBtn.onclick = () => {
+            navigator.clipboard.writeText(v.password);
+            showToast('Password copied');
+         };
+         restoreBtn.onclick = () => rollbackEntry(id, v.version);
+         list.appendChild(div);
+      }
+   } catch (e) {
+      showToast('Failed to load history', 'error');
+   }
+}
+
+async function rollbackEntry(id, version) {
+   if (!confirm('Restore this version? The current one is kept in the history.')) return;
+
+   try {
+      const res = await fetch(`${API_BASE}/api/entries/rollback`, {
+         method: 'POST',
+         headers: { 'Content-Type': 'application/json' },
+         body: JSON.stringify({ id, version })
+      });
+      const data = await res.json();
+
+      if (data.success) {
+         showToast('Version restored');
+         closeModal('historyModal');
+         closeModal('viewModal');
+         refreshEntries();
+      } else {
+         showToast(data.error, 'error');
+      }
+   } catch (e) {
+      showToast('Failed to restore version', 'error');
+   }
+}
+
+async function openAuditModal() {
+   const list = document.getElementById('auditList');
+   document.getElementById('auditTitle').textContent = 'Reused Passwords';
+   list.innerHTML = '<div class="browser-item">Checking...</div>';
+   document.getElementById('auditModal').classList.add('active');
+
+   try {
+      const res = await fetch(`${API_BASE}/api/audit/reuse`);
+      const data = await res.json();
+
+      if (!data.success) {
+         list.innerHTML = '';
+         showToast(data.error, 'error');
+         return;
+      }
+      document.getElementById('auditTitle').textContent = `Reused Passwords (${data.checked} checked)`;
+      if (data.reused.length === 0 && data.similar.length === 0) {
+         list.innerHTML = '<div class="browser-item">No reused or similar passwords</div>';
+         return;
+      }
+
+      list.innerHTML = '';
+      const names = new Map(currentEntries.map(e => [e.id, e.name]));
+      const addGroups = (groups, label) => {
+         for (const group of groups) {
+            const members = group.ids.map(id => names.get(id) ?? id);
+            const div = document.createElement('div');
+            div.className = 'browser-item';
+            div.innerHTML = `
+               <span class="browser-name">${escapeHtml(members.join(', '))}</span>
+               <span class="browser-meta">${label} by ${group.count} entries</span>`;
+            div.onclick = () => {
+               if (!names.has(group.ids[0])) return;
+               closeModal('auditModal');
+               viewEntry(group.ids[0]);
+            };
+            list.appendChild(div);
+         }
+      };
+      addGroups(data.reused, 'same password used');
+      addGroups(data.similar, 'similar passwords used');
+   } catch (e) {
+      showToast('Failed to check passwords', 'error');
+   }
+}
+
+async function openBreachModal() {
+   const list = document.getElementById('auditList');
+   document.getElementById('auditTitle').textContent = 'Breached Passwords';
+   list.innerHTML = '<div class="browser-item">Checking...</div>';
+   document.getElementById('auditModal').classList.add('active');
+
+   try {
+      const res = await fetch(`${API_BASE}/api/audit/breached`);
+      const data = await res.json();
+
+      if (!data.success) {
+         list.innerHTML = '';
+         showToast(data.error, 'error');
+         return;
+      }
+      document.getElementById('auditTitle').textContent = `Breached Passwords (${data.checked} checked)`;
+      if (data.breached.length === 0) {
+         list.innerHTML = '<div class="browser-item">No password appears in the breach corpus</div>';
+         return;
+      }
+
+      list.innerHTML = '';
+      const names = new Map(currentEntries.map(e => [e.id, e.name]));
+      for (const hit of data.breached) {
+         const div = document.createElement('div');
+         div.className = 'browser-item';
+         div.innerHTML = `
+            <span class="browser-name">${escapeHtml(names.get(hit.id) ?? hit.id)}</span>
+            <span class="browser-meta">seen ${hit.count.toLocaleString()} times in breaches</span>`;
+         div.onclick = () => {
+            if (!names.has(hit.id)) return;
+            closeModal('auditModal');
+            viewEntry(hit.id);
+         };
+         list.appendChild(div);
+      }
+   } catch (e) {
+      showToast('Failed to check passwords', 'error');
+   }
+}
+
 function escapeHtml(text) {
    const div = document.createElement('div');
    div.textContent = text;